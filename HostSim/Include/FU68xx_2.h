@@ -0,0 +1,15 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : FU68xx_2.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : Keil器件包中的FU68xx_2.h在主机上不存在，统一指向FU68xx_4.h。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+#ifndef __FU68XX_2_H_
+#define __FU68XX_2_H_
+
+#include <FU68xx_4.h>
+
+#endif
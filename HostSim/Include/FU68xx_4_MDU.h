@@ -0,0 +1,190 @@
+/********************************************************************************
+
+ **** Copyright (C), 2019, Fortior Technology Co., Ltd.                      ****
+
+ ********************************************************************************
+ * File Name     : FU68xx_4_MDU.h
+ * Author        : Fortiortech  Appliction Team
+ * Date          : 2026-10-17
+ * Description   : 主机仿真用的MDU宏，宏名与参数同驱动库FU68xx_4_MDU.h，
+ *                 用C运算实现与硬件相同的结果。输入按16位寄存器截断，
+ *                 输出同读MDU_A/B/C一样为uint16，再按目标变量类型转换。
+ * Version       : 1.0
+ * Function List :
+ *
+ * Record        :
+ * 1.Date        : 2026-10-17
+ *   Author      : Fortiortech  Appliction Team
+ *   Modification: Created file
+
+********************************************************************************/
+
+#ifndef __FU68XX_4_MDU_H__
+#define __FU68XX_4_MDU_H__
+
+/**************************************************************************************************///Including Header Files
+#include <FU68xx_4_MCU.h>
+#include <math.h>
+
+/**************************************************************************************************///Define Function
+static inline uint32 HostMdu_MulS(uint16 wA, uint16 wB)
+{
+    return (uint32)((int32)(int16)wA * (int32)(int16)wB);
+}
+
+static inline uint32 HostMdu_Mul(uint16 wA, uint16 wB)
+{
+    return (uint32)wA * (uint32)wB;
+}
+
+static inline uint32 HostMdu_DivQ(uint16 wAh, uint16 wAl, uint16 wB)
+{
+    uint32 A = ((uint32)wAh << 16) | wAl;
+
+    return (wB == 0) ? 0xffffffff : (A / wB);
+}
+
+static inline uint16 HostMdu_DivR(uint16 wAh, uint16 wAl, uint16 wB)
+{
+    uint32 A = ((uint32)wAh << 16) | wAl;
+
+    return (wB == 0) ? 0xffff : (uint16)(A % wB);
+}
+
+/* Y(32位) += K * (X * 65536 - Y) / 256 */
+static inline uint32 HostMdu_Lpf(uint16 iX, uint8 ucK, uint16 iYh, uint16 iYl)
+{
+    int32 Y = (int32)(((uint32)iYh << 16) | iYl);
+    long long Err = ((long long)(int16)iX << 16) - Y;
+
+    return (uint32)(Y + (int32)((Err * ucK) >> 8));
+}
+
+static inline uint16 HostMdu_Us(uint16 iCos, uint16 iSin)
+{
+    double Us = sqrt((double)(int16)iCos * (int16)iCos + (double)(int16)iSin * (int16)iSin);
+
+    return (Us > 32767.0) ? 32767 : (uint16)Us;
+}
+
+/* 角度Q15：32768对应π */
+static inline uint16 HostMdu_Theta(uint16 iCos, uint16 iSin)
+{
+    double Theta = atan2((double)(int16)iSin, (double)(int16)iCos) * 32768.0 / 3.14159265358979;
+
+    return (uint16)(int16)((Theta >= 32767.0) ? 32767.0 : Theta);
+}
+
+static inline uint16 HostMdu_Cos(uint16 iCos0, uint16 iTheta, uint16 iSin0)
+{
+    double Theta = (int16)iTheta * 3.14159265358979 / 32768.0;
+
+    return (uint16)(int16)((int16)iCos0 * cos(Theta) - (int16)iSin0 * sin(Theta));
+}
+
+static inline uint16 HostMdu_Sin(uint16 iCos0, uint16 iTheta, uint16 iSin0)
+{
+    double Theta = (int16)iTheta * 3.14159265358979 / 32768.0;
+
+    return (uint16)(int16)((int16)iCos0 * sin(Theta) + (int16)iSin0 * cos(Theta));
+}
+
+/**************************************************************************************************///Define Macro
+/* 有符号乘法，结果左移一位   C = A * B * 2 */
+#define MuiltS1_MDU(iA, iB, iCh, iCl)                       do { \
+                                                                uint32 _C = HostMdu_MulS(iA, iB) << 1;\
+                                                                iCh = (uint16)(_C >> 16);\
+                                                                iCl = (uint16)_C;\
+                                                            } while (0)
+
+#define MuiltS1_H_MDU(iA, iB, iCh)                          do { iCh = (uint16)((HostMdu_MulS(iA, iB) << 1) >> 16); } while (0)
+#define MuiltS1_L_MDU(iA, iB, iCl)                          do { iCl = (uint16)(HostMdu_MulS(iA, iB) << 1); } while (0)
+
+/* 有符号乘法   C = A * B */
+#define MuiltS_MDU(iA, iB, iCh, iCl)                        do { \
+                                                                uint32 _C = HostMdu_MulS(iA, iB);\
+                                                                iCh = (uint16)(_C >> 16);\
+                                                                iCl = (uint16)_C;\
+                                                            } while (0)
+
+#define MuiltS_H_MDU(iA, iB, iCh)                           do { iCh = (uint16)(HostMdu_MulS(iA, iB) >> 16); } while (0)
+#define MuiltS_L_MDU(iA, iB, iCl)                           do { iCl = (uint16)HostMdu_MulS(iA, iB); } while (0)
+
+/* 无符号乘法   C = A * B */
+#define Muilt_MDU(wA, wB, wCh, wCl)                         do { \
+                                                                uint32 _C = HostMdu_Mul(wA, wB);\
+                                                                wCh = (uint16)(_C >> 16);\
+                                                                wCl = (uint16)_C;\
+                                                            } while (0)
+
+#define Muilt_H_MDU(wA, wB, wCh)                            do { wCh = (uint16)(HostMdu_Mul(wA, wB) >> 16); } while (0)
+#define Muilt_L_MDU(wA, wB, wCl)                            do { wCl = (uint16)HostMdu_Mul(wA, wB); } while (0)
+
+/* 低通滤波器   Y += K * (X - Y)，K为Q8 */
+#define LPF_MDU(iX, ucK, iYh, iYl)                          do { \
+                                                                uint32 _Y = HostMdu_Lpf(iX, ucK, iYh, iYl);\
+                                                                iYh = (uint16)(_Y >> 16);\
+                                                                iYl = (uint16)_Y;\
+                                                            } while (0)
+
+/* 32Bit/16Bit除法   C = A / B，C = A % B */
+#define DivQ_MDU(wAh, wAl, wB, wCh, wCl)                    do { \
+                                                                uint32 _C = HostMdu_DivQ(wAh, wAl, wB);\
+                                                                wCh = (uint16)(_C >> 16);\
+                                                                wCl = (uint16)_C;\
+                                                            } while (0)
+
+#define DivQ_H_MDU(wAh, wAl, wB, wCh)                       do { wCh = (uint16)(HostMdu_DivQ(wAh, wAl, wB) >> 16); } while (0)
+#define DivQ_L_MDU(wAh, wAl, wB, wCl)                       do { wCl = (uint16)HostMdu_DivQ(wAh, wAl, wB); } while (0)
+#define DivR_MDU(wAh, wAl, wB, wC)                          do { wC  = HostMdu_DivR(wAh, wAl, wB); } while (0)
+
+/* Sin/Cos计算与坐标转换 */
+#define SinCos_MDU(iCos0, iTheta, iSin0, iCos, iSin)        do { \
+                                                                uint16 _Cos = HostMdu_Cos(iCos0, iTheta, iSin0);\
+                                                                uint16 _Sin = HostMdu_Sin(iCos0, iTheta, iSin0);\
+                                                                iCos = _Cos;\
+                                                                iSin = _Sin;\
+                                                            } while (0)
+
+/* 角度和幅值计算   Us = Sqrt(Sin^2 + Cos^2)，Theta = Atan(Sin / Cos) */
+#define Atan_MDU(iCos, iSin, iUs, iTheta)                   do { \
+                                                                uint16 _Us    = HostMdu_Us(iCos, iSin);\
+                                                                uint16 _Theta = HostMdu_Theta(iCos, iSin);\
+                                                                iUs    = _Us;\
+                                                                iTheta = _Theta;\
+                                                            } while (0)
+
+#define Atan_Theta_MDU(iCos, iSin, iTheta)                  do { iTheta = HostMdu_Theta(iCos, iSin); } while (0)
+#define Atan_Us_MDU(iCos, iSin, iUs)                        do { iUs = HostMdu_Us(iCos, iSin); } while (0)
+
+/* 幅值低通滤波器   Y += K * (Sqrt(Sin^2 + Cos^2) - Y) */
+#define Atan_LPF_MDU(iCos, iSin, ucK, iYh, iYl)             do { \
+                                                                uint32 _Y = HostMdu_Lpf(HostMdu_Us(iCos, iSin), ucK, iYh, iYl);\
+                                                                iYh = (uint16)(_Y >> 16);\
+                                                                iYl = (uint16)_Y;\
+                                                            } while (0)
+
+/* 乘除法器   D = A * B / C，D = A * B % C */
+#define Muilt_DivQ_MDU(wA, wB, wC, wDh, wDl)                do { \
+                                                                uint32 _AB = HostMdu_Mul(wA, wB);\
+                                                                uint32 _D  = HostMdu_DivQ((uint16)(_AB >> 16), (uint16)_AB, wC);\
+                                                                wDh = (uint16)(_D >> 16);\
+                                                                wDl = (uint16)_D;\
+                                                            } while (0)
+
+#define Muilt_DivQ_H_MDU(wA, wB, wC, wDh)                   do { \
+                                                                uint32 _AB = HostMdu_Mul(wA, wB);\
+                                                                wDh = (uint16)(HostMdu_DivQ((uint16)(_AB >> 16), (uint16)_AB, wC) >> 16);\
+                                                            } while (0)
+
+#define Muilt_DivQ_L_MDU(wA, wB, wC, wDl)                   do { \
+                                                                uint32 _AB = HostMdu_Mul(wA, wB);\
+                                                                wDl = (uint16)HostMdu_DivQ((uint16)(_AB >> 16), (uint16)_AB, wC);\
+                                                            } while (0)
+
+#define Muilt_DivR_MDU(wA, wB, wC, wD)                      do { \
+                                                                uint32 _AB = HostMdu_Mul(wA, wB);\
+                                                                wD = HostMdu_DivR((uint16)(_AB >> 16), (uint16)_AB, wC);\
+                                                            } while (0)
+
+#endif
@@ -0,0 +1,33 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : FU68xx_4_Type.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 主机仿真用的数据类型定义，与驱动库同名头文件一致，
+/*                   仅将32位类型改为int，保证在64位Linux上仍为32位。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __FU68XX_4__TYPE_H_
+#define __FU68XX_4__TYPE_H_
+
+#define _I                              volatile const
+#define _O                              volatile
+#define _IO                             volatile
+
+#define bool                            bit
+#define false                           (0)
+#define true                            (1)
+
+typedef unsigned char                   uint8;
+typedef unsigned short                  uint16;
+typedef unsigned int                    uint32;
+
+typedef int                             int32;
+typedef short                           int16;
+typedef signed char                     int8;
+
+typedef enum{DISABLE = 0, ENABLE}       ebool;
+
+#endif
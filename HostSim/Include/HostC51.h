@@ -0,0 +1,26 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : HostC51.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 主机仿真编译时强制包含(-include)，把Keil C51的存储类型关键字映射为空，
+/*                   使User/下的源文件不做修改即可用gcc编译。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __HOSTC51_H_
+#define __HOSTC51_H_
+
+/* 存储区关键字：主机上所有变量都在同一地址空间 */
+#define xdata
+#define idata
+#define pdata
+#define data
+#define code
+#define reentrant
+
+/* 位变量按字节处理，sfr/sbit由HostSim生成的FU68xx_4_MCU.h替换 */
+#define bit                             unsigned char
+
+#endif
@@ -0,0 +1,51 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : HostMcu.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 主机仿真的寄存器后端。生成的FU68xx_4_MCU.h把sfr/sfr16/sbit/xdata寄存器
+/*                   全部展开为HostSfr/HostXdata/HostSbit的返回值，外设行为通过钩子函数实现。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __HOSTMCU_H_
+#define __HOSTMCU_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef void (*HostHook)(uint16 Addr);
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern uint8 HostSfrMem[256];                               // SFR空间
+extern uint8 HostXdataMem[65536];                           // XDATA空间(含0x4000以上的外设寄存器)
+extern uint8 HostCodeMem[16384];                            // 16K Flash
+extern uint8 *HostDmaXram;                                  // DMA读取的XDATA变量在主机上的地址，由仿真入口设置
+
+/* Exported functions ---------------------------------------------------------------------------*/
+/* 寄存器访问，每次访问前先提交上一次未完成的位操作/UART发送/PI计算 */
+extern volatile uint8 *HostSfr(uint8 Addr);
+extern volatile uint8 *HostXdata(uint16 Addr);
+extern volatile uint8 *HostSbit(volatile uint8 *Reg, uint8 Bit);
+extern uint8 *HostCode(uint16 Addr);
+extern void HostSync(void);
+extern void HostNop(void);
+extern uint16 HostCrc16(uint16 Crc, uint8 Value);
+
+/* 外设钩子，在对应地址被访问时(返回指针之前)调用 */
+extern void HostSetSfrHook(uint8 Addr, HostHook Hook);
+extern void HostSetXdataHook(uint16 Addr, HostHook Hook);
+
+/* 寄存器与外设模型复位 */
+extern void HostMcu_Reset(void);
+
+/* 模拟出厂校准，把零位角写入参数记录区的校准块(HostFlash.c) */
+extern void HostFlash_Calibrate(int16 AngleFlt);
+
+/* UART2 线路侧：向固件注入接收字节，读取固件发出的字节 */
+extern void   HostUart_Write(const uint8 *Buf, uint16 Len);
+extern uint16 HostUart_Read(uint8 *Buf, uint16 Max);
+extern void   HostUart_Service(void);
+
+#endif
@@ -0,0 +1,70 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : HostMotor.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 主机仿真的被控对象：FOC硬件电流环 + PMSM电机 + 负载 + 增量编码器(QEP/Z)
+/*                   + PWM绝对值编码器，每个载波周期在DRV_ISR之前推进一次。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __HOSTMOTOR_H_
+#define __HOSTMOTOR_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    /* 电机与负载参数(SI单位) */
+    double  Rs;                                             // 相电阻(Ω)
+    double  Ls;                                             // 相电感(H)，Ld = Lq
+    double  Flux;                                           // 永磁磁链(Wb)，相电压峰值 = Flux * ωe
+    double  J;                                              // 转动惯量(kg·m²)
+    double  B;                                              // 粘滞摩擦(N·m·s/rad)
+    double  Tf;                                             // 库仑摩擦(N·m)
+    double  Tcog;                                           // 齿槽转矩幅值(N·m)
+    uint8   CogN;                                           // 每机械圈齿槽转矩周期数
+    double  Tload;                                          // 恒定负载转矩(N·m)，正值阻碍正转
+    double  Vbus;                                           // 母线电压(V)
+
+    /* 编码器参数 */
+    int8    EncDir;                                         // 正转时TIM2计数方向，1或-1
+    double  ZAngle;                                         // Z脉冲所在的机械角度(rad)
+    double  AbsOffset;                                      // PWM编码器零点相对转子零位的机械角度(rad)
+    double  EncEcc1;                                        // 码盘偏心引起的1倍机械频率计数误差幅值
+    double  EncEcc2;                                        // 码盘倾斜/磁铁不均引起的2倍机械频率计数误差幅值
+    uint8   AbsPoles;                                       // PWM编码器每机械圈输出的角度周期数
+    uint16  AbsPeriod;                                      // PWM编码器一帧的TIM3计数值
+    uint8   NormalMode;                                     // GP42电平：1正常运行，0零位自学习
+
+    /* 仿真状态 */
+    double  Theta;                                          // 机械角度(rad)，不回绕
+    double  Omega;                                          // 机械角速度(rad/s)
+    double  Id;                                             // 转子dq坐标系电流(A)
+    double  Iq;
+    double  Te;                                             // 电磁转矩(N·m)
+    double  UdInt;                                          // FOC硬件D轴PI积分项(Q15)
+    double  UqInt;                                          // FOC硬件Q轴PI积分项(Q15)
+    int32   EncCnt;                                         // 编码器绝对计数(EncDir方向)
+    unsigned long long EncEdgeClock;                        // 最近一次计数变化时的CPU时钟
+    unsigned long long AbsNext;                             // PWM编码器下一帧结束时的CPU时钟
+    int16   IaMax;                                          // 相电流峰值(Q15)，ICLR清零
+    int16   IbMax;
+    int16   IcMax;
+    uint32  ZCnt;                                           // 已产生的Z脉冲次数
+    double  Loss;                                           // 累计绕组铜耗(J)
+    uint32  DriveCnt;                                       // 三相输出使能的载波周期数
+} HostMotorTypeDef;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern HostMotorTypeDef HostMotor;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void   HostMotor_Init(void);
+extern void   HostMotor_Step(void);
+extern int32  HostMotor_Counts(void);
+extern double HostMotor_Rpm(void);
+
+#endif
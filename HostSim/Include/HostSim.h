@@ -0,0 +1,55 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : HostSim.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 主机仿真调度：按CPU时钟推进，在PWM_FREQUENCY调用DRV_ISR，
+/*                   在SYST_ARR周期调用SYStick_INT，其余时间执行主循环。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __HOSTSIM_H_
+#define __HOSTSIM_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef void (*HostSimHook)(void);
+
+typedef struct
+{
+    unsigned long long  Clock;                              // 当前CPU时钟计数
+    unsigned long long  DrvNext;                            // 下一次载波中断的时钟
+    unsigned long long  SystNext;                           // 下一次SysTick中断的时钟
+    uint32              DrvPeriod;                          // 载波周期(CPU时钟数)
+    uint32              SystPeriod;                         // SysTick周期(CPU时钟数)
+    uint32              DrvCnt;                             // DRV_ISR执行次数
+    uint32              SystCnt;                            // SYStick_INT执行次数
+    uint32              LoopCnt;                            // 主循环执行次数
+    uint8               LoopDiv;                            // 每几个载波周期执行一次主循环
+    HostSimHook         PwmHook;                            // 每个载波周期在DRV_ISR之前调用(电机模型)
+    HostSimHook         SystHook;                           // 每个SysTick周期在SYStick_INT之前调用
+} HostSimTypeDef;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern HostSimTypeDef HostSim;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+/* 固件入口(User/source) */
+extern void SystemInit(void);
+extern void BackgroundLoop(void);
+extern void EXTI_INT(void);
+extern void DRV_ISR(void);
+extern void SYStick_INT(void);
+extern void USART2_INT(void);
+extern void DMA_INT(void);
+extern void TIM2_INT(void);
+extern void TIM3_INT(void);
+
+extern void HostSim_Init(void);
+extern void HostSim_Run(unsigned long long Clocks);
+extern void HostSim_RunMs(uint32 Ms);
+extern void HostSim_ServiceIrq(void);
+
+#endif
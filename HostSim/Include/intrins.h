@@ -0,0 +1,22 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : intrins.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : Keil intrins.h的主机替代，_nop_()用于推进PI等需要等待的硬件模块。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __INTRINS_H_
+#define __INTRINS_H_
+
+extern void HostNop(void);
+
+#define _nop_()                         HostNop()
+#define _crol_(c, b)                    ((unsigned char)(((c) << ((b) & 7)) | ((c) >> ((8 - (b)) & 7))))
+#define _cror_(c, b)                    ((unsigned char)(((c) >> ((b) & 7)) | ((c) << ((8 - (b)) & 7))))
+#define _irol_(i, b)                    ((unsigned short)(((i) << ((b) & 15)) | ((i) >> ((16 - (b)) & 15))))
+#define _iror_(i, b)                    ((unsigned short)(((i) >> ((b) & 15)) | ((i) << ((16 - (b)) & 15))))
+
+#endif
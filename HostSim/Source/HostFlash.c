@@ -0,0 +1,100 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : HostFlash.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 主机仿真时替代User/source/Hardware/FLASH.c，在HostCodeMem上模拟Flash自擦除/自烧写。
+                     扇区128Byte，擦除后为0x00，烧写只能把0写成1，最后一个扇区0x3f80~0x3fff禁止操作。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+/******************************************************************************///Including Header Files
+#include <stdint.h>
+#include "Myproject.h"
+
+/******************************************************************************///Define Macro
+#define HOST_FLASH_SECTOR               0x80
+#define HOST_FLASH_LOCKED               0x3f80
+
+/******************************************************************************///Define Global Symbols
+ROM_TypeDef xdata  Rom;
+
+uint32 HostFlash_EraseCnt;                                  // 擦除次数统计
+uint32 HostFlash_WriteCnt;                                  // 烧写字节统计
+
+/******************************************************************************///Function Subject
+/* 固件把Flash地址当作xdata指针传入，这里还原为16位地址 */
+static uint16 Flash_Addr(uint8 xdata *FlashAddress)
+{
+    return (uint16)(uintptr_t)FlashAddress;
+}
+
+static uint8 Flash_Erase(uint16 Addr)
+{
+    if (Addr >= HOST_FLASH_LOCKED)
+    {
+        return 0;
+    }
+
+    memset(&HostCodeMem[Addr & ~(HOST_FLASH_SECTOR - 1)], 0x00, HOST_FLASH_SECTOR);
+    HostFlash_EraseCnt++;
+    return 1;
+}
+
+uint8 Flash_Sector_Erase(uint8 xdata *FlashAddress)
+{
+    Flash_Erase(Flash_Addr(FlashAddress));
+    return 0;
+}
+
+uint8 Flash_Sector_Write(uint8 xdata *FlashAddress, uint8 FlashData)
+{
+    uint16 Addr = Flash_Addr(FlashAddress);
+
+    if (Addr < HOST_FLASH_LOCKED)
+    {
+        HostCodeMem[Addr] |= FlashData;
+        HostFlash_WriteCnt++;
+    }
+
+    return 0;
+}
+
+/* 与FLASH.c一致，返回1表示擦除成功 */
+uint8 Flash_ErasePageRom(uint8 xdata *FlashAddress)
+{
+    Flash_Erase(Flash_Addr(FlashAddress));
+    return 1;
+}
+
+void Write_Bytes_To_Flash(uint16 FlashAddress, uint8 *Buff, uint8 length)
+{
+    uint16 i;
+
+    for (i = 0; i < length; i++)
+    {
+        Flash_Sector_Write((uint8 xdata *)(uintptr_t)(FlashAddress + i), Buff[i]);
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostFlash_Calibrate
+    Description    : 模拟出厂校准：用固件自己的参数记录区和校准块代码写入零位角并烧写完成，
+                     之后上电Calib_Load读到有效校准块，不再预定位重新学习。在HostSim_Init之前调用。
+    Date           : 2026-10-17
+    Parameter      : AngleFlt: [输入] 零位角，与HostMotor.AbsOffset对应
+    ------------------------------------------------------------------------------------------------- */
+void HostFlash_Calibrate(int16 AngleFlt)
+{
+    HostMcu_Reset();                                        // Param_Crc使用CRC单元模型
+    Param_Init();
+    Calib_Load();
+    Calib.Blk.AngleFlt  = AngleFlt;
+    Calib.Blk.Flags    |= CALIB_F_ANGLE;
+    Calib_Save();
+
+    while (Param.Dirty || (Param.State != PARAM_IDLE))
+    {
+        Param_Task();
+    }
+}
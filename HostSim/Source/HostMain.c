@@ -0,0 +1,405 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : HostMain.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 主机仿真程序入口。用法:
+                       HostSim [-t 仿真时间ms] [-c 时刻ms:VISCA帧]... [-s 时刻ms:目标计数]... [-b 到位窗口] [-o 波形.csv] [-u] [-e 1倍,2倍]
+                               [-g 齿槽转矩,库仑摩擦] [-l 负载转矩] [-p 电阻,电感,惯量[,磁链]]
+                     默认先写入与电机模型一致的校准块，-u为未校准上电(预定位重新学习零位角)，
+                     -e给编码器加上1倍、2倍机械频率的计数误差(幅值，计数)，-g改变齿槽转矩幅值和库仑摩擦(N·m)，
+                     -l加恒定负载转矩(N·m，模拟相机偏心的重力矩)，-p换用其他电机参数(Ω,H,kg·m²,Wb)。
+                     上电初始化后带电机模型运行固件，按时刻注入VISCA指令(十六进制，可含空格)
+                     或二进制连续给定帧(相对零位的目标计数，序号和CRC自动生成)，
+                     对最后一条指令统计目标生效延时、到位时间、超调和跟随误差，统计最后1s的平均铜耗和输出使能比例，
+                     打印中断执行次数和仿真速度。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <ctype.h>
+#include <time.h>
+#include <MyProject.h>
+#include <HostSim.h>
+#include <HostMotor.h>
+
+/******************************************************************************///Define Macro
+#define HOST_CMD_MAX                    16
+#define HOST_FRAME_MAX                  20
+
+/******************************************************************************///Define Type
+typedef struct
+{
+    uint32 Ms;                                              // 注入时刻
+    uint8  Len;
+    uint8  Buf[HOST_FRAME_MAX];
+} HostCmd;
+
+typedef struct
+{
+    uint32 StartMs;                                         // 最后一条指令的注入时刻，0表示尚未开始
+    int32  StartPos;                                        // 注入时的位置
+    int32  StartTarget;                                     // 注入时的目标
+    uint32 LatencyMs;                                       // 注入到目标改变的时间，0xFFFFFFFF表示未改变
+    int32  Target;                                          // 固件给出的目标 mcSP.TargetPulsesNum
+    int32  Band;                                            // 到位窗口(计数)
+    int32  FollowMax;                                       // 最大|位置给定mcSP.PulsesNum-位置|
+    int32  Overshoot;                                       // 越过目标的最大计数
+    uint32 LastOutMs;                                       // 最后一次在窗口外的时刻
+} HostMove;
+
+typedef struct
+{
+    uint32 StartMs;                                         // 统计起点
+    uint8  Started;
+    double Loss;                                            // 起点时的HostMotor.Loss
+    uint32 DriveCnt;                                        // 起点时的HostMotor.DriveCnt
+    uint32 DrvCnt;                                          // 起点时的HostSim.DrvCnt
+} HostPower;
+
+/******************************************************************************///Define Global Symbols
+static HostCmd  Cmd[HOST_CMD_MAX];
+static uint8    CmdNum;
+static uint8    CmdNext;
+static HostMove Move;
+static HostPower Meter;
+static uint8    StreamSeq;
+static FILE    *Trace;
+
+/******************************************************************************///Function Subject
+static double Wall_Time(void)
+{
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static uint32 Sim_Ms(void)
+{
+    return (uint32)(HostSim.Clock / (MCU_CLOCK * 1000));
+}
+
+/* "ms:81 01 06 ..." 解析为指令，十六进制字符两两成字节，其余字符忽略 */
+static int Cmd_Parse(const char *Arg)
+{
+    HostCmd *C = &Cmd[CmdNum];
+    const char *Hex = strchr(Arg, ':');
+    int Nibble = -1;
+
+    if ((Hex == 0) || (CmdNum >= HOST_CMD_MAX))
+    {
+        return 0;
+    }
+
+    C->Ms  = (uint32)atol(Arg);
+    C->Len = 0;
+
+    for (Hex++; *Hex && (C->Len < HOST_FRAME_MAX); Hex++)
+    {
+        int Digit;
+
+        if (!isxdigit((unsigned char)*Hex))
+        {
+            continue;
+        }
+
+        Digit = isdigit((unsigned char)*Hex) ? (*Hex - '0') : (tolower((unsigned char)*Hex) - 'a' + 10);
+
+        if (Nibble < 0)
+        {
+            Nibble = Digit;
+        }
+        else
+        {
+            C->Buf[C->Len++] = (uint8)((Nibble << 4) | Digit);
+            Nibble = -1;
+        }
+    }
+
+    CmdNum++;
+    return C->Len > 0;
+}
+
+/* "ms:counts" 生成二进制连续给定帧 A5 Seq P3 P2 P1 P0 CH CL，序号每帧加1 */
+static int Stream_Parse(const char *Arg)
+{
+    HostCmd *C = &Cmd[CmdNum];
+    const char *Pos = strchr(Arg, ':');
+    int32 Target;
+    uint16 Crc = 0xffff;
+    uint8 i;
+
+    if ((Pos == 0) || (CmdNum >= HOST_CMD_MAX))
+    {
+        return 0;
+    }
+
+    Target    = (int32)atol(Pos + 1);
+    C->Ms     = (uint32)atol(Arg);
+    C->Len    = UART_STREAM_LEN;
+    C->Buf[0] = UART_STREAM_HEAD;
+    C->Buf[1] = ++StreamSeq;
+    C->Buf[2] = (uint8)(Target >> 24);
+    C->Buf[3] = (uint8)(Target >> 16);
+    C->Buf[4] = (uint8)(Target >> 8);
+    C->Buf[5] = (uint8)Target;
+
+    for (i = 0; i < UART_STREAM_LEN - 2; i++)
+    {
+        Crc = HostCrc16(Crc, C->Buf[i]);
+    }
+
+    C->Buf[6] = (uint8)(Crc >> 8);
+    C->Buf[7] = (uint8)Crc;
+
+    CmdNum++;
+    return 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sim_Tick
+    Description    : 每个SysTick周期调用：到时刻注入指令、打印固件应答、统计最后一条指令的运动、记录波形
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+static void Sim_Tick(void)
+{
+    uint32 Ms = Sim_Ms();
+    uint8  Reply[64];
+    uint16 Len;
+    int32  Pos = mcQEP.CntrSumReal;
+    int32  Err;
+
+    if (!Meter.Started && (Ms >= Meter.StartMs))
+    {
+        Meter.Started  = 1;
+        Meter.Loss     = HostMotor.Loss;
+        Meter.DriveCnt = HostMotor.DriveCnt;
+        Meter.DrvCnt   = HostSim.DrvCnt;
+    }
+
+    while ((CmdNext < CmdNum) && (Cmd[CmdNext].Ms <= Ms))
+    {
+        HostUart_Write(Cmd[CmdNext].Buf, Cmd[CmdNext].Len);
+        Move.StartMs     = Ms;
+        Move.StartPos    = Pos;
+        Move.StartTarget = mcSP.TargetPulsesNum;
+        Move.LatencyMs   = 0xFFFFFFFF;
+        Move.Target      = mcSP.TargetPulsesNum;
+        Move.FollowMax   = 0;
+        Move.Overshoot   = 0;
+        Move.LastOutMs   = Ms;
+        CmdNext++;
+    }
+
+    Len = HostUart_Read(Reply, sizeof(Reply));
+
+    if (Len)
+    {
+        uint16 i;
+
+        printf("%6lu ms  <-", (unsigned long)Ms);
+
+        for (i = 0; i < Len; i++)
+        {
+            printf(" %02X", Reply[i]);
+        }
+
+        printf("\n");
+    }
+
+    if (Move.StartMs)
+    {
+        int32 Dir;
+
+        Move.Target = mcSP.TargetPulsesNum;
+        Err         = mcSP.PulsesNum - Pos;
+
+        if ((Move.LatencyMs == 0xFFFFFFFF) && (Move.Target != Move.StartTarget))
+        {
+            Move.LatencyMs = Ms - Move.StartMs;
+        }
+        Dir         = (Move.Target >= Move.StartPos) ? 1 : -1;
+
+        if (ABS(Err) > Move.FollowMax)
+        {
+            Move.FollowMax = ABS(Err);
+        }
+
+        Err         = Move.Target - Pos;
+
+        if (-Err * Dir > Move.Overshoot)
+        {
+            Move.Overshoot = -Err * Dir;
+        }
+
+        if (ABS(Err) > Move.Band)
+        {
+            Move.LastOutMs = Ms;
+        }
+    }
+
+    if (Trace)
+    {
+        fprintf(Trace, "%lu,%d,%ld,%ld,%ld,%d,%d,%.2f,%.4f\n", (unsigned long)Ms, (int)mcState, (long)mcSP.TargetPulsesNum,
+                (long)mcSP.PulsesNum, (long)Pos, (int)mcQEP.SpeedMFlt, (int)mcFocCtrl.mcIqref, HostMotor_Rpm(), HostMotor.Iq);
+    }
+}
+
+static void Move_Report(void)
+{
+    if (!Move.StartMs)
+    {
+        return;
+    }
+
+    printf("move       : %ld -> %ld counts (%+ld)\n", (long)Move.StartPos, (long)Move.Target,
+           (long)(Move.Target - Move.StartPos));
+    if (Move.LatencyMs != 0xFFFFFFFF)
+    {
+        printf("latency    : %lu ms (command to new target)\n", (unsigned long)Move.LatencyMs);
+    }
+
+    printf("final pos  : %ld (err %ld)\n", (long)mcQEP.CntrSumReal, (long)(Move.Target - mcQEP.CntrSumReal));
+    printf("follow err : %ld counts max\n", (long)Move.FollowMax);
+    printf("overshoot  : %ld counts\n", (long)Move.Overshoot);
+
+    if (ABS(Move.Target - mcQEP.CntrSumReal) <= Move.Band)
+    {
+        printf("settle     : %lu ms (|err| <= %ld)\n", (unsigned long)(Move.LastOutMs - Move.StartMs), (long)Move.Band);
+    }
+    else
+    {
+        printf("settle     : not settled within %ld counts\n", (long)Move.Band);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32 SimMs = 1000;
+    uint8  Calibrated = 1;
+    double Ecc1 = 0;
+    double Ecc2 = 0;
+    double Tcog = -1;
+    double Tf   = -1;
+    double Rs   = -1;
+    double Ls   = -1;
+    double J    = -1;
+    double Flux = -1;
+    double Tload = 0;
+    double Start;
+    double Cost;
+    int i;
+
+    Move.Band = 80;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc))
+        {
+            SimMs = (uint32)atol(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-c") == 0) && (i + 1 < argc) && Cmd_Parse(argv[i + 1]))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc) && Stream_Parse(argv[i + 1]))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+        {
+            Move.Band = atol(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-u") == 0)
+        {
+            Calibrated = 0;
+        }
+        else if ((strcmp(argv[i], "-e") == 0) && (i + 1 < argc) && (sscanf(argv[i + 1], "%lf,%lf", &Ecc1, &Ecc2) == 2))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-g") == 0) && (i + 1 < argc) && (sscanf(argv[i + 1], "%lf,%lf", &Tcog, &Tf) == 2))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-p") == 0) && (i + 1 < argc) && (sscanf(argv[i + 1], "%lf,%lf,%lf,%lf", &Rs, &Ls, &J, &Flux) >= 3))
+        {
+            i++;
+        }
+        else if ((strcmp(argv[i], "-l") == 0) && (i + 1 < argc))
+        {
+            Tload = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc) && ((Trace = fopen(argv[i + 1], "w")) != 0))
+        {
+            fprintf(Trace, "ms,state,target,setpoint,pos,speed,iqref,rpm,iq\n");
+            i++;
+        }
+        else
+        {
+            printf("usage: %s [-t ms] [-c ms:hex]... [-s ms:counts]... [-b counts] [-o trace.csv] [-u] [-e ecc1,ecc2] [-g tcog,tf] [-l tload] [-p rs,ls,j[,flux]]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    HostMotor_Init();
+    HostMotor.EncEcc1 = Ecc1;
+    HostMotor.EncEcc2 = Ecc2;
+    HostMotor.Tload   = Tload;
+
+    if (Tcog >= 0)
+    {
+        HostMotor.Tcog = Tcog;
+        HostMotor.Tf   = Tf;
+    }
+
+    if (Rs > 0)
+    {
+        HostMotor.Rs = Rs;
+        HostMotor.Ls = Ls;
+        HostMotor.J  = J;
+    }
+
+    if (Flux > 0)
+    {
+        HostMotor.Flux = Flux;
+    }
+
+    if (Calibrated)
+    {
+        HostFlash_Calibrate(0);                             // HostMotor.AbsOffset为0时零位角为0
+    }
+
+    Meter.StartMs    = (SimMs > 1000) ? SimMs - 1000 : 0;
+    HostSim.SystHook = Sim_Tick;
+    HostSim_Init();
+
+    Start = Wall_Time();
+    HostSim_RunMs(SimMs);
+    Cost  = Wall_Time() - Start;
+
+    if (Trace)
+    {
+        fclose(Trace);
+    }
+
+    printf("sim time   : %lu ms\n", (unsigned long)SimMs);
+    printf("DRV_ISR    : %lu\n", (unsigned long)HostSim.DrvCnt);
+    printf("SYStick_INT: %lu\n", (unsigned long)HostSim.SystCnt);
+    printf("main loop  : %lu\n", (unsigned long)HostSim.LoopCnt);
+    printf("state      : %d\n", (int)mcState);
+    Move_Report();
+
+    if (Meter.Started && (HostSim.DrvCnt > Meter.DrvCnt))
+    {
+        printf("power      : %.1f mW copper loss, outputs on %.0f%% (last %lu ms)\n",
+               (HostMotor.Loss - Meter.Loss) * 1000.0 * SAMP_FREQ / (HostSim.DrvCnt - Meter.DrvCnt),
+               100.0 * (HostMotor.DriveCnt - Meter.DriveCnt) / (HostSim.DrvCnt - Meter.DrvCnt),
+               (unsigned long)(SimMs - Meter.StartMs));
+    }
+
+    if (Cost > 0)
+    {
+        printf("speed      : %.0f DRV ticks/s (%.1fx real time)\n", HostSim.DrvCnt / Cost, SimMs / 1000.0 / Cost);
+    }
+
+    return 0;
+}
@@ -0,0 +1,497 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : HostMcu.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 主机仿真的寄存器存储与外设行为模型：sbit位访问、ADC/DMA忙标志、
+                     PI硬件模块、UART2收发(接收按UT2_BAUD的字节时间送入)、CRC单元(逐字节输入)。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+#include <HostSim.h>
+
+/******************************************************************************///Define Macro
+#define HOST_BIT_CELLS                  4                   // 同一表达式中可同时出现的sbit数
+#define HOST_UART_FIFO                  256
+
+#define HOST_PI0_BASE                   0x02e0
+#define HOST_PI1_BASE                   0x02d0
+#define HOST_PI2_BASE                   0x02bc
+#define HOST_PI3_BASE                   0x02a8
+
+/******************************************************************************///Define Type
+typedef struct
+{
+    volatile uint8 *Reg;                                    // 所属寄存器，0表示空闲
+    uint8 Bit;
+    uint8 Sample;                                           // 取出时的位值
+    uint8 Value;                                            // 固件读写的位值
+} HostBitCell;
+
+typedef struct
+{
+    uint8  Buf[HOST_UART_FIFO];
+    uint16 Head;
+    uint16 Tail;
+} HostFifo;
+
+/******************************************************************************///Define Global Symbols
+uint8 HostSfrMem[256];
+uint8 HostXdataMem[65536];
+uint8 HostCodeMem[16384];
+
+static HostHook     SfrHook[256];
+static HostHook     XdataHook[65536];
+static HostBitCell  BitCell[HOST_BIT_CELLS];
+static uint8        BitCellNext;
+
+uint8              *HostDmaXram;                            // DMA读取的XDATA变量在主机上的地址
+
+static uint8        DmaPending;                             // DMA0/DMA1控制寄存器被访问，bit0/bit1
+static uint8        UartTxPending;                          // UT2_DR被写，等待下一次访问时发出
+static uint8        UartRxUnread;                           // UT2_DR中有尚未被读走的接收字节
+static unsigned long long UartRxNext;                  // 下一个接收字节收完的CPU时钟
+static HostFifo     UartTx;
+static HostFifo     UartRx;
+static uint8        CrcPending;                             // CRC_CR/CRC_DIN被访问，bit0/bit1
+static uint16       CrcValue;
+
+/******************************************************************************///Function Subject
+static void Fifo_Put(HostFifo *Fifo, uint8 Value)
+{
+    uint16 Next = (Fifo->Head + 1) % HOST_UART_FIFO;
+
+    if (Next != Fifo->Tail)
+    {
+        Fifo->Buf[Fifo->Head] = Value;
+        Fifo->Head            = Next;
+    }
+}
+
+static uint8 Fifo_Get(HostFifo *Fifo, uint8 *Value)
+{
+    if (Fifo->Head == Fifo->Tail)
+    {
+        return 0;
+    }
+
+    *Value     = Fifo->Buf[Fifo->Tail];
+    Fifo->Tail = (Fifo->Tail + 1) % HOST_UART_FIFO;
+    return 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostPi_Run
+    Description    : PI硬件模块的行为模型，增量式:
+                     UK += KP*(EK-EK1) + KI*EK + KD*(EK-2*EK1+EK2)
+                     KP为Q12，KI/KD为Q15，UK高16位为输出并限幅于UKMIN~UKMAX
+    Date           : 2026-10-17
+    Parameter      : Base: [输入] PIx_KP的地址; HasKd: [输入] 是否带微分项(PI2/PI3)
+    ------------------------------------------------------------------------------------------------- */
+static void HostPi_Run(uint16 Base, uint8 HasKd)
+{
+    int16 *Reg = (int16 *)&HostXdataMem[Base];
+    int32 Ek   = Reg[5];
+    int32 Ek1  = Reg[4];
+    int32 Ek2  = HasKd ? Reg[9] : 0;
+    long long Uk;
+
+    Uk  = ((long long)Reg[6] << 16) | (uint16)Reg[7];
+    Uk += (long long)(uint16)Reg[0] * (Ek - Ek1) * 16;
+    Uk += (long long)(uint16)Reg[1] * Ek * 2;
+
+    if (HasKd)
+    {
+        Uk += (long long)(uint16)Reg[8] * (Ek - 2 * Ek1 + Ek2) * 2;
+        Reg[9] = (int16)Ek1;
+    }
+
+    if (Uk > ((long long)Reg[2] << 16))
+    {
+        Uk = (long long)Reg[2] << 16;
+    }
+    else if (Uk < ((long long)Reg[3] << 16))
+    {
+        Uk = (long long)Reg[3] << 16;
+    }
+
+    Reg[6] = (int16)(Uk >> 16);
+    Reg[7] = (int16)(Uk & 0xffff);
+    Reg[4] = (int16)Ek;
+}
+
+static void HostPi_Service(void)
+{
+    uint8 Sta = HostSfrMem[0xf9] & (PI3STA | PI2STA | PI1STA | PI0STA);
+
+    if (Sta == 0)
+    {
+        return;
+    }
+
+    HostSfrMem[0xf9] &= ~(PI3STA | PI2STA | PI1STA | PI0STA | PIBSY);
+
+    if (Sta & PI0STA)
+    {
+        HostPi_Run(HOST_PI0_BASE, 0);
+    }
+
+    if (Sta & PI1STA)
+    {
+        HostPi_Run(HOST_PI1_BASE, 0);
+    }
+
+    if (Sta & PI2STA)
+    {
+        HostPi_Run(HOST_PI2_BASE, 1);
+    }
+
+    if (Sta & PI3STA)
+    {
+        HostPi_Run(HOST_PI3_BASE, 1);
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostCrc16
+    Description    : CRC16-CCITT-FALSE(多项式0x1021，高位先行，无反转)逐字节累加，仿真器构造帧时也使用
+    Date           : 2026-10-17
+    Parameter      : Crc: [输入] 当前值，首字节前为0xFFFF; Value: [输入] 输入字节
+    ------------------------------------------------------------------------------------------------- */
+uint16 HostCrc16(uint16 Crc, uint8 Value)
+{
+    uint8 i;
+
+    Crc ^= (uint16)Value << 8;
+
+    for (i = 0; i < 8; i++)
+    {
+        Crc = (Crc & 0x8000) ? (uint16)((Crc << 1) ^ 0x1021) : (uint16)(Crc << 1);
+    }
+
+    return Crc;
+}
+
+/* CRCDINI写1按CRCVAL装入初值并自动清零，写CRC_DIN把该字节累加进结果 */
+static void HostCrc_Service(void)
+{
+    uint8 *Cr = &HostXdataMem[0x4022];
+
+    if (CrcPending & 0x01)
+    {
+        if (*Cr & CRCDINI)
+        {
+            CrcValue = (*Cr & CRCVAL) ? 0xffff : 0x0000;
+            *Cr     &= ~CRCDINI;
+        }
+    }
+
+    if (CrcPending & 0x02)
+    {
+        CrcValue = HostCrc16(CrcValue, HostXdataMem[0x4021]);
+    }
+
+    CrcPending = 0;
+}
+
+/*  DMAx_BA只保留XDATA地址的低11位，主机上按HostDmaXram所在的2K窗口换算回主机地址。
+    XDATA->UART2的传输立即把整帧放入发送队列，置DMAIF，不经过UT2_DR和TI */
+static void HostDma_Service(void)
+{
+    uint8 Ch;
+
+    for (Ch = 0; Ch < 2; Ch++)
+    {
+        uint8 *Cr = &HostXdataMem[0x403a + Ch];
+
+        if (!(DmaPending & (1 << Ch)))
+        {
+            continue;
+        }
+
+        DmaPending &= ~(1 << Ch);
+
+        if ((*Cr & (DMAEN | DMABSY)) != (DMAEN | DMABSY))
+        {
+            continue;
+        }
+
+        if (((*Cr & (DMACFG2 | DMACFG1 | DMACFG0)) == (DMACFG2 | DMACFG1 | DMACFG0)) && HostDmaXram)
+        {
+            uint16 Len  = HostXdataMem[0x403c + Ch] + 1;
+            uint16 Ba   = *(uint16 *)&HostXdataMem[0x403e + Ch * 2];
+            uint16 Base = (uint16)(size_t)HostDmaXram & 0x07ff;
+            uint8 *Src  = HostDmaXram + ((Ba - Base) & 0x07ff);
+            uint16 i;
+
+            for (i = 0; i < Len; i++)
+            {
+                Fifo_Put(&UartTx, Src[i]);
+            }
+        }
+
+        *Cr = (*Cr & ~DMABSY) | DMAIF;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostSync
+    Description    : 提交上一次寄存器访问的副作用：sbit写回所属寄存器，UT2_DR写入转为发送，
+                     已启动的PI计算执行完成。每次寄存器访问前自动调用，仿真器读取寄存器前也应调用。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostSync(void)
+{
+    uint8 i;
+
+    for (i = 0; i < HOST_BIT_CELLS; i++)
+    {
+        HostBitCell *Cell = &BitCell[i];
+
+        if (Cell->Reg)
+        {
+            uint8 Value;
+
+            /* Keil对"GP00 = ~GP00"生成位取反，~0/~1在主机上为0xff/0xfe，只取最低位 */
+            Value = (Cell->Value >= 0xfe) ? (Cell->Value & 0x01) : (Cell->Value != 0);
+
+            if (Value != Cell->Sample)
+            {
+                if (Value)
+                {
+                    *Cell->Reg |= (uint8)(1 << Cell->Bit);
+                }
+                else
+                {
+                    *Cell->Reg &= (uint8)~(1 << Cell->Bit);
+                }
+            }
+
+            Cell->Reg = 0;
+        }
+    }
+
+    if (UartTxPending)
+    {
+        UartTxPending = 0;
+        Fifo_Put(&UartTx, HostSfrMem[0x89]);
+        HostSfrMem[0x8a] |= UT2TI;
+    }
+
+    HostPi_Service();
+
+    if (DmaPending)
+    {
+        HostDma_Service();
+    }
+
+    if (CrcPending)
+    {
+        HostCrc_Service();
+    }
+}
+
+volatile uint8 *HostSfr(uint8 Addr)
+{
+    HostSync();
+
+    if (SfrHook[Addr])
+    {
+        SfrHook[Addr](Addr);
+    }
+
+    return &HostSfrMem[Addr];
+}
+
+volatile uint8 *HostXdata(uint16 Addr)
+{
+    HostSync();
+
+    if (XdataHook[Addr])
+    {
+        XdataHook[Addr](Addr);
+    }
+
+    return &HostXdataMem[Addr];
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostSbit
+    Description    : sbit访问返回一个独立的位单元，下一次寄存器访问时再写回所属寄存器，
+                     保证"GP42 = 1"与"P4 = x"混用时结果与8051一致
+    Date           : 2026-10-17
+    Parameter      : Reg: [输入] 所属寄存器; Bit: [输入] 位号
+    ------------------------------------------------------------------------------------------------- */
+volatile uint8 *HostSbit(volatile uint8 *Reg, uint8 Bit)
+{
+    HostBitCell *Cell;
+
+    HostSync();
+
+    Cell        = &BitCell[BitCellNext];
+    BitCellNext = (BitCellNext + 1) % HOST_BIT_CELLS;
+
+    Cell->Reg    = Reg;
+    Cell->Bit    = Bit;
+    Cell->Sample = (*Reg >> Bit) & 0x01;
+    Cell->Value  = Cell->Sample;
+
+    return &Cell->Value;
+}
+
+uint8 *HostCode(uint16 Addr)
+{
+    return &HostCodeMem[Addr & (sizeof(HostCodeMem) - 1)];
+}
+
+void HostNop(void)
+{
+    HostSync();
+}
+
+void HostSetSfrHook(uint8 Addr, HostHook Hook)
+{
+    SfrHook[Addr] = Hook;
+}
+
+void HostSetXdataHook(uint16 Addr, HostHook Hook)
+{
+    XdataHook[Addr] = Hook;
+}
+
+/******************************************************************************///Peripheral Hook
+/* ADC转换在主机上瞬间完成，转换结果由仿真器直接写入ADCx_DR */
+static void Hook_Adc(uint16 Addr)
+{
+    HostXdataMem[Addr] &= ~ADCBSY;
+}
+
+/* DMA传输在主机上瞬间完成，启动写入在下一次寄存器访问时由HostDma_Service执行 */
+static void Hook_Dma(uint16 Addr)
+{
+    HostXdataMem[0x403a] &= ~DMABSY;
+    HostXdataMem[0x403b] &= ~DMABSY;
+    DmaPending |= (uint8)(1 << (Addr - 0x403a));
+}
+
+/* CRC_CR/CRC_DIN的写入在下一次寄存器访问时由HostCrc_Service执行 */
+static void Hook_CrcIn(uint16 Addr)
+{
+    CrcPending |= (Addr == 0x4021) ? 0x02 : 0x01;
+}
+
+/* CRC_DR按CRCPNT给出结果的高/低字节 */
+static void Hook_CrcDr(uint16 Addr)
+{
+    HostXdataMem[Addr] = (HostXdataMem[0x4022] & CRCPNT) ? (uint8)(CrcValue >> 8) : (uint8)CrcValue;
+}
+
+/*  UT2_DR既用于读接收字节也用于写发送字节：只有在有未读接收字节且固件已清RI之后的访问才算读，
+    其余访问视为写，在下一次寄存器访问时发出并置TI */
+static void Hook_Uart2Dr(uint16 Addr)
+{
+    Addr = Addr;
+
+    if (UartRxUnread && !(HostSfrMem[0x8a] & UT2RI))
+    {
+        UartRxUnread = 0;
+    }
+    else
+    {
+        UartTxPending = 1;
+    }
+}
+
+/* 一个字节(起始位 + 8位 + 停止位)的CPU时钟数，按固件写入UT2_BAUD的分频值和倍频位换算 */
+static uint32 Uart_ByteClocks(void)
+{
+    uint16 Baud   = *(uint16 *)&HostXdataMem[0x4042];
+    uint32 Clocks = 10UL * 16 * ((Baud & 0x1fff) + 1);
+
+    return (Baud & BAUD2_SEL) ? (Clocks >> 1) : Clocks;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostUart_Service
+    Description    : 上一个接收字节被读走、且下一个字节按波特率已收完时，把它放入UT2_DR并置RI
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostUart_Service(void)
+{
+    uint8 Value;
+
+    HostSync();
+
+    if (UartRxUnread || (HostSfrMem[0x8a] & UT2RI) || (HostSim.Clock < UartRxNext))
+    {
+        return;
+    }
+
+    if (Fifo_Get(&UartRx, &Value))
+    {
+        HostSfrMem[0x89]  = Value;
+        HostSfrMem[0x8a] |= UT2RI;
+        UartRxUnread      = 1;
+        UartRxNext       += Uart_ByteClocks();
+    }
+}
+
+/* 线路空闲时第一个字节在一个字节时间后收完，之后的字节背靠背到达 */
+void HostUart_Write(const uint8 *Buf, uint16 Len)
+{
+    if ((UartRx.Head == UartRx.Tail) && (UartRxNext < HostSim.Clock + Uart_ByteClocks()))
+    {
+        UartRxNext = HostSim.Clock + Uart_ByteClocks();
+    }
+
+    while (Len--)
+    {
+        Fifo_Put(&UartRx, *Buf++);
+    }
+}
+
+uint16 HostUart_Read(uint8 *Buf, uint16 Max)
+{
+    uint16 Len = 0;
+
+    HostSync();
+
+    while ((Len < Max) && Fifo_Get(&UartTx, &Buf[Len]))
+    {
+        Len++;
+    }
+
+    return Len;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostMcu_Reset
+    Description    : 清零所有寄存器(Flash内容保留)，安装外设钩子
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostMcu_Reset(void)
+{
+    memset(HostSfrMem, 0, sizeof(HostSfrMem));
+    memset(HostXdataMem, 0, sizeof(HostXdataMem));
+    memset(BitCell, 0, sizeof(BitCell));
+    memset(&UartTx, 0, sizeof(UartTx));
+    memset(&UartRx, 0, sizeof(UartRx));
+    UartTxPending = 0;
+    UartRxUnread  = 0;
+    UartRxNext    = 0;
+    DmaPending    = 0;
+    CrcPending    = 0;
+    CrcValue      = 0;
+
+    HostSetXdataHook(0x4039, Hook_Adc);                     // ADC_CR
+    HostSetXdataHook(0x403a, Hook_Dma);                     // DMA0_CR0
+    HostSetXdataHook(0x403b, Hook_Dma);                     // DMA1_CR0
+    HostSetSfrHook(0x89, Hook_Uart2Dr);                     // UT2_DR
+    HostSetXdataHook(0x4021, Hook_CrcIn);                   // CRC_DIN
+    HostSetXdataHook(0x4022, Hook_CrcIn);                   // CRC_CR
+    HostSetXdataHook(0x4023, Hook_CrcDr);                   // CRC_DR
+}
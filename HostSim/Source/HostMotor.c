@@ -0,0 +1,420 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : HostMotor.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 主机仿真的被控对象。每个载波周期：
+                     1. FOC硬件：按FOC__THETA做坐标变换，UDD/UQD未置位时用FOC_DQKP/DQKI做电流环；
+                     2. 电机：dq轴电压方程 + 转矩/惯量/摩擦/齿槽/负载，分HOST_MOTOR_SUBSTEP步积分；
+                     3. 传感器：TIM2正交计数与边沿周期、Z脉冲(IF0)、TIM3捕获PWM编码器占空比、母线电压。
+                     中断标志由HostSim_ServiceIrq分发，本文件只置标志位。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+#include <HostSim.h>
+#include <HostMotor.h>
+
+/******************************************************************************///Define Macro
+#define HOST_MOTOR_SUBSTEP              8                   // 每个载波周期的积分步数
+#define HOST_PI                         3.14159265358979
+#define HOST_SQRT3                      1.73205080756888
+#define HOST_ENC_PHASE1                 0.6                 // 编码器误差谐波的初相(rad)
+#define HOST_ENC_PHASE2                 2.1
+
+#define HOST_TS                         (1.0 / SAMP_FREQ)   // 载波周期(s)
+#define HOST_I_Q15                      (32767.0 * HW_RSHUNT * HW_AMPGAIN / HW_ADC_REF) // 每安培对应的Q15值
+
+/* 寄存器地址，直接访问存储区，不触发钩子 */
+#define HOST_P4                         0xe8
+#define HOST_TCON                       0x88
+#define HOST_DRV_OUT                    0xf8
+#define HOST_TIM2_CR0                   0xa1
+#define HOST_TIM2_CR1                   0xa9
+#define HOST_TIM2_CNTR                  0xaa
+#define HOST_TIM2_ARR                   0xae
+#define HOST_TIM3_CR0                   0x9c
+#define HOST_TIM3_CR1                   0x9d
+#define HOST_TIM3_DR                    0xa4
+#define HOST_TIM3_ARR                   0xa6
+
+#define HOST_DRV_CMR                    0x405c
+#define HOST_DRV_CR                     0x4062
+#define HOST_FOC_IDREF                  0x4090
+#define HOST_FOC_IQREF                  0x4092
+#define HOST_FOC_DQKP                   0x4094
+#define HOST_FOC_DQKI                   0x4096
+#define HOST_FOC_UDCFLT                 0x4098
+#define HOST_FOC_CR2                    0x40a1
+#define HOST_FOC_DMAX                   0x40b0
+#define HOST_FOC_DMIN                   0x40b2
+#define HOST_FOC_QMAX                   0x40b4
+#define HOST_FOC_QMIN                   0x40b6
+#define HOST_FOC_UD                     0x40b8
+#define HOST_FOC_UQ                     0x40ba
+#define HOST_FOC_ID                     0x40bc
+#define HOST_FOC_IQ                     0x40be
+#define HOST_FOC_IC                     0x40c6
+#define HOST_FOC_IB                     0x40c8
+#define HOST_FOC_IA                     0x40ca
+#define HOST_FOC_THETA                  0x40cc
+#define HOST_FOC_IAMAX                  0x40da
+#define HOST_FOC_IBMAX                  0x40dc
+#define HOST_FOC_ICMAX                  0x40de
+#define HOST_ADC14_DR                   0x031c
+
+#define SFR16(Addr)                     (*(int16 *)&HostSfrMem[Addr])
+#define XDATA16(Addr)                   (*(int16 *)&HostXdataMem[Addr])
+
+/******************************************************************************///Define Global Symbols
+HostMotorTypeDef HostMotor;
+
+/******************************************************************************///Function Subject
+static double Clamp(double Value, double Min, double Max)
+{
+    return (Value > Max) ? Max : ((Value < Min) ? Min : Value);
+}
+
+static int16 Q15(double Value)
+{
+    return (int16)Clamp(Value, -32768.0, 32767.0);
+}
+
+static void Max_Update(int16 *Max, double Value)
+{
+    int16 Abs = Q15((Value < 0) ? -Value : Value);
+
+    if (Abs > *Max)
+    {
+        *Max = Abs;
+    }
+}
+
+/* 定时器分频：PSC[2:0]位于CR0高三位，000为24MHz，每加1分频加倍 */
+static uint8 Tim_Shift(uint8 Cr0)
+{
+    return (Cr0 >> 5) & 0x07;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Foc_Axis
+    Description    : FOC硬件单轴电流PI，KP为Q12、KI为Q15，输出与积分都限幅于MIN~MAX。
+                     PI禁能(UDD/UQD)时输出取固件写入的值，积分项跟随输出，重新使能时无扰切换。
+    Date           : 2026-10-17
+    Parameter      : Int: [输入/出] 积分项; Ref/Fb: [输入] 给定/反馈; Out: [输入] 输出寄存器地址;
+                     Max/Min: [输入] 限幅寄存器地址; PiOn: [输入] PI是否使能
+    ------------------------------------------------------------------------------------------------- */
+static double Foc_Axis(double *Int, int16 Ref, int16 Fb, uint16 Out, uint16 Max, uint16 Min, uint8 PiOn)
+{
+    double Err = (double)Ref - Fb;
+    double Hi  = XDATA16(Max);
+    double Lo  = XDATA16(Min);
+    double Uk;
+
+    if (!PiOn)
+    {
+        *Int = XDATA16(Out);
+        return *Int;
+    }
+
+    *Int = Clamp(*Int + Err * (uint16)XDATA16(HOST_FOC_DQKI) / 32768.0, Lo, Hi);
+    Uk   = Clamp(*Int + Err * (uint16)XDATA16(HOST_FOC_DQKP) / 4096.0, Lo, Hi);
+    XDATA16(Out) = Q15(Uk);
+    return Uk;
+}
+
+/* 正交编码器：计数变化写入TIM2__CNTR，相邻两次变化的间隔写入TIM2__ARR，超过65535个时钟置T2IF */
+static void Enc_Update(unsigned long long Clock)
+{
+    uint8  Shift = Tim_Shift(HostSfrMem[HOST_TIM2_CR0]);
+    double Theta = HostMotor.Theta;
+    int32  Cnt   = (int32)floor(HostMotor.EncDir * Theta * PlusePerCircle / (2 * HOST_PI)
+                                + HostMotor.EncEcc1 * sin(Theta + HOST_ENC_PHASE1) + HostMotor.EncEcc2 * sin(2 * Theta + HOST_ENC_PHASE2));
+    int32  Delta = Cnt - HostMotor.EncCnt;
+    uint32 Ticks;
+
+    if (!(HostSfrMem[HOST_TIM2_CR1] & T2CEN))
+    {
+        HostMotor.EncCnt       = Cnt;
+        HostMotor.EncEdgeClock = Clock;
+        return;
+    }
+
+    Ticks = (uint32)((Clock - HostMotor.EncEdgeClock) >> Shift);
+
+    if (Delta != 0)
+    {
+        Ticks /= (uint32)((Delta > 0) ? Delta : -Delta);
+        SFR16(HOST_TIM2_CNTR)  = (int16)(SFR16(HOST_TIM2_CNTR) + Delta);
+        SFR16(HOST_TIM2_ARR)   = (int16)((Ticks > 0xffff) ? 0xffff : Ticks);
+        HostMotor.EncCnt       = Cnt;
+        HostMotor.EncEdgeClock = Clock;
+
+        if (Delta > 0)
+        {
+            HostSfrMem[HOST_TIM2_CR1] &= ~T2DIR;
+        }
+        else
+        {
+            HostSfrMem[HOST_TIM2_CR1] |= T2DIR;
+        }
+    }
+    else if (Ticks > 0xffff)
+    {
+        HostSfrMem[HOST_TIM2_CR1] |= T2IF;
+        HostMotor.EncEdgeClock = Clock;
+    }
+}
+
+/* Z脉冲：转子越过ZAngle时置IF0 */
+static void Z_Update(double ThetaOld)
+{
+    if (floor((ThetaOld - HostMotor.ZAngle) / (2 * HOST_PI)) != floor((HostMotor.Theta - HostMotor.ZAngle) / (2 * HOST_PI)))
+    {
+        HostSfrMem[HOST_TCON] |= 0x04;                      // IF0
+        HostMotor.ZCnt++;
+    }
+}
+
+/*  PWM绝对值编码器：每机械圈输出AbsPoles个周期的角度，一帧AbsPeriod个计数，高电平 = (1 + 角度 * 4095) / 4098，
+    每帧结束时TIM3捕获高电平与周期并置T3IP，对应Motor_Open中的换算 */
+static void Abs_Update(unsigned long long Clock)
+{
+    double Pos;
+    double Duty;
+
+    if (!(HostSfrMem[HOST_TIM3_CR1] & T3EN))
+    {
+        HostMotor.AbsNext = Clock;
+        return;
+    }
+
+    while (HostMotor.AbsNext <= Clock)
+    {
+        HostMotor.AbsNext += (unsigned long long)HostMotor.AbsPeriod << Tim_Shift(HostSfrMem[HOST_TIM3_CR0]);
+
+        Pos  = HostMotor.AbsPoles * (HostMotor.Theta - HostMotor.AbsOffset) / (2 * HOST_PI);
+        Pos -= floor(Pos);
+        Duty = (1.0 + Pos * 4095.0) / 4098.0;
+
+        SFR16(HOST_TIM3_DR)  = (int16)(uint16)(Duty * HostMotor.AbsPeriod + 0.5);
+        SFR16(HOST_TIM3_ARR) = (int16)HostMotor.AbsPeriod;
+        HostSfrMem[HOST_TIM3_CR1] |= T3IP;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Motor_Integrate
+    Description    : 在转子dq坐标系下积分电流和机械方程，载波周期内αβ电压保持不变。
+                     输出关闭时视为三相悬空，电流为零。
+    Date           : 2026-10-17
+    Parameter      : Valpha/Vbeta: [输入] 定子αβ电压(V); Drive: [输入] 逆变器是否输出
+    ------------------------------------------------------------------------------------------------- */
+static void Motor_Integrate(double Valpha, double Vbeta, uint8 Drive)
+{
+    HostMotorTypeDef *M = &HostMotor;
+    double Dt = HOST_TS / HOST_MOTOR_SUBSTEP;
+    double ThetaOld;
+    uint8  i;
+
+    for (i = 0; i < HOST_MOTOR_SUBSTEP; i++)
+    {
+        double ThetaE = Pole_Pairs * M->Theta;
+        double OmegaE = Pole_Pairs * M->Omega;
+        double Cos    = cos(ThetaE);
+        double Sin    = sin(ThetaE);
+        double Tnet;
+
+        if (Drive)
+        {
+            double Vd  =  Valpha * Cos + Vbeta * Sin;
+            double Vq  = -Valpha * Sin + Vbeta * Cos;
+            double Did = (Vd - M->Rs * M->Id + OmegaE * M->Ls * M->Iq) / M->Ls;
+            double Diq = (Vq - M->Rs * M->Iq - OmegaE * M->Ls * M->Id - OmegaE * M->Flux) / M->Ls;
+
+            M->Id += Did * Dt;
+            M->Iq += Diq * Dt;
+        }
+        else
+        {
+            M->Id = 0;
+            M->Iq = 0;
+        }
+
+        M->Loss += 1.5 * M->Rs * (M->Id * M->Id + M->Iq * M->Iq) * Dt;
+        M->Te = 1.5 * Pole_Pairs * M->Flux * M->Iq;
+        Tnet  = M->Te - M->B * M->Omega - M->Tload - M->Tcog * sin(M->CogN * M->Theta);
+
+        if ((M->Omega != 0) || (fabs(Tnet) > M->Tf))
+        {
+            double Omega = M->Omega + (Tnet - copysign(M->Tf, (M->Omega != 0) ? M->Omega : Tnet)) / M->J * Dt;
+
+            /* 库仑摩擦不会使速度反向，过零时停住，静止时按静摩擦处理 */
+            M->Omega = (M->Omega * Omega < 0) ? 0 : Omega;
+        }
+
+        ThetaOld  = M->Theta;
+        M->Theta += M->Omega * Dt;
+        Z_Update(ThetaOld);
+        Enc_Update(HostSim.Clock + (unsigned long long)(HostSim.DrvPeriod * (i + 1) / HOST_MOTOR_SUBSTEP));
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostMotor_Step
+    Description    : 推进一个载波周期，作为HostSim.PwmHook在DRV_ISR之前调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostMotor_Step(void)
+{
+    HostMotorTypeDef *M = &HostMotor;
+    uint8  Ddir;
+    uint8  FocOn;
+    uint8  Drive;
+    double Theta;
+    double Cos;
+    double Sin;
+    double ThetaE;
+    double Ialpha;
+    double Ibeta;
+    double Ia;
+    double Ib;
+    double Ic;
+    double Id;
+    double Iq;
+    double Ud;
+    double Uq;
+    double Vscale;
+
+    HostSync();
+
+    FocOn = (HostXdataMem[HOST_DRV_CR] & FOCEN) != 0;
+    Drive = FocOn && (HostSfrMem[HOST_DRV_OUT] & 0x80) && ((XDATA16(HOST_DRV_CMR) & 0x3f) == 0x3f); // MOE，三相输出使能
+    Ddir  = (HostXdataMem[HOST_DRV_CR] & DDIR) != 0;
+
+    if (Drive)
+    {
+        M->DriveCnt++;
+    }
+
+    /* 定子电流：DDIR交换V/W相序，等效于β轴取反 */
+    ThetaE = Pole_Pairs * M->Theta;
+    Ialpha = M->Id * cos(ThetaE) - M->Iq * sin(ThetaE);
+    Ibeta  = M->Id * sin(ThetaE) + M->Iq * cos(ThetaE);
+    Ia     = Ialpha;
+    Ib     = -0.5 * Ialpha + 0.5 * HOST_SQRT3 * Ibeta;
+    Ic     = -0.5 * Ialpha - 0.5 * HOST_SQRT3 * Ibeta;
+
+    if (Ddir)
+    {
+        Ibeta  = -Ibeta;
+    }
+
+    /* FOC硬件的q轴滞后d轴90°，与固件FOC_IQREF = -mcIqref的符号约定一致 */
+    Theta = (int16)XDATA16(HOST_FOC_THETA) * HOST_PI / 32768.0;
+    Cos   = cos(Theta);
+    Sin   = sin(Theta);
+    Id    = Ialpha * Cos + Ibeta * Sin;
+    Iq    = Ialpha * Sin - Ibeta * Cos;
+
+    XDATA16(HOST_FOC_IA) = Q15(Ia * HOST_I_Q15);
+    XDATA16(HOST_FOC_IB) = Q15((Ddir ? Ic : Ib) * HOST_I_Q15);
+    XDATA16(HOST_FOC_IC) = Q15((Ddir ? Ib : Ic) * HOST_I_Q15);
+    XDATA16(HOST_FOC_ID) = Q15(Id * HOST_I_Q15);
+    XDATA16(HOST_FOC_IQ) = Q15(Iq * HOST_I_Q15);
+
+    if (HostXdataMem[HOST_FOC_CR2] & ICLR)
+    {
+        HostXdataMem[HOST_FOC_CR2] &= ~ICLR;
+        M->IaMax = 0;
+        M->IbMax = 0;
+        M->IcMax = 0;
+    }
+
+    Max_Update(&M->IaMax, XDATA16(HOST_FOC_IA));
+    Max_Update(&M->IbMax, XDATA16(HOST_FOC_IB));
+    Max_Update(&M->IcMax, XDATA16(HOST_FOC_IC));
+    XDATA16(HOST_FOC_IAMAX) = M->IaMax;
+    XDATA16(HOST_FOC_IBMAX) = M->IbMax;
+    XDATA16(HOST_FOC_ICMAX) = M->IcMax;
+
+    /* FOC电流环 */
+    if (FocOn)
+    {
+        Ud = Foc_Axis(&M->UdInt, XDATA16(HOST_FOC_IDREF), XDATA16(HOST_FOC_ID), HOST_FOC_UD, HOST_FOC_DMAX, HOST_FOC_DMIN,
+                      !(HostXdataMem[HOST_FOC_CR2] & UDD));
+        Uq = Foc_Axis(&M->UqInt, XDATA16(HOST_FOC_IQREF), XDATA16(HOST_FOC_IQ), HOST_FOC_UQ, HOST_FOC_QMAX, HOST_FOC_QMIN,
+                      !(HostXdataMem[HOST_FOC_CR2] & UQD));
+    }
+    else
+    {
+        M->UdInt = 0;
+        M->UqInt = 0;
+        Ud       = 0;
+        Uq       = 0;
+    }
+
+    /* 输出电压：Q15满量程对应SVPWM线性区最大相电压Vbus/√3 */
+    Vscale = M->Vbus / HOST_SQRT3 / 32768.0;
+    Motor_Integrate((Ud * Cos + Uq * Sin) * Vscale, (Ud * Sin - Uq * Cos) * Vscale * (Ddir ? -1 : 1), Drive);
+
+    Abs_Update(HostSim.Clock);
+
+    /* 母线电压与GP42 */
+    XDATA16(HOST_ADC14_DR)   = Q15(M->Vbus / HW_BOARD_VOLT_MAX * 32767.0);
+    XDATA16(HOST_FOC_UDCFLT) = XDATA16(HOST_ADC14_DR);
+
+    if (M->NormalMode)
+    {
+        HostSfrMem[HOST_P4] |= 0x04;
+    }
+    else
+    {
+        HostSfrMem[HOST_P4] &= ~0x04;
+    }
+}
+
+int32 HostMotor_Counts(void)
+{
+    return HostMotor.EncCnt;
+}
+
+double HostMotor_Rpm(void)
+{
+    return HostMotor.Omega * 60.0 / (2 * HOST_PI);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostMotor_Init
+    Description    : 默认电机参数(11对极云台电机 + 相机负载)，状态清零并挂到HostSim.PwmHook。
+                     需要修改参数时在本函数之后、HostSim_Init之前赋值。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostMotor_Init(void)
+{
+    memset(&HostMotor, 0, sizeof(HostMotor));
+
+    HostMotor.Rs         = 5.0;
+    HostMotor.Ls         = 0.0015;
+    HostMotor.Flux       = 0.005;
+    HostMotor.J          = 5.0e-5;
+    HostMotor.B          = 1.0e-4;
+    HostMotor.Tf         = 2.0e-3;
+    HostMotor.Tcog       = 1.0e-3;
+    HostMotor.CogN       = 132;                             // 12槽22极，齿槽周期数 = LCM(12, 22)
+    HostMotor.Tload      = 0;
+    HostMotor.Vbus       = 12.0;
+
+    HostMotor.EncDir     = -1;
+    HostMotor.ZAngle     = -0.3;                             // 自学习时转子反转，约0.3rad后遇到Z
+    HostMotor.AbsOffset  = 0;
+    HostMotor.EncEcc1    = 0;
+    HostMotor.EncEcc2    = 0;
+    HostMotor.AbsPoles   = (uint8)Pole_Pairs;               // Motor_Open按电角度换算PWM编码器角度
+    HostMotor.AbsPeriod  = 4098;
+    HostMotor.NormalMode = 1;
+
+    HostSim.PwmHook = HostMotor_Step;
+}
@@ -0,0 +1,188 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : HostSim.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 主机仿真调度。以CPU时钟为时间基准，确定性地交替执行DRV_ISR、SYStick_INT、
+                     UART2中断和主循环，中断在EA关闭时延后执行。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+#include <HostSim.h>
+
+/******************************************************************************///Define Macro
+#define HOST_CLOCK_HZ                   (MCU_CLOCK * 1000000)
+#define HOST_IRQ_MAX                    32                  // 单次服务最多进入外设中断次数
+
+/******************************************************************************///Define Global Symbols
+HostSimTypeDef HostSim;
+
+/******************************************************************************///Function Subject
+static uint8 Irq_Enabled(void)
+{
+    HostSync();
+    return (HostSfrMem[0xa8] & 0x80) != 0;                  // EA
+}
+
+/*  TIM4计数值按仿真时钟给出。中断函数在仿真中不消耗时钟，耗时统计在主机上只能验证流程，
+    读数为0，实际耗时需在芯片上测量 */
+static void Hook_Tim4Cntr(uint16 Addr)
+{
+    if (HostSfrMem[0x9f] & T4EN)                            // TIM4_CR1
+    {
+        *(uint16 *)&HostSfrMem[Addr] = (uint16)(HostSim.Clock >> ((HostSfrMem[0x9e] >> 5) & 0x07));
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostSim_ServiceIrq
+    Description    : 按优先级分发外设中断：EXTI0(Z脉冲) > TIM2 > TIM3(PWM编码器捕获) > UART2收发 > DMA发送完成，
+                     标志由外设模型置位，由中断函数清除
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostSim_ServiceIrq(void)
+{
+    uint8 i;
+
+    for (i = 0; i < HOST_IRQ_MAX; i++)
+    {
+        HostUart_Service();
+
+        if (!Irq_Enabled())
+        {
+            break;
+        }
+
+        if ((HostSfrMem[0xa8] & 0x01) && (HostSfrMem[0x88] & 0x04))            // EX0 && IF0
+        {
+            EXTI_INT();
+        }
+        else if (HostSfrMem[0xa9] & ((HostSfrMem[0xa9] << 2) & (T2IP | T2IF)))  // T2IPE/T2IFE对应T2IP/T2IF
+        {
+            TIM2_INT();
+        }
+        else if (HostSfrMem[0x9d] & ((HostSfrMem[0x9d] << 2) & (T3IP | T3IF)))  // T3IPE/T3IFE对应T3IP/T3IF
+        {
+            TIM3_INT();
+        }
+        else if ((*(uint16 *)&HostXdataMem[0x4042] & UART2IEN) && (HostSfrMem[0x8a] & (UT2TI | UT2RI)))
+        {
+            USART2_INT();
+        }
+        else if ((HostXdataMem[0x403a] & DMAIE) && ((HostXdataMem[0x403a] | HostXdataMem[0x403b]) & DMAIF))
+        {
+            DMA_INT();
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+static void Sim_Drv(void)
+{
+    if (HostSim.PwmHook)
+    {
+        HostSim.PwmHook();
+    }
+
+    if (Irq_Enabled() && (HostXdataMem[0x4061] & (DCIM1 | DCIM0)))
+    {
+        HostXdataMem[0x4061] = (HostXdataMem[0x4061] & ~(SYSTIF | FGIF)) | DCIF;
+        DRV_ISR();
+        HostSync();
+        HostSim.DrvCnt++;
+    }
+}
+
+static void Sim_Syst(void)
+{
+    if (HostSim.SystHook)
+    {
+        HostSim.SystHook();
+    }
+
+    if (Irq_Enabled() && (HostXdataMem[0x4061] & SYSTIE))
+    {
+        HostXdataMem[0x4061] = (HostXdataMem[0x4061] & ~(DCIF | FGIF)) | SYSTIF;
+        SYStick_INT();
+        HostSync();
+        HostSim.SystCnt++;
+    }
+
+    /* SysTick周期以固件写入的SYST_ARR为准 */
+    HostSim.SystPeriod = *(uint16 *)&HostXdataMem[0x4064] + 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostSim_Init
+    Description    : 寄存器复位并执行固件上电初始化SystemInit()
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HostSim_Init(void)
+{
+    HostSimHook PwmHook  = HostSim.PwmHook;
+    HostSimHook SystHook = HostSim.SystHook;
+
+    memset(&HostSim, 0, sizeof(HostSim));
+    HostSim.PwmHook    = PwmHook;
+    HostSim.SystHook   = SystHook;
+    HostSim.DrvPeriod  = (uint32)(HOST_CLOCK_HZ / (PWM_FREQUENCY * 1000));
+    HostSim.LoopDiv    = 1;
+
+    HostMcu_Reset();
+    HostDmaXram = (uint8 *)&UartTxQ;                        // 固件中唯一由DMA读取的XDATA变量
+    HostSetSfrHook(0x92, Hook_Tim4Cntr);                    // TIM4__CNTR
+    *(uint16 *)&HostXdataMem[0x4064] = 0x5dbf;              // SYST_ARR复位值
+
+    SystemInit();
+    HostSync();
+
+    HostSim.SystPeriod = *(uint16 *)&HostXdataMem[0x4064] + 1;
+    HostSim.DrvNext    = HostSim.DrvPeriod;
+    HostSim.SystNext   = HostSim.SystPeriod;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HostSim_Run
+    Description    : 推进指定的CPU时钟数，两次中断之间按LoopDiv执行主循环
+    Date           : 2026-10-17
+    Parameter      : Clocks: [输入] CPU时钟数
+    ------------------------------------------------------------------------------------------------- */
+void HostSim_Run(unsigned long long Clocks)
+{
+    unsigned long long End = HostSim.Clock + Clocks;
+
+    while (HostSim.Clock < End)
+    {
+        if (HostSim.SystNext <= HostSim.DrvNext)
+        {
+            HostSim.Clock     = HostSim.SystNext;
+            HostSim.SystNext += HostSim.SystPeriod;
+            Sim_Syst();
+        }
+        else
+        {
+            HostSim.Clock    = HostSim.DrvNext;
+            HostSim.DrvNext += HostSim.DrvPeriod;
+            Sim_Drv();
+
+            if ((HostSim.DrvCnt % HostSim.LoopDiv) == 0)
+            {
+                BackgroundLoop();
+                HostSim.LoopCnt++;
+            }
+        }
+
+        HostSim_ServiceIrq();
+    }
+}
+
+void HostSim_RunMs(uint32 Ms)
+{
+    HostSim_Run((unsigned long long)Ms * (HOST_CLOCK_HZ / 1000));
+}
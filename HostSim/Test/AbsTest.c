@@ -0,0 +1,279 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : AbsTest.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : AbsEnc整数换算的主机检查，make abstest运行，全部通过时返回0。
+                     对帧周期ABS_FRAME下的全部ABS_CODES+1个角度码和-360~360度的零位偏移，AbsEnc_Duty/Angle/
+                     Theta/Cntr和全部int16零位角的AbsEnc_OffsetDeg必须与原公式按有理数精确计算后截断的结果逐位相同。
+                     与按源码写法(变量为float、常数为double)计算的原浮点公式比较时，只允许精确值离整数不到1/32、
+                     浮点舍入到另一侧而差1的点，零位偏移为0时这样的点必须正好是Known中列出的4个角度码；
+                     C51上double也是单精度，全部按float计算时差别更多，只要求不超过1。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <MyProject.h>
+
+/******************************************************************************///Define Macro
+#define TEST_OFFSET_MAX                 360                 // 零位偏移扫描范围(度)
+#define TEST_NEAR_SHIFT                 5                   // 精确值离整数不到1/32时认为浮点可能舍入到另一侧
+
+/******************************************************************************///Define Type
+typedef struct
+{
+    uint16 Code;                                            // 角度码
+    int16  Theta;                                           // AbsEnc_Theta，即精确值截断
+    int16  Float;                                           // 原浮点公式的结果
+} TestKnown;
+
+typedef struct
+{
+    long   Num;                                             // 比较次数
+    long   Diff;                                            // 与浮点公式不同的次数
+    long   Bad;                                             // 错误次数
+} TestCount;
+
+/******************************************************************************///Define Global Symbols
+/* 零位偏移为0时浮点公式与精确值差1的全部角度码，精确值距整数都在1e-3以内 */
+static const TestKnown Known[] =
+{
+    {1365,  21843,  21844},                                 // 精确值21843.99951
+    {2048, -32762, -32763},                                 // 32774.00098，超过180°回绕
+    {3243, -13638, -13639},                                 // 51898.00098
+    {3499,  -9541,  -9542},                                 // 55995.00024
+};
+
+#define KNOWN_NUM                       (sizeof(Known) / sizeof(Known[0]))
+
+/******************************************************************************///Function Subject
+/* Num / Den向零取整，同时判断精确值是否离整数很近 */
+static long long Exact_Div(long long Num, long long Den, int *Near)
+{
+    long long R = llabs(Num % Den);
+
+    *Near = (R << TEST_NEAR_SHIFT <= Den) || ((Den - R) << TEST_NEAR_SHIFT <= Den);
+    return Num / Den;
+}
+
+/* 原Motor_Open中的FOC__THETA = _Q15(Angle / 180.0)，PwmDuty和Angle为float，其余按源码中的double常数计算 */
+static int16 Float_Theta(uint16 Duty, int16 OffsetDeg)
+{
+    float PwmDuty = Duty / 32767.0;
+    float Angle   = (PwmDuty * 4098 - 1) / 4095 * 360.0 - OffsetDeg;
+
+    return _Q15(Angle / 180.0);
+}
+
+/* 原Motor_Open中的TIM2__CNTR = -P_Value(Angle) / Pole_Pairs */
+static int16 Float_Cntr(uint16 Duty, int16 OffsetDeg)
+{
+    float PwmDuty = Duty / 32767.0;
+    float Angle   = (PwmDuty * 4098 - 1) / 4095 * 360.0 - OffsetDeg;
+
+    return (int16)(int32)(-P_Value(Angle) / Pole_Pairs);
+}
+
+/* 原mcAlign中的_Q15(Angle / 360.0) */
+static int16 Float_Angle(uint16 Duty)
+{
+    float PwmDutyFlt = Duty / 32767.0;
+    float Angle      = (PwmDutyFlt * 4098 - 1) / 4095 * 360.0;
+
+    return _Q15(Angle / 360.0);
+}
+
+/* 同一公式在C51上全部按单精度计算 */
+static int16 Single_Theta(uint16 Duty, int16 OffsetDeg)
+{
+    float PwmDuty = Duty / 32767.0f;
+    float Angle   = (PwmDuty * 4098 - 1) / 4095 * 360.0f - OffsetDeg;
+
+    return (int16)(int32)(Angle / 180.0f * 32767);
+}
+
+static int16 Single_Cntr(uint16 Duty, int16 OffsetDeg)
+{
+    float PwmDuty = Duty / 32767.0f;
+    float Angle   = (PwmDuty * 4098 - 1) / 4095 * 360.0f - OffsetDeg;
+    int32 P       = (int32)(Angle / 360.0f * 65536.0f);
+
+    return (int16)(int32)(-P / 11.0f);
+}
+
+/* 整数结果Int与精确值Exact必须相同；与浮点结果Flt不同时只能差1且精确值在量化边界附近 */
+static void Check(TestCount *Cnt, const char *Name, long Arg0, long Arg1, int16 Int, int16 Exact, int16 Flt, int Near)
+{
+    Cnt->Num++;
+
+    if (Int != Exact)
+    {
+        if (Cnt->Bad++ < 10)
+        {
+            printf("FAIL %s(%ld, %ld) = %d, exact %d\n", Name, Arg0, Arg1, Int, Exact);
+        }
+        return;
+    }
+
+    if (Int != Flt)
+    {
+        Cnt->Diff++;
+
+        if ((abs(Int - Flt) != 1) || !Near)
+        {
+            if (Cnt->Bad++ < 10)
+            {
+                printf("FAIL %s(%ld, %ld) = %d, float %d is not a boundary case\n", Name, Arg0, Arg1, Int, Flt);
+            }
+        }
+    }
+}
+
+/* 与单精度结果Flt相差不超过1 */
+static void Check_Single(TestCount *Cnt, const char *Name, long Arg0, long Arg1, int16 Int, int16 Flt)
+{
+    Cnt->Num++;
+
+    if (Int != Flt)
+    {
+        Cnt->Diff++;
+
+        if ((abs(Int - Flt) != 1) && (Cnt->Bad++ < 10))
+        {
+            printf("FAIL %s(%ld, %ld) = %d, single %d\n", Name, Arg0, Arg1, Int, Flt);
+        }
+    }
+}
+
+static void Report(const TestCount *Cnt, const char *Name)
+{
+    printf("%-8s: %9ld points, %5ld differ from float by 1 LSB at a boundary, %ld failures\n",
+           Name, Cnt->Num, Cnt->Diff, Cnt->Bad);
+}
+
+/* 浮点Q15占空比_Q15((float)Dr / Arr) */
+static void Test_Duty(TestCount *Cnt)
+{
+    uint16 Dr;
+    int    Near;
+    int16  Exact;
+
+    for (Dr = 0; Dr < ABS_FRAME; Dr++)
+    {
+        Exact = (int16)Exact_Div((long long)Dr * 32767, ABS_FRAME, &Near);
+        Check(Cnt, "Duty", Dr, ABS_FRAME, (int16)AbsEnc_Duty(Dr, ABS_FRAME), Exact,
+              (int16)(int32)((float)Dr / ABS_FRAME * 32767), Near);
+    }
+}
+
+/* 零位角换算为整度，(float)((int32)AngleFlt * 360.0) / 32767 写入int16 */
+static void Test_Offset(TestCount *Cnt)
+{
+    long  AngleFlt;
+    int   Near;
+    int16 Exact;
+
+    for (AngleFlt = -32768; AngleFlt <= 32767; AngleFlt++)
+    {
+        Exact = (int16)Exact_Div(AngleFlt * 360, 32767, &Near);
+        Check(Cnt, "Offset", AngleFlt, 0, AbsEnc_OffsetDeg((int16)AngleFlt), Exact,
+              (int16)(int32)((float)(AngleFlt * 360.0f) / 32767), Near);
+    }
+}
+
+int main(void)
+{
+    TestCount Duty   = {0};
+    TestCount Offset = {0};
+    TestCount Angle  = {0};
+    TestCount Theta  = {0};
+    TestCount Cntr   = {0};
+    TestCount Single = {0};
+    uint16    Code;
+    uint16    D;
+    int16     L;
+    int16     Int;
+    int16     Flt;
+    int16     Exact;
+    int       Near;
+    long long Base;
+    long long Num;
+    long long P;
+    uint8     Found[KNOWN_NUM] = {0};
+    uint8     i;
+    long      Bad = 0;
+
+    Test_Duty(&Duty);
+    Test_Offset(&Offset);
+
+    for (Code = 0; Code <= ABS_CODES; Code++)
+    {
+        D    = AbsEnc_Duty(Code + ABS_INIT_CLKS, ABS_FRAME);
+        Base = (long long)ABS_FRAME * D - 32767;
+        Exact = (int16)Exact_Div(Base, ABS_CODES, &Near);
+        Check(&Angle, "Angle", Code, 0, AbsEnc_Angle(D), Exact, Float_Angle(D), Near);
+
+        for (L = -TEST_OFFSET_MAX; L <= TEST_OFFSET_MAX; L++)
+        {
+            /* Angle * 32767 / 180 = ((4098 * Duty - 32767) * 360 - L * 32767 * 4095) / (4095 * 180) */
+            Num = Base * 360 - (long long)L * 32767 * ABS_CODES;
+            Int = AbsEnc_Theta(D, L);
+            Flt = Float_Theta(D, L);
+            Exact = (int16)Exact_Div(Num, (long long)ABS_CODES * 180, &Near);
+            Check(&Theta, "Theta", Code, L, Int, Exact, Flt, Near);
+            Check_Single(&Single, "Theta", Code, L, Int, Single_Theta(D, L));
+
+            if ((L == 0) && (Int != Flt))
+            {
+                for (i = 0; (i < KNOWN_NUM) && (Known[i].Code != Code); i++)
+                {
+                }
+
+                if ((i == KNOWN_NUM) || (Known[i].Theta != Int) || (Known[i].Float != Flt))
+                {
+                    printf("FAIL Theta(%u, 0) = %d, float %d is not a known case\n", Code, Int, Flt);
+                    Bad++;
+                }
+                else
+                {
+                    Found[i] = 1;
+                }
+            }
+
+            /* P = Angle * 65536 / 360，Cntr = -P / Pole_Pairs，偏移为0时与浮点公式没有差别 */
+            P   = Exact_Div(Num * 65536, (long long)360 * 32767 * ABS_CODES, &Near);
+            Int = AbsEnc_Cntr(D, L);
+            Flt = Float_Cntr(D, L);
+            Check(&Cntr, "Cntr", Code, L, Int, (int16)(-P / (int)Pole_Pairs), Flt, Near);
+            Check_Single(&Single, "Cntr", Code, L, Int, Single_Cntr(D, L));
+
+            if ((L == 0) && (Int != Flt))
+            {
+                printf("FAIL Cntr(%u, 0) = %d, float %d\n", Code, Int, Flt);
+                Bad++;
+            }
+        }
+    }
+
+    for (i = 0; i < KNOWN_NUM; i++)
+    {
+        if (!Found[i])
+        {
+            printf("FAIL known case Theta(%u, 0) = %d, float %d was not seen\n", Known[i].Code, Known[i].Theta, Known[i].Float);
+            Bad++;
+        }
+    }
+
+    Report(&Duty, "Duty");
+    Report(&Offset, "Offset");
+    Report(&Angle, "Angle");
+    Report(&Theta, "Theta");
+    Report(&Cntr, "Cntr");
+    printf("%-8s: %9ld points, %5ld differ from single precision by 1 LSB, %ld failures\n",
+           "C51", Single.Num, Single.Diff, Single.Bad);
+    Bad += Duty.Bad + Offset.Bad + Angle.Bad + Theta.Bad + Cntr.Bad + Single.Bad;
+    printf("%s\n", Bad ? "FAILED" : "PASSED");
+
+    return Bad ? 1 : 0;
+}
@@ -0,0 +1,166 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : CtrlTest.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : CtrlLib的主机检查，make ctrltest运行，全部通过时返回0。
+                     Ctrl_LevelToSpeed对0~255的每个档位必须与原Uart中spd = level * 0.83 + 0.333、
+                     S_Value(spd)的浮点结果逐位相同(超过SPEED_LEVEL_MAX按SPEED_LEVEL_MAX)，C51上全部按单精度计算时
+                     也相同；Ctrl_SpeedToLevel对每个档位的速度回到该档位，对全部int16速度给出表中最接近的档位。
+                     按默认增益POS_LOOP_KP/KI/KD初始化的mcPosPID，对-30000~30000的每个位置误差输出必须等于误差本身，
+                     即原Speed_response中的speedRef = PosErr。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <stdio.h>
+#include <stdlib.h>
+#include <MyProject.h>
+
+/******************************************************************************///Define Macro
+#define TEST_POS_ERR_MAX                30000               // Speed_response中位置误差的限幅
+
+/******************************************************************************///Define Global Symbols
+static long Bad;
+
+/******************************************************************************///Function Subject
+static void Fail(const char *Msg, long Arg, long Value, long Expect)
+{
+    if (Bad++ < 10)
+    {
+        printf("FAIL %s(%ld) = %ld, expected %ld\n", Msg, Arg, Value, Expect);
+    }
+}
+
+/* 原Uart中设定速度: spd为float，其余按源码中的double常数计算 */
+static int16 Float_LevelToSpeed(uint8 Level)
+{
+    float spd;
+
+    if (Level >= 0x90)
+    {
+        Level = 0x90;
+    }
+
+    spd = Level * 0.83 + 0.333;
+    return S_Value(spd);
+}
+
+/* 同一公式在C51上全部按单精度计算 */
+static int16 Single_LevelToSpeed(uint8 Level)
+{
+    float spd;
+
+    if (Level >= 0x90)
+    {
+        Level = 0x90;
+    }
+
+    spd = Level * 0.83f + 0.333f;
+    return (int16)(int32)(spd / (float)MOTOR_SPEED_BASE * 32767);
+}
+
+static void Test_Level(void)
+{
+    uint16 Level;
+
+    for (Level = 0; Level <= 0xFF; Level++)
+    {
+        if (Ctrl_LevelToSpeed(Level) != Float_LevelToSpeed(Level))
+        {
+            Fail("Ctrl_LevelToSpeed", Level, Ctrl_LevelToSpeed(Level), Float_LevelToSpeed(Level));
+        }
+
+        if (Ctrl_LevelToSpeed(Level) != Single_LevelToSpeed(Level))
+        {
+            Fail("Ctrl_LevelToSpeed single", Level, Ctrl_LevelToSpeed(Level), Single_LevelToSpeed(Level));
+        }
+
+        if ((Level <= SPEED_LEVEL_MAX) && (Ctrl_SpeedToLevel(Ctrl_LevelToSpeed(Level)) != Level))
+        {
+            Fail("Ctrl_SpeedToLevel(Ctrl_LevelToSpeed)", Level, Ctrl_SpeedToLevel(Ctrl_LevelToSpeed(Level)), Level);
+        }
+    }
+
+    printf("level   : levels 0..255 checked against S_Value(level * 0.83 + 0.333)\n");
+}
+
+/* 表中离|Speed|最近的档位，距离相同时取低档 */
+static void Test_Nearest(void)
+{
+    long  Speed;
+    long  Abs;
+    long  Dist;
+    long  Best;
+    uint8 Level;
+    uint8 Expect;
+    uint8 i;
+
+    for (Speed = -32768; Speed <= 32767; Speed++)
+    {
+        Abs    = labs(Speed);
+        Expect = 0;
+        Best   = labs(Abs - Ctrl_LevelToSpeed(0));
+
+        for (i = 1; i <= SPEED_LEVEL_MAX; i++)
+        {
+            Dist = labs(Abs - Ctrl_LevelToSpeed(i));
+
+            if (Dist < Best)
+            {
+                Best   = Dist;
+                Expect = i;
+            }
+        }
+
+        Level = Ctrl_SpeedToLevel((int16)Speed);
+
+        if (Level != Expect)
+        {
+            Fail("Ctrl_SpeedToLevel", Speed, Level, Expect);
+        }
+    }
+
+    printf("nearest : 65536 speeds checked against the nearest level\n");
+}
+
+/* 位置环按默认增益就是原来的speedRef = PosErr，先正向后反向扫一遍，积分和微分状态不影响输出 */
+static void Test_PosPid(void)
+{
+    CTRL_PID Pid;
+    long     Err;
+    int16    Out;
+
+    Ctrl_PidInit(&Pid, POS_LOOP_KP, POS_LOOP_KI, POS_LOOP_KD, -POS_LOOP_OUT, POS_LOOP_OUT);
+
+    for (Err = -TEST_POS_ERR_MAX; Err <= TEST_POS_ERR_MAX; Err++)
+    {
+        Out = Ctrl_Pid(&Pid, (int16)Err);
+
+        if (Out != Err)
+        {
+            Fail("Ctrl_Pid", Err, Out, Err);
+        }
+    }
+
+    for (Err = TEST_POS_ERR_MAX; Err >= -TEST_POS_ERR_MAX; Err--)
+    {
+        Out = Ctrl_Pid(&Pid, (int16)Err);
+
+        if (Out != Err)
+        {
+            Fail("Ctrl_Pid", Err, Out, Err);
+        }
+    }
+
+    printf("pos pid : speedRef == PosErr checked for |PosErr| <= %d\n", TEST_POS_ERR_MAX);
+}
+
+int main(void)
+{
+    Test_Level();
+    Test_Nearest();
+    Test_PosPid();
+    printf("%s\n", Bad ? "FAILED" : "PASSED");
+
+    return Bad ? 1 : 0;
+}
@@ -31,20 +31,6 @@ typedef struct
     uint16 Max_ic;                                                              // IC的最大值
 }CurrentVarible;
 
-typedef struct
-{
-    uint16 TimeDR;               // 比较值
-    uint16 PwmCompare;
-    uint16 TimeARR;              // 周期值
-    uint16 PwmArr;               // 计算中的周期值	
-    uint16 PwmCompareOld;        // 上一次的比较值
-    uint16 PwmArrOld;            // 上一次的周期值
-
-    uint32 PwmDuty;              // PWM占空比，Q15格式
-    uint16 PwmSclk;              // PWM频率
-    int16  PwmUpdateFlag;        // PWM新的duty更新
-}PWMINPUTCAL;
-
 typedef struct
 {
     uint8 SecondStartTimes;                                                    // 二次启动保护的次数
@@ -79,7 +65,6 @@ typedef struct
     // uint16 StallRecover;                                                     // 堵转保护恢复时间
     //Loss Phase protect
 
-    uint16 Lphasecnt;                                                           // 缺相保护计时
     uint16 AOpencnt ;                                                           // A缺相计数
     uint16 BOpencnt ;                                                           // B缺相计数
     uint16 COpencnt ;                                                           // C缺相计数
@@ -175,8 +160,6 @@ typedef struct
     int16  LreanAngleFlt2_LSB;
     uint16 LreanTimeCnt;
 		
-		uint8 UQTurnFlag;//切q轴电流强拖标志位
-		uint8 UQLockFlag;
 		uint8 ThetaIQ_SOURCE;//电机电角度来源
 		uint16 Timedelay;
 		
@@ -207,38 +190,65 @@ typedef struct
 
 typedef struct
 {
-    int16  ACCPulsesNum;                  
-    
-    float  Acc;
-    float  AccReal;
-    float  Speed;
-    
-    float  TargetSpeed; 
-    float  TargetSpeed2; 
-    
-    int32 PulsesNum;
-      int32 PulsesNumStop;
+    int32  TargetPulsesNum;                                 // 目标位置(计数)
+    int32  PulsesNum;                                       // 位置给定(计数)，送位置环
+    int32  PulsesNum_LSB;                                   // 位置给定小数部分，Q(16 + SPLAN_JERK_SHIFT)
+    int32  Speed;                                           // 速度给定(计数/节拍，Q16)
+    int32  Acc;                                             // 加速度给定(计数/节拍²，Q16)
+
+    int32  SpeedMax;                                        // 最大速度(计数/节拍，Q16)，由速度档位给出
+    int32  AccMax;                                          // 最大加速度(计数/节拍²，Q16)
+
+    int32  TrapPulsesNum;                                   // 梯形曲线位置(计数)
+    uint16 TrapPulsesNum_LSB;
+    int32  TrapSpeed;                                       // 梯形曲线速度(计数/节拍，Q16)
+    int32  SpeedBuf[SPLAN_JERK_TICKS];                      // 梯形曲线速度的滑动平均缓冲
+    int32  SpeedSum;
+    uint8  BufIndex;
+    uint8  HoldCnt;                                         // 梯形曲线到位后的节拍数
+    uint8  Done;                                            // 1: 位置给定已到达目标
+    uint8  Cmd;                                             // 接受的位置指令计数，目标改变时加1，示波器按此触发
+
+    uint8  Speedlevel;
+}SPlanTypeDef;
 
-    int32 TargetPulsesNum;
-    
-    uint8 Speedlevel;
-	
 
+typedef struct
+{
+    uint16 Kv;                                              // 速度前馈增益，Q12
+    uint16 Ka;                                              // 加速度->Iq前馈增益，Q16
+    int16  SpeedFF;                                         // 速度前馈(S_Value)
+    int16  IqFF;                                            // 电流前馈(I_Value)
+}FFTypeDef;
 
-}SPlanTypeDef;
+typedef struct
+{
+    uint16 X;                                               // 折点，|speedRef|(S_Value)或|PosErr|(计数)，递增
+    uint16 KpMul;                                           // 折点处Kp倍数，Q8
+    uint16 KiMul;                                           // 折点处Ki倍数，Q8
+}GSPointTypeDef;
+
+typedef struct
+{
+    uint16 Kp;                                              // 正在使用的PI2_KP，Q12
+    uint16 Ki;                                              // 正在使用的PI2_KI，Q15
+    uint16 KpMul;                                           // 两张表查得的倍数之积，Q8
+    uint16 KiMul;
+}GSTypeDef;
 
+typedef struct
+{
+    uint16 X;                                               // 折点，|速度|(S_Value)，递增
+    int16  Id;                                              // 折点处Id前馈(I_Value)，不大于0
+}FWPointTypeDef;
 
-typedef struct{
-    float SetVal;
-    float ActualVal;
-    float err;
-    float err_last;
-    float Kp;
-    float Ki;
-    float Kd;
-    float voltage;			
-    float integral;
-}_PID;
+typedef struct
+{
+    int16  Uq;                                              // 本节拍|FOC__UQ|
+    int16  IdFF;                                            // 查表得到的Id前馈
+    int32  IdAcc;                                           // 电压裕量调节器积分，Q(FW_KI_SHIFT)，不大于0
+    int16  Id;                                              // 写入FOC_IDREF的Id
+}FWTypeDef;
 
 typedef union 
 {
@@ -288,7 +298,10 @@ extern FOCCTRL        xdata mcFocCtrl;
 extern MCRAMP         xdata MotorSpeed;
 
 extern SPlanTypeDef   xdata mcSP;
-extern PWMINPUTCAL    xdata mcPwmInput;
+extern FFTypeDef      xdata mcFF;
+extern GSTypeDef      xdata mcGS;
+extern FWTypeDef      xdata mcFW;
+extern CTRL_PID       xdata mcPosPID;
 
 extern uint8 data isCtrlPowerOn;
 
@@ -305,10 +318,16 @@ extern void   Fault_Stall(void);
 extern void   Fault_phaseloss(void);
 extern void   VariablesPreInit(void);
 extern void   Fault_Detection(void);
-extern void   PWMInputCapture(void);
 
 
 extern void   SpeedPlanMs(void);
+extern void   SpeedPlanSet(int32 Target);
+extern void   SpeedPlanReset(int32 Pos);
+extern void   FF_Load(void);
+extern void   FF_Save(void);
+extern void   FF_Report(void);
+extern void   SpeedGainSched(int32 Ref, int32 Err);
+extern void   FieldWeaken(void);
 extern void   Speed_response(void);
 extern void   mc_ramp(MCRAMP *hSpeedramp);
 extern void   VSPSample(void);
@@ -316,6 +335,7 @@ extern int16  HW_One_PI(int16 Xn1);
 extern void   FaultProcess(void);
 
 extern uint32 Abs_F32(int32 value);
+extern uint16 Sqrt_U32(uint32 X);
 extern MCRAMP             idata   mcSpeedRamp;
 extern MCRAMP             idata   mcSpeedRampLim;
 extern MCRAMP             idata   mcPluseramp;
@@ -0,0 +1,84 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : AbsEnc.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : PWM绝对值编码器。一帧ABS_FRAME个编码器时钟: 帧头ABS_INIT_CLKS个时钟为高，之后ABS_CODES个
+/*                   数据时钟中角度码个为高，最后ABS_TAIL_CLKS个时钟为低，编码器出错时帧尾拉高；角度码0 ~ ABS_CODES
+/*                   对应一个电周期。TIM3_INT只把捕获的高电平/周期放入缓冲区，AbsEnc_Task在主循环中检查帧格式、
+/*                   丢弃周期跳变的帧，对最近ABS_MEDIAN_N帧取中值(处理0/ABS_CODES回绕)并给出可信度、抖动和延迟；
+/*                   TIM3溢出(无边沿)时按P1.1电平记为0%或100%卡死。中值读数换算为启动时的FOC__THETA和TIM2__CNTR，
+/*                   全部为整数运算，与原浮点公式按有理数精确计算的结果一致。
+/*                   81 09 06 2E 0f FF  f=0 -> 90 50 0s 0l 中值 抖动 可信度 FF，s为AbsEnc.Status，l为AbsEnc.Latency
+/*                                      f=1 -> 90 50 0s 有效帧 毛刺 错误 丢帧 FF，各4个半字节
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __ABSENC_H_
+#define __ABSENC_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define ABS_FRAME                       (4098)              // 每帧编码器时钟数
+#define ABS_CODES                       (4095)              // 最大角度码，与0同为一个电周期的起点
+#define ABS_INIT_CLKS                   (1)                 // 帧头
+#define ABS_TAIL_CLKS                   (ABS_FRAME - ABS_INIT_CLKS - ABS_CODES)   // 帧尾
+
+#define ABS_RAW_NUM                     (4)                 // TIM3_INT到AbsEnc_Task的缓冲帧数，2的幂
+#define ABS_MEDIAN_N                    (5)                 // 中值滤波帧数，奇数，183Hz帧率下约27ms
+#define ABS_ARR_TOL_SHIFT               (4)                 // 周期偏离参考值超过1/16的帧丢弃
+#define ABS_JITTER_MAX                  (8)                 // 窗口内角度码极差不超过此值读数才可用于启动，约0.7°电角度
+#define ABS_ALIGN_JITTER                (2)                 // 预定位时转子须静止到此极差以内才结束
+#define ABS_ALIGN_MIN                   (400)               // 预定位至少200ms(SysTick周期)，之后读数可用即结束，最长仍为Align_Time
+
+/* AbsEnc.Status，最近一次处理的结果 */
+#define ABS_WAIT                        (0)                 // 上电或出错后有效帧还不足ABS_MEDIAN_N
+#define ABS_OK                          (1)
+#define ABS_GLITCH                      (2)                 // 周期跳变，该帧已丢弃
+#define ABS_ERR_INIT                    (3)                 // 高电平不足半个时钟，没有帧头
+#define ABS_ERR_FLAG                    (4)                 // 帧尾为高或高电平超过周期，编码器报错
+#define ABS_STUCK_LOW                   (5)                 // 无边沿，P1.1为低(0%)
+#define ABS_STUCK_HIGH                  (6)                 // 无边沿，P1.1为高(100%)
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint16  RawDr[ABS_RAW_NUM];                             // TIM3_INT写入的高电平计数
+    uint16  RawArr[ABS_RAW_NUM];                            // TIM3_INT写入的周期计数
+    uint8   RawWr;                                          // TIM3_INT写下标
+    uint8   RawRd;                                          // AbsEnc_Task读下标
+    uint8   Stuck;                                          // TIM3_INT置ABS_STUCK_xxx，AbsEnc_Task处理后清零
+    uint8   Status;                                         // ABS_xxx
+    uint8   Conf;                                           // 上次出错后连续有效的帧数，饱和到255
+    uint8   Latency;                                        // 中值取自几帧之前，0为最新一帧
+    uint8   Wr;                                             // Code下标
+    uint8   GlitchRun;                                      // 连续周期跳变的帧数，到ABS_MEDIAN_N时改用新周期作参考
+    uint16  Code[ABS_MEDIAN_N];                             // 最近ABS_MEDIAN_N个有效帧的角度码
+    uint16  ArrRef;                                         // 周期参考值，有效帧的低通
+    uint16  Median;                                         // 中值角度码
+    uint16  Duty;                                           // Median对应的Q15占空比，AbsEnc_Angle等的输入
+    uint16  Jitter;                                         // 窗口内角度码极差
+    uint16  Frames;                                         // 有效帧数
+    uint16  Glitch;                                         // 周期跳变丢弃的帧数
+    uint16  Error;                                          // 帧头/帧尾错误和卡死次数
+    uint16  Lost;                                           // 缓冲区满丢掉的帧数
+} ABS_ENC;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern ABS_ENC xdata AbsEnc;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void   AbsEnc_Init(void);
+extern void   AbsEnc_Capture(uint16 Dr, uint16 Arr);
+extern void   AbsEnc_Task(void);
+extern uint8  AbsEnc_Ready(uint16 Jitter);
+extern void   AbsEnc_Report(uint8 Field);
+extern uint16 AbsEnc_Duty(uint16 Dr, uint16 Arr);
+extern int16  AbsEnc_Angle(uint16 Duty);
+extern int16  AbsEnc_OffsetDeg(int16 AngleFlt);
+extern int16  AbsEnc_Theta(uint16 Duty, int16 OffsetDeg);
+extern int16  AbsEnc_Cntr(uint16 Duty, int16 OffsetDeg);
+
+#endif
@@ -0,0 +1,123 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : AutoTune.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 电流环和速度环参数自整定。d轴电压阶跃辨识电阻和电气时间常数，匀速运行中对Iq
+/*                   做继电振荡辨识Kt/J和摩擦电流，按给定带宽计算电流环和速度环PI参数，写入
+/*                   FOC_DQKP/DQKI和PI2，并作为一条参数记录(PARAM_KEY_GAIN)保存。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __AUTOTUNE_H_
+#define __AUTOTUNE_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+/* 电阻电感辨识，DRV_ISR中执行，单位为载波周期 */
+#define TUNE_UD1                        _Q15(0.04)          // 第一段d轴电压
+#define TUNE_UD2                        _Q15(0.12)          // 阶跃后d轴电压
+#define TUNE_STEP_TICKS                 (480)               // 每段时长(20ms)
+#define TUNE_AVG_SHIFT                  (6)                 // 每段末尾取64点平均作为稳态电流
+#define TUNE_AREA_SHIFT                 (8)                 // 阶跃后256点内积分电流与稳态的差，得到时间常数
+#define TUNE_AREA_TICKS                 (1 << TUNE_AREA_SHIFT)
+#define TUNE_DELAY_Q8                   (384)               // 电流采样和电压输出的延时，1.5个载波周期，Q8
+#define TUNE_DI_MIN                     I_Value(0.02)       // 电流阶跃太小时认为相线开路
+#define TUNE_TAU_MAX                    (0x3FFF)            // 时间常数上限，64个载波周期，Q8
+
+/* 转动惯量和摩擦辨识，Speed_response中执行，单位为SysTick周期 */
+#define TUNE_SPIN_LEVEL                 (0x48)              // 匀速运行的速度档位，约60rpm
+#define TUNE_SPIN_CNT                   (131072)            // 匀速运行给定的行程(2圈)，辨识完成后返回起点
+#define TUNE_SETTLE_TICKS               (400)               // 进入匀速段后等待速度环稳定
+#define TUNE_BIAS_SHIFT                 (8)                 // 取256个周期的平均速度和平均Iq
+#define TUNE_BIAS_TICKS                 (1 << TUNE_BIAS_SHIFT)
+#define TUNE_RELAY_IQ                   I_Value(0.05)       // 继电幅值
+#define TUNE_RELAY_HYS                  S_Value(20)         // 继电回差，速度偏离平均速度超过该值后切换
+#define TUNE_RELAY_SKIP                 (2)                 // 前2次切换的半周期不统计
+#define TUNE_RELAY_HALF                 (16)                // 统计16个半周期
+#define TUNE_RELAY_TIMEOUT              (2000)              // 半周期超过1s认为堵转
+#define TUNE_HOLD_ERR                   (80)                // 返回起点后位置误差在此范围内才结束
+#define TUNE_RETURN_TIMEOUT             (10000)             // 返回起点最长等待5s
+
+/* 增益计算 */
+#define TUNE_CUR_BW_UNIT                (20)                // 电流环带宽指令单位(Hz)
+#define TUNE_CUR_BW_MAX                 (2000)              // 电流环带宽上限(Hz)，不超过载波频率的1/12
+#define TUNE_SPD_BW_MAX                 (200)               // 速度环带宽上限(Hz)
+#define TUNE_SPD_ZERO                   (4)                 // 速度环PI零点在带宽的1/4处
+#define TUNE_KP_MAX                     (0x7FFF)
+
+/* 折算成物理量用于应答 */
+#define TUNE_R_DIV                      (uint16)(4096.0 * 32768.0 / (1000.0 * HW_BOARD_VOLTAGE_BASE * I_ValueX(1.0)) + 0.5) // R_q12 * Dcbus / TUNE_R_DIV -> mOhm
+#define TUNE_L_DIV                      (uint16)(256.0 * SAMP_FREQ / 1000.0 + 0.5)  // R(mOhm) * Tau_q8 / TUNE_L_DIV -> uH
+#define TUNE_KJ_GAIN                    (uint16)(SPLAN_FREQ * I_ValueX(1.0) * 2.0 * 3.1416 * MOTOR_SPEED_BASE / 60.0 + 0.5)  // K_q16 * TUNE_KJ_GAIN >> 16 -> (rad/s^2)/A
+
+/* AutoTune.State */
+#define TUNE_IDLE                       (0)
+#define TUNE_RL                         (1)                 // d轴电压阶跃，辨识电阻和时间常数
+#define TUNE_SPIN                       (2)                 // 加速到匀速段并等待稳定
+#define TUNE_BIAS                       (3)                 // 累计平均速度和平均Iq
+#define TUNE_RELAY                      (4)                 // Iq继电振荡
+#define TUNE_RETURN                     (5)                 // 按匀速段档位返回起点并等待到位
+#define TUNE_DONE                       (6)
+#define TUNE_FAIL                       (7)                 // 中途停机、电流阶跃过小、继电振荡或返回起点超时，参数不变
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint16  DqKp;                                           // 正在使用的电流环Kp，Q12
+    uint16  DqKi;                                           // 正在使用的电流环Ki，Q15
+    uint16  SKp;                                            // 正在使用的速度环Kp，Q12
+    uint16  SKi;                                            // 正在使用的速度环Ki，Q15
+    uint8   Busy;                                           // 1: 整定中，不进入到位锁定
+    uint8   Drive;                                          // 1: DRV_ISR中输出d轴电压阶跃
+    uint8   Relay;                                          // 1: Speed_response中输出继电Iq
+    uint8   State;                                          // TUNE_xxx
+    uint8   CurBw;                                          // 电流环带宽，TUNE_CUR_BW_UNIT，0为不改
+    uint8   SpdBw;                                          // 速度环带宽(Hz)，0为不改
+    uint16  Cycle;                                          // DRV_ISR: 阶跃计时
+    int32   SumI1;                                          // DRV_ISR: 第一段末尾Id之和
+    int32   SumArea;                                        // DRV_ISR: 阶跃后TUNE_AREA_TICKS点Id之和
+    int32   SumI2;                                          // DRV_ISR: 第二段末尾Id之和
+    uint16  Ticks;                                          // SysTick周期计数
+    uint16  Cnt;                                            // 平均点数或已统计的半周期数
+    int32   IqSum;
+    int32   SpdSum;
+    int16   Ib;                                             // 匀速段平均Iq(mcIqref)
+    int16   V0;                                             // 匀速段平均速度
+    int8    Dir;                                            // 继电方向，1为Ib+TUNE_RELAY_IQ
+    uint8   Skip;
+    int16   VSw;                                            // 上次切换时的速度
+    int32   DvUp;                                           // 加速半周期速度变化之和
+    int32   DvDn;
+    uint16  TUp;                                            // 加速半周期时长之和
+    uint16  TDn;
+    int32   IqHalf;                                         // 本半周期实测Iq之和，与mcIqref同号
+    int32   IqUp;                                           // 加速半周期实测Iq之和
+    int32   IqDn;
+    int32   Start;                                          // 整定前的目标位置，结束后返回
+    uint8   SavedLevel;
+    uint16  Rq12;                                           // 辨识结果: 电阻，标幺值Q12
+    uint16  TauQ8;                                          // 电气时间常数，载波周期，Q8
+    uint16  Kq16;                                           // Kt/J，每SysTick周期每单位Iq的速度变化，Q16
+    int16   If;                                             // 摩擦电流，与mcIqref同单位
+    uint16  Ka;                                             // 按Kt/J计算的加速度前馈增益，整定成功后写入mcFF.Ka
+} AUTO_TUNE;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern AUTO_TUNE xdata AutoTune;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void AutoTune_Init(void);
+extern void AutoTune_Report(uint8 Field);
+#if (CALIB_TOOL_ENABLE)
+extern void AutoTune_Start(uint8 CurBw, uint8 SpdBw);
+extern void AutoTune_Clear(void);
+extern void AutoTune_Task(void);
+extern void AutoTune_Step(void);
+extern void AutoTune_Relay(void);
+extern void AutoTune_Tick(void);
+#endif
+
+#endif
@@ -3,6 +3,9 @@
 
 #include "FU68xx_4_MCU.h"
 
+/*  CRC单元由USART2_INT(Uart_StreamRx)在收齐二进制帧后整帧计算，主循环若使用CRC单元，
+    计算期间需关UART2中断(ClrBit(UT2_BAUD, UART2IEN))，避免中途被改写初值和数据 */
+
 //extern uint8 TestBuff[];
 /*************************************************************************************///External Function
 //extern unsigned short CRC16_CCITT_FALSE(unsigned char *puchMsg, unsigned int usDataLen);
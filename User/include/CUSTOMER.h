@@ -23,10 +23,19 @@
 
 #define M_Method    (0)
 #define T_Method    (1)
+#define O_Method    (2)         // 位置/速度/负载转矩观测器，以实测Iq为转矩输入
 
 
 #define Speed_Method    M_Method
 
+/*M法下的测速模式，运行中可用VISCA 81 01 06 31 0m FF切换
+  SPEED_MODE_M ：纯M法，窗口内脉冲数量化为1.4rpm一级
+  SPEED_MODE_MT：高速用M法，低速用M/T法(相邻边沿时刻差 + 脉冲数)，爬行时不再量化*/
+#define SPEED_MODE_DEFAULT              (SPEED_MODE_MT)
+
+/*O_Method观测器带宽，三个极点重合在此频率，越高延时越小但编码器量化噪声越大*/
+#define OBS_BW                          (100.0)                                 // (Hz)
+
 /*芯片参数值-------------------------------------------------------------------*/
 /*PWM Parameter*/
 #define PWM_FREQUENCY                  (24.0)                                  // (kHz) 载波频率
@@ -40,6 +49,9 @@
 
 #define MOTOR_SPEED_BASE               (120.0)//(60.0)           //200                     // (RPM) 速度基准
 
+#define MOTOR_KT                       (0.0825)                                 // (N·m/A) 转矩常数，1.5 * 极对数 * 磁链
+#define MOTOR_J                        (5.0e-5)                                 // (kg·m²) 电机加云台负载的转动惯量
+
 /*硬件板子参数设置值------------------------------------------------------------*/
 
 /*电机电流采样相关硬件参数*/
@@ -90,7 +102,7 @@
 #define MOTOR_SPEED_MIN_RPM            (200.0)                                 // (RPM) 运行最小转速
 #define MOTOR_SPEED_MAX_RPM            (2000.0)                                // (RPM) 运行最大转速
 
-#if  (Speed_Method == M_Method)
+#if  (Speed_Method == M_Method) || (Speed_Method == O_Method)
     
     #define DQKP                           _Q12(1.2) //3.25                             // 运行DQ轴KP
     #define DQKI                           _Q15(0.005)//0.02                     // 运行DQ轴KI
@@ -107,7 +119,11 @@
     #define QOUTMIN                        _Q15(-0.95)                              // Q轴最小限幅值，单位：输出占空比
     
     
+    #if  (Speed_Method == O_Method)
+    #define SKP                            _Q12(6.6)                                // 外环KP，观测器速度无量化台阶，可取M法的3倍
+    #else
     #define SKP                            _Q12(2.2)   //1.0                        // 外环KP
+    #endif
     #define SKI                            _Q15(0.001)  //0.02                           // 外环KI
     #define SKD                            _Q15(0.000)
     
@@ -155,10 +171,47 @@
 #define POUTMAX                        S_Value(20.0)                            // (A) 外环最大限幅值
 #define POUTMIN                        S_Value(-20.0)                            // (A) 外环最小限幅值
 
+/*位置曲线规划-----------------------------------------------------------------*/
+#define SPLAN_FREQ                     (2000.0)                                 // (Hz) 规划频率，与SysTick一致(24MHz / SYST_ARR)
+#define SPLAN_ACC                      (400.0)                                  // (RPM/s) 最大加速度
+#define SPLAN_JERK_SHIFT               (5)                                      // 加速度滑动平均长度 2^5 = 32个节拍(16ms)，决定加加速度
+#define SPLAN_JERK_TICKS               (1 << SPLAN_JERK_SHIFT)
+#define SPLAN_ACC_Q16                  (int32)(SPLAN_ACC / 60.0 * PlusePerCircle / SPLAN_FREQ / SPLAN_FREQ * 65536.0)     // 计数/节拍², Q16
+#define SPLAN_SPEED_GAIN               (int32)(MOTOR_SPEED_BASE / 60.0 * PlusePerCircle / SPLAN_FREQ * 2.0 + 0.5)          // S_Value -> 计数/节拍 Q16
+#define SPLAN_S_GAIN                   (int32)(16384.0 / (MOTOR_SPEED_BASE / 60.0 * PlusePerCircle / SPLAN_FREQ * 2.0) + 0.5) // 计数/节拍 Q16 -> S_Value, Q14
+#define SPLAN_SPEED_TO_S(Speed)        (((Speed) * SPLAN_S_GAIN) >> 14)
+
+/*位置环-----------------------------------------------------------------------*/
+#define POS_LOOP_KP                    _Q12(1.0)                                // 位置误差(计数) -> 速度给定(S_Value)，Q12
+#define POS_LOOP_KI                    _Q15(0.0)                                // 每次位置误差更新(SCHED_SLOW_POS_LOOP，3个SysTick周期)积分，Q15
+#define POS_LOOP_KD                    _Q12(0.0)                                // 作用于相邻两次位置误差更新之差，Q12
+#define POS_LOOP_OUT                   (30000)                                  // 速度给定限幅，之后还受mcSpeedRampLim限制
+
+/*前馈-------------------------------------------------------------------------*/
+#define FF_KV_DEFAULT                  _Q12(1.0)                                // 速度前馈增益，Q12
+#define FF_KA_DEFAULT                  (uint16)(MOTOR_J * 2.0 * 3.1416 * SPLAN_FREQ * SPLAN_FREQ / PlusePerCircle / MOTOR_KT * I_ValueX(1.0) * 32768.0 + 0.5)   // 加速度->Iq前馈增益，Q16
+
+/*速度环增益调度---------------------------------------------------------------*/
+#define GS_ENABLE                      (1)                                      // 1: 按|speedRef|和|PosErr|调度PI2增益，0: 固定使用AutoTune.SKp/SKi
+#define GS_POINTS                      (4)                                      // 每张调度表的折点数，调度表见AddFunction.c
+#define GS_SLEW_SHIFT                  (3)                                      // 实际增益每节拍向目标值靠近1/8，约4ms
+#define GS_GAIN(Mul)                   (uint16)((Mul) * 256.0 + 0.5)            // 增益倍数，Q8
+
+/*弱磁-------------------------------------------------------------------------*/
+#define FW_ENABLE                      (1)                                      // 1: |FOC__UQ|接近限幅时注入负Id，0: FOC_IDREF保持ID_Start_CURRENT
+#define FW_POINTS                      (4)                                      // Id前馈表折点数，前馈表见AddFunction.c
+#define FW_UQ_LIM                      _Q15(0.85)                               // 电压裕量调节器的Uq目标，低于QOUTMAX给电流环留出调节余量
+#define FW_KI_SHIFT                    (7)                                      // 每节拍Id变化 = (FW_UQ_LIM - |FOC__UQ|) >> FW_KI_SHIFT
+#define FW_ID_MIN                      I_Value(-0.4)                            // (A) 前馈加调节器的Id下限，与SOUTMAX相当
+#define FW_ID_ACC_MIN                  ((int32)FW_ID_MIN * (1L << FW_KI_SHIFT)) // mcFW.IdAcc下限，负数不左移
+
 
 /*NONEMODE   UARTMODE*/
 #define REF_MODE                       (UARTMODE)
 
+/*UART2波特率，9600为原VISCA控制器的速率；摇杆连续给定(二进制帧A5，见UART.h)建议115200或250000*/
+#define UART2_BAUD_RATE                (9600)                                   // (bps)
+
 
 /*模式选择设置值----------------------------------------------------------------*/
 #define IPMState                       (NormalRun)
@@ -186,7 +239,11 @@
 
 
 
-#define STARTPAGEROMADDRESS 0x3E00
+/* Flash数据区: 0x3800齿槽补偿表，0x3C00参数记录区，0x3E00升级前的零位页，都在工程设定的代码区0~0x37FF之外 */
+#define STARTPAGEROMADDRESS 0x3E00      // 升级前的零位页，参数记录区中没有时读取
+#define PARAMROMADDRESS     0x3C00      // 参数记录区，PARAM_SECTOR_NUM个扇区循环写入，见ParamStore.h
+#define PARAM_SECTOR_NUM    (4)
+#define COGROMADDRESS       0x3800      // 齿槽补偿表，COG_BIN_NUM字节占8个扇区，工程的代码区只到0x37FF，程序超过时链接报错
 //#define LEARNPAGEROMADDRESS 0x3E00 
 //#define PosErrSET    (8)
 
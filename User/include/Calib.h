@@ -0,0 +1,69 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : Calib.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 校准块。零位角、用户零位和前馈增益合成一个带标志、版本、长度和CRC的结构，
+/*                   上电一次读出，保存时整块写入参数记录区(PARAM_KEY_CALIB)。
+/*                   Flash中按高字节在前排列: 标志 版本 长度 状态位 零位角(2) 用户零位(4) Kv(2) Ka(2) CRC(2)
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __CALIB_H_
+#define __CALIB_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define CALIB_MAGIC                     (0xCA)
+#define CALIB_VERSION                   (1)                 // 结构改变时加1，并在Calib_Unpack中加入旧版本的迁移
+#define CALIB_LEN                       (16)                // Flash中的字节数，含CRC
+
+/* CALIB_BLOCK.Flags */
+#define CALIB_F_ANGLE                   (0x01)              // 零位角经过自学习或串口写入，为0时上电重新学习
+
+/* Calib.Status */
+#define CALIB_OK                        (0)                 // 校准块有效
+#define CALIB_MIGRATED                  (1)                 // 由升级前的参数或零位页转换而来，已重新保存
+#define CALIB_EMPTY                     (2)                 // 没有任何校准数据，使用默认值
+#define CALIB_CORRUPT                   (3)                 // 校准块标志、版本、长度或CRC不对，使用默认值
+
+/* 串口读写的字段编号 */
+#define CALIB_FIELD_ANGLE               (0)                 // 零位角 mcQEP.AngleFlt
+#define CALIB_FIELD_ZERO                (1)                 // 用户零位 mcQEP.ZeroNewCntr
+#define CALIB_FIELD_KV                  (2)                 // 速度前馈增益 mcFF.Kv
+#define CALIB_FIELD_KA                  (3)                 // 加速度前馈增益 mcFF.Ka
+#define CALIB_FIELD_STATUS              (4)                 // 只读: 版本 状态位 Status
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint8   Magic;                                          // CALIB_MAGIC
+    uint8   Version;                                        // CALIB_VERSION
+    uint8   Len;                                            // CALIB_LEN
+    uint8   Flags;                                          // CALIB_F_xxx
+    int16   AngleFlt;                                       // PWM编码器零位角，Q15
+    int32   ZeroNewCntr;                                    // 用户零位，相对Z信号的计数
+    uint16  FFKv;                                           // 速度前馈增益，Q12
+    uint16  FFKa;                                           // 加速度前馈增益，Q16
+    uint16  Crc;                                            // 前面各字节的CRC16-CCITT-FALSE
+} CALIB_BLOCK;
+
+typedef struct
+{
+    CALIB_BLOCK Blk;                                        // 当前校准值
+    uint8       Status;                                     // 上电读取结果 CALIB_xxx
+    uint8       Relearn;                                    // 上电时零位角无效，本次上电每次启动都像GP42为0一样预定位学习
+} CALIB;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern CALIB xdata Calib;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void Calib_Load(void);
+extern void Calib_Save(void);
+extern void Calib_Report(uint8 Field);
+extern void Calib_Set(uint8 Field, int32 Value);
+
+#endif
@@ -0,0 +1,94 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : CogComp.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 齿槽转矩补偿。按相对Z信号的机械位置把一圈分为COG_BIN_NUM格，逐格定位保持，
+/*                   以速度环稳态输出作为该位置的保持电流，存入COGROMADDRESS处的Flash表；
+/*                   DRV_ISR中按mcQEP.MechCntr查表插值叠加到FOC_IQREF。表的格数、均值和CRC
+/*                   作为一条参数记录(PARAM_KEY_COG)保存，上电校验不过则不补偿。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __COGCOMP_H_
+#define __COGCOMP_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define COG_BIN_SHIFT                   (6)                 // 一圈65536个计数分为1024格，每格64个计数
+#define COG_BIN_NUM                     (1024)
+#define COG_BIN_MASK                    ((1 << COG_BIN_SHIFT) - 1)
+#define COG_SECTOR_NUM                  (COG_BIN_NUM / PARAM_SECTOR_SIZE)
+#define COG_IQ_SHIFT                    (4)                 // 表中每个字节为FOC_IQREF右移4位，int8，满量程约为SOUTMAX的1/3
+#define COG_LEARN_LEVEL                 (0x10)              // 逐格定位的速度档位
+#define COG_LEARN_KI                    _Q15(0.1)           // 学习时加大速度环积分，保持点落在齿槽转矩负刚度区时也能到位
+#define COG_SETTLE_TICKS                (200)               // 到位后等待位置误差消除的SysTick周期数(100ms)
+#define COG_MOVE_TIMEOUT                (2000)              // 逐格定位最长等待1s，超时学习失败
+#define COG_RIPPLE_TIMEOUT              (20000)             // 速度波动测试每段最长10s
+#define COG_AVG_SHIFT                   (5)                 // 保持电流取32个SysTick周期的平均
+#define COG_AVG_TICKS                   (1 << COG_AVG_SHIFT)
+#define COG_RIPPLE_LEVEL                (0x04)              // 测速度波动的速度档位，约3.7rpm
+#define COG_RIPPLE_CNT                  (16384)             // 测速度波动的行程(1/4圈)
+#define COG_RIPPLE_MAX                  (4096)              // 速度误差最多统计的点数，平方和不溢出
+#define COG_RIPPLE_ERR                  (1000)              // 速度误差限幅
+
+/* Flash表第Idx格的值 */
+#define COG_TAB(Idx)                    ((int8)*(uint8 code *)(COGROMADDRESS + (Idx)))
+
+/* CogComp.State */
+#define COG_IDLE                        (0)
+#define COG_ERASE                       (1)                 // 擦除Flash表，每次主循环一个扇区
+#define COG_MOVE                        (2)                 // 定位到下一格并等待稳定
+#define COG_SAMPLE                      (3)                 // 累计保持电流
+#define COG_RIPPLE                      (4)                 // 补偿前后各走一段，统计速度误差
+#define COG_DONE                        (5)
+#define COG_FAIL                        (6)                 // 中途停机、定位超时或Flash校验失败，学习中失败时补偿表无效
+#define COG_CRC                         (7)                 // 表写完后计算CRC，每次主循环一个扇区
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint8   Valid;                                          // 1: Flash表与参数记录一致
+    uint8   On;                                             // 1: DRV_ISR中叠加补偿，上电找到Z之后才打开
+    uint8   Busy;                                           // 1: 学习或测速度波动中，不进入到位锁定
+    int16   Iq;                                             // DRV_ISR: 当前位置的补偿电流
+    int16   IqBase;                                         // 速度环输出，DRV_ISR在它上面叠加Iq
+    int16   Mean;                                           // 表的平均值，学习时摩擦力带来的直流分量
+    uint8   State;                                          // COG_xxx
+    uint8   Sector;                                         // 正在擦除或计算CRC的扇区
+    uint16  Crc;                                            // 已计算扇区的CRC
+    uint16  Cnt;                                            // 已学习格数
+    uint16  First;                                          // 第一个学习的格
+    int32   Base;                                           // 本圈机械位置0处的CntrSumReal
+    int32   Goal;                                           // 当前定位目标
+    uint8   Ticks;                                          // SysTick周期计数，到255不再增加
+    uint16  Wait;                                           // 本次定位以来的SysTick周期数，到0xFFFF不再增加
+    uint8   Sample;                                         // 1: Speed_response中累计保持电流
+    int32   IqSum;
+    uint8   IqCnt;
+    int32   TabSum;                                         // 已写入表的字节之和
+    uint8   RipPhase;                                       // 0: 不补偿正转 1: 返回 2: 补偿后正转
+    int32   RipSum;
+    uint32  RipSq;
+    uint16  RipCnt;
+    uint16  Before;                                         // 补偿前速度误差均方根，S_Value
+    uint16  After;                                          // 补偿后速度误差均方根
+    uint8   SavedLevel;                                     // 学习前的速度档位，结束后恢复
+} COG_COMP;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern COG_COMP xdata CogComp;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void CogComp_Init(void);
+extern void CogComp_Task(void);
+extern void CogComp_Report(void);
+#if (CALIB_TOOL_ENABLE)
+extern void CogComp_Start(uint8 Mode);
+extern void CogComp_Clear(void);
+extern void CogComp_Tick(void);
+#endif
+
+#endif
@@ -0,0 +1,45 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : CtrlLib.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 定点控制算法。PID的Kp、Kd为Q12，Ki为Q15，乘法用MDU，积分按输出限幅并在输出饱和时
+/*                   停止向饱和方向积分；VISCA速度档位与S_Value之间的换算查表。全部为整数运算，
+/*                   可在中断中调用，HostSim中MDU按位模拟，结果与芯片一致。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __CTRLLIB_H_
+#define __CTRLLIB_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+/* 速度档位，81 01 06 01 vv ww 03 03 FF中的vv，每档SPEED_LEVEL_K rpm */
+#define SPEED_LEVEL_MAX                 (0x90)
+#define SPEED_LEVEL_K                   (0.83)              // rpm/档
+#define SPEED_LEVEL_B                   (0.333)             // 0档转速(rpm)
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    int16   Kp;                                             // 比例增益，Q12
+    int16   Ki;                                             // 积分增益，Q15，每次调用积分增加Ki * Err
+    int16   Kd;                                             // 微分增益，Q12，作用于相邻两次调用的误差之差
+    int16   OutMax;                                         // 输出上限，同时是积分上限
+    int16   OutMin;                                         // 输出下限，同时是积分下限
+    int16   ErrLast;                                        // 上一次的误差
+    int32   Integral;                                       // 积分，Q15
+    int16   Out;                                            // 上一次的输出
+} CTRL_PID;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern int16 Ctrl_Sat16(int32 Value);
+extern void  Ctrl_PidInit(CTRL_PID xdata *Pid, int16 Kp, int16 Ki, int16 Kd, int16 OutMin, int16 OutMax);
+extern void  Ctrl_PidReset(CTRL_PID xdata *Pid);
+extern int16 Ctrl_Pid(CTRL_PID xdata *Pid, int16 Err);
+extern int16 Ctrl_LevelToSpeed(uint8 Level);
+extern uint8 Ctrl_SpeedToLevel(int16 Speed);
+
+#endif
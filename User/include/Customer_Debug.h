@@ -46,6 +46,37 @@
 
 #define DBG_MODE             (SPI_DBG_SW)
 
+/*UART1遥测(DBG_MODE为UART_DBG)-----------------------------------------------*/
+ /*
+ * 1.DMA1改为XDATA->UART1，不能再用作SPI调试，帧格式见Telemetry.h。
+ * 2.每帧18字节，TELEM_DIV为2(1kHz)时需要200000bps以上。
+ */
+#define TELEM_BAUD_RATE      (250000)
+#define TELEM_DIV            (2)                 // 每2个SysTick周期(1ms)发送一帧
+
+/*中断耗时统计--------------------------------------------------------------*/
+ /*
+ * 1.使能后TIM4固定为24MHz自由计数，不能再用作其他功能。
+ * 2.统计DRV_ISR、SYStick_INT、USART2_INT及其中检查点的耗时，编号见Profile.h。
+ * 3.读取：81 09 06 20 0p FF(最小/平均/最大/样本数)，81 09 06 21 0p 0h FF(直方图)；清零：81 01 06 20 FF。
+ */
+#define PROFILE_ENABLE       (0)                 // 调试时置1，量产关闭
+
+/*片上示波器--------------------------------------------------------------*/
+ /*
+ * 1.使能后DRV_ISR按配置记录最多8路信号到xdata缓冲区(SCOPE_BUF_WORDS字)，信号编号和指令见Scope.h/Scope.c。
+ * 2.冻结后通过81 09 06 2C逐条读出；DBG_MODE为SPI_DBG_SW时可用81 01 06 2D 03/04 FF把缓冲区
+ *   循环写入spidebug，由DMA1输出到SPI_Monitor，此时spidebug原来的内容不再输出。
+ */
+#define SCOPE_ENABLE         (0)                 // 调试时置1，量产关闭
+
+/*出厂标定工具--------------------------------------------------------------*/
+ /*
+ * 1.使能后编译编码器偏心标定、齿槽补偿表学习和电流环/速度环自整定，即81 01 06 27/28/29三条指令。
+ * 2.关闭时上电仍读取并使用参数记录区和齿槽补偿表中已保存的结果，81 09 06 27/28/29仍可查询。
+ */
+#define CALIB_TOOL_ENABLE    (0)                 // 出厂标定时置1，量产关闭
+
  //软件DBG的参数
  #define SOFT_SPIDATA0                  FOC__IA//FOC__EOME//FOC__UDCFLT//FOC__EOME//UAC//UDC_REF//UAC//UAC_AVG//FOC__IA//UAC// IAC_UK//UAC// FOC__IBET//FOC__VBET///UDC_UK//
  #define SOFT_SPIDATA1                  FOC__VALP//AdcSampleValue.ADCDcbus//FOC__EOMELPF//IAC_REF//UDC_UK//IAC_REF//FOC__THETA//UAC//mcFocCtrl.mcDcbusFlt//FOC__UDCFLT//UAC//
@@ -0,0 +1,77 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : EncComp.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 编码器偏心补偿。d轴电压按固定电角度步长拖动转子慢速转一圈，每1/64圈比较编码器计数
+/*                   与拖动角度，拟合出1倍、2倍机械频率的计数误差，在DRV_ISR中按查表插值从计数中减去。
+/*                   拟合系数保存在参数记录区(PARAM_KEY_ENC)，反向再转一圈验证补偿后的残差。
+/*                   查表按相对Z信号的机械位置mcQEP.MechCntr，上电后要等找到Z才生效。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __ENCCOMP_H_
+#define __ENCCOMP_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define ENC_BIN_SHIFT                   (10)                // 一圈65536个计数分为64格，每格1024个计数
+#define ENC_BIN_NUM                     (64)
+#define ENC_BIN_MASK                    ((1 << ENC_BIN_SHIFT) - 1)
+#define ENC_COEF_NUM                    (4)                 // 1倍余弦、正弦，2倍余弦、正弦
+#define ENC_COEF_MAX                    (8191)              // 系数限幅(计数Q2)，查表累加不溢出
+#define ENC_SWEEP_STEP                  (16)                // 拖动时每个载波周期的电角度增量，一圈约1.9s
+#define ENC_RAMP_TICKS                  (8)                 // 步长每8个SysTick周期(4ms)变化1，起转和换向时不激起转子振荡
+#define ENC_SETTLE_CNT                  (16384)             // 步长到达目标后等待振荡衰减的计数(1/4圈)
+
+/* EncComp.State */
+#define ENC_IDLE                        (0)                 // 没有补偿表
+#define ENC_WARMUP                      (1)                 // 正转起步
+#define ENC_MEASURE                     (2)                 // 正转一圈记录误差
+#define ENC_TURN                        (3)                 // 换向
+#define ENC_VERIFY                      (4)                 // 反转一圈记录补偿后的残差
+#define ENC_DONE                        (5)                 // 补偿表有效
+#define ENC_FAIL                        (6)                 // 标定中止或残差没有减小，沿用原补偿表
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    int16   Coef[ENC_COEF_NUM];                             // 计数误差的谐波系数，计数Q2
+    int16   Lut[ENC_BIN_NUM + 1];                           // 各格起点的计数误差，最后一项同第0项
+    uint8   Valid;                                          // 1: 补偿表不全为0
+    uint8   On;                                             // 1: DRV_ISR中从计数减去误差，上电找到Z之后才打开
+    int16   Delta;                                          // DRV_ISR: 当前计数的误差
+    uint8   Sweep;                                          // DRV_ISR: 1为d轴电压拖动中
+    int8    Step;                                           // DRV_ISR: 拖动电角度步长
+    int8    Target;                                         // 步长目标，Step在SYStick中向它逐步变化
+    uint8   RampCnt;
+    int32   ThetaSum;                                       // DRV_ISR: 拖动电角度累计
+    uint8   State;                                          // ENC_xxx
+    uint8   Bin;                                            // 上次所在格
+    uint8   Cnt;                                            // 本圈已记录格数
+    uint8   First;                                          // 本圈第一个边沿所在格
+    int32   Start;                                          // 本阶段起点计数
+    int32   PosRef;                                         // 本圈第一个格边沿的计数
+    int32   ThetaRef;                                       // 本圈第一个格边沿的拖动电角度
+    int16   Err[ENC_BIN_NUM];                               // 各格起点的计数误差，计数Q2
+    int16   Old[ENC_COEF_NUM];                              // 标定前的系数，失败时恢复
+    uint16  Before[2];                                      // 补偿前1倍、2倍误差幅值，计数Q2
+    uint16  After[2];                                       // 补偿后残差幅值
+} ENC_COMP;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern ENC_COMP xdata EncComp;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void EncComp_Init(void);
+extern void EncComp_Task(void);
+extern void EncComp_Report(void);
+#if (CALIB_TOOL_ENABLE)
+extern void EncComp_Start(void);
+extern void EncComp_Clear(void);
+extern void EncComp_Ramp(void);
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : HoldCtrl.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 到位后电流闭环(Iq)与d轴电压锁定之间的切换。进入时冻结电角度，d轴电压从电流环
+/*                   当前输出斜坡到UD_Align_Duty_Max，q轴电流给定保持切换时的值；退出时速度环积分
+/*                   预置为保持电流。锁定1s后进入低功耗: d轴电压降到零，q轴电流递减到刚好能保持的值，
+/*                   摩擦和齿槽转矩足以保持时关闭三相输出。每次切换后记录位置跟踪误差、实测Iq和Iq给定的最大变化。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __HOLDCTRL_H_
+#define __HOLDCTRL_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+/* 以下单位均为SysTick周期 */
+#define HOLD_DELAY                      (5000)              // 上电后至少运行2.5s才允许锁定
+#define HOLD_ENTER_ERR                  (16)                // 位置误差持续在此范围内才进入锁定
+#define HOLD_SETTLE_TICKS               (200)               // 误差持续在范围内100ms后进入
+#define HOLD_CREEP_ERR                  (1)                 // 且这段时间内位置变化不超过1个计数，静摩擦下积分仍在增加、转子蠕动时不进入
+#define HOLD_SLIP_ERR                   (4)                 // 锁定中位置相对进入时变化超过此值(转子蠕动或被外力推动)，回到电流闭环
+#define HOLD_RAMP_TICKS                 (40)                // d轴电压斜坡时间20ms
+#define HOLD_UD_STEP                    ((UD_Align_Duty_Max + HOLD_RAMP_TICKS - 1) / HOLD_RAMP_TICKS)
+#define HOLD_PROBE_TICKS                (20)                // 切换后统计跳变的时间10ms
+#define HOLD_IDLE_DELAY                 (2000)              // 锁定1s后进入低功耗
+#define HOLD_IQ_STEP                    (2)                 // 低功耗时q轴电流给定每节拍向零递减，约0.3A/s
+#define HOLD_IQ_MARGIN                  I_Value(0.02)       // 低功耗中转子蠕动时向阻止蠕动的方向加的电流，之后不再递减
+
+/* HoldCtrl.Mode */
+#define HOLD_IQ                         (0)                 // 电流闭环，速度环输出Iq
+#define HOLD_RAMP                       (1)                 // 电角度已冻结，d轴电压斜坡上升
+#define HOLD_LOCK                       (2)                 // d轴电压锁定
+#define HOLD_IDLE                       (3)                 // 低功耗，d轴电压降到零，q轴电流递减到最小保持电流
+#define HOLD_OFF                        (4)                 // 不需要保持电流，三相输出关闭
+
+/* HoldCtrl.Jump下标 */
+#define HOLD_JUMP_IN                    (0)                 // Iq -> 锁定
+#define HOLD_JUMP_OUT                   (1)                 // 锁定 -> Iq
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint16  Num;                                            // 切换次数
+    uint16  Pos;                                            // 最近一次切换后位置跟踪误差的最大变化(计数)
+    uint16  Iq;                                             // 最近一次切换后实测FOC__IQ的最大变化
+    uint16  Ref;                                            // 最近一次切换后FOC_IQREF每节拍的最大变化
+    uint16  PosMax;                                         // 历次切换中的最大值
+    uint16  IqMax;
+    uint16  RefMax;
+} HOLD_JUMP;
+
+typedef struct
+{
+    uint8   Mode;                                           // HOLD_xxx
+    uint8   Trim;                                           // 1: 低功耗中q轴电流仍在递减
+    uint8   ExitReq;                                        // 主循环或USART2_INT置1，下一次HoldCtrl_Tick退出锁定
+    uint16  Cnt;                                            // 误差在范围内或锁定的节拍数
+    int32   ErrRef;                                         // 开始计数时的位置误差
+    int32   Pos;                                            // 进入锁定或低功耗时的编码器位置，滑动和蠕动的参考
+    int16   Theta;                                          // 锁定电角度
+    int16   Ud;                                             // 锁定d轴电压
+    int16   Iq;                                             // 锁定q轴电流给定，取切换时的FOC_IQREF，低功耗中递减
+    uint8   Probe;                                          // 0: 不统计，否则为正在统计的HOLD_JUMP_xxx + 1
+    uint8   ProbeTicks;
+    int32   Err0;                                           // 切换时的位置误差
+    int16   Iq0;                                            // 切换时的实测Iq
+    int16   IqRefOld;                                       // 上一节拍的FOC_IQREF
+    HOLD_JUMP Jump[2];
+} HOLD_CTRL;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern HOLD_CTRL xdata HoldCtrl;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void HoldCtrl_Init(void);
+extern uint8 HoldCtrl_Release(void);
+extern void HoldCtrl_Tick(void);
+extern void HoldCtrl_Report(uint8 Field);
+
+#endif
@@ -37,6 +37,7 @@
 #include "I2C.h"
 #include "FLASH.h"
 
+#include "CtrlLib.h"
 #include "AddFunction.h"
 
 #include "MotorControlFunction.h"
@@ -44,5 +45,16 @@
 #include "PosCheck.h"
 
 #include "QEP.h"
+#include "Profile.h"
+#include "Sched.h"
+#include "ParamStore.h"
+#include "Calib.h"
+#include "EncComp.h"
+#include "CogComp.h"
+#include "AutoTune.h"
+#include "HoldCtrl.h"
+#include "Scope.h"
+#include "Telemetry.h"
+#include "AbsEnc.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : ParamStore.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 参数记录区。PARAM_SECTOR_NUM个扇区循环使用，每次保存在当前扇区末尾追加一条
+/*                   带版本号和CRC的记录，扇区写满后擦除下一个扇区并把全部参数的最新值搬过去。
+/*                   保存只改RAM副本，Param_Task在主循环每次执行时最多烧写一个字节，不长时间关中断。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __PARAMSTORE_H_
+#define __PARAMSTORE_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define PARAM_SECTOR_SIZE               (128)               // Flash扇区字节数，擦除后为0x00
+#define PARAM_SECTOR_MARK               (0x7F)              // 扇区头: 7F 序号高 序号低 校验
+#define PARAM_HEAD_LEN                  (4)
+#define PARAM_REC_FLAG                  (0x80)              // 记录: (80|编号) 长度 版本 数据... CRC高 CRC低
+#define PARAM_REC_EXTRA                 (5)                 // 记录中数据以外的字节数
+#define PARAM_DATA_MAX                  (16)                // 单条记录数据最大字节数
+
+/* 参数编号，长度见ParamStore.c中的ParamLen */
+#define PARAM_KEY_ANGLE                 (0)                 // 旧版零位角，int16，只在迁移到校准块时读取
+#define PARAM_KEY_ZERO                  (1)                 // 旧版用户零位，int32，同上
+#define PARAM_KEY_FF                    (2)                 // 旧版前馈增益，uint16 x 2，同上
+#define PARAM_KEY_CALIB                 (3)                 // 校准块，格式见Calib.h
+#define PARAM_KEY_ENC                   (4)                 // 编码器偏心补偿系数，int16 x 4，见EncComp.h
+#define PARAM_KEY_COG                   (5)                 // 齿槽补偿表的格数、均值和CRC，uint16 x 3，见CogComp.h
+#define PARAM_KEY_GAIN                  (6)                 // 电流环和速度环参数，uint16 x 4，见AutoTune.h
+#define PARAM_KEY_NUM                   (7)
+
+/* Param_Task状态 */
+#define PARAM_IDLE                      (0)
+#define PARAM_ERASE                     (1)                 // 擦除下一个扇区
+#define PARAM_PROGRAM                   (2)                 // 逐字节烧写Rec
+#define PARAM_COMPACT                   (3)                 // 扇区头写完，全部参数重新追加
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint8   Data[PARAM_KEY_NUM][PARAM_DATA_MAX];            // 各参数最新值
+    uint8   Ver[PARAM_KEY_NUM];                             // 各参数最新记录的版本号，每次保存加1
+    uint8   Valid;                                          // 第k位为1表示参数k有值
+    uint8   Dirty;                                          // 第k位为1表示参数k待写入Flash
+    uint8   Bad;                                            // 第k位为1表示上电扫描到参数k的CRC错误记录
+    uint8   State;                                          // PARAM_xxx
+    uint8   Sector;                                         // 当前写入扇区 0 ~ PARAM_SECTOR_NUM-1
+    uint8   Offset;                                         // 当前扇区下一条记录的偏移
+    uint16  Seq;                                            // 当前扇区序号，每换一个扇区加1
+    uint8   Rec[PARAM_DATA_MAX + PARAM_REC_EXTRA];          // 正在烧写的记录或扇区头
+    uint8   RecLen;
+    uint8   RecPos;                                         // 下一个要烧写的字节
+    uint8   RecKey;                                         // 正在烧写的参数编号，扇区头为0xFF
+    uint16  Err;                                            // 烧写校验失败次数
+} PARAM_STORE;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern PARAM_STORE xdata Param;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void   Param_Init(void);
+extern void   Param_Task(void);
+extern uint8  Param_Read(uint8 Key, uint8 *Buf);
+extern void   Param_Write(uint8 Key, uint8 *Buf);
+extern void   Param_Drop(uint8 Key);
+extern uint16 Param_Crc(uint8 *Buf, uint16 Len);
+extern void   Param_Report(void);
+
+#endif
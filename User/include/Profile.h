@@ -0,0 +1,99 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : Profile.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 中断耗时统计。TIM4以24MHz自由计数，在中断入口/出口和检查点取计数值，
+/*                   每个统计项保存最小/平均/最大值和对数分布直方图，通过VISCA查询读出。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __PROFILE_H_
+#define __PROFILE_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define PROF_TICK_FREQ                  (24000000.0)        // TIM4计数频率，1个计数 = 41.7ns
+#define PROF_HIST_NUM                   (8)                 // 直方图格数
+#define PROF_HIST_SHIFT                 (6)                 // 第0格 < 64个计数(2.7us)，之后每格上限翻倍，最后一格 >= 4096(171us)
+
+/* 统计项编号，与VISCA查询中的编号一致 */
+#define PROF_DRV_ISR                    (0)                 // DRV_ISR入口到出口
+#define PROF_SYST_INT                   (1)                 // SYStick_INT入口到出口
+#define PROF_UART_INT                   (2)                 // USART2_INT入口到出口
+#define PROF_QEP                        (3)                 // DRV_ISR: QEP计数解码与电角度
+#define PROF_SPEED_M                    (4)                 // DRV_ISR: M法测速
+#define PROF_UQ_LOCK                    (5)                 // DRV_ISR: UQ强拖/锁轴
+#define PROF_SPEED_RESPONSE             (6)                 // SYStick_INT: Speed_response
+#define PROF_FAULT_DETECTION            (7)                 // SYStick_INT: Fault_Detection
+#define PROF_UART_DISPATCH              (8)                 // 主循环: VISCA指令查表和处理，含被中断抢占的时间
+#define PROF_SCOPE                      (9)                 // DRV_ISR: 片上示波器记录一条
+#define PROF_NUM                        (10)
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint16  Min;                                            // 最小耗时(TIM4计数)
+    uint16  Max;                                            // 最大耗时
+    uint16  Last;                                           // 最近一次耗时
+    uint16  Cnt;                                            // 样本数
+    uint32  Sum;                                            // 耗时累加，Sum / Cnt为平均值
+    uint16  Hist[PROF_HIST_NUM];                            // 耗时分布
+} PROFILE;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern PROFILE xdata Prof[PROF_NUM];
+
+/* Exported macros ------------------------------------------------------------------------------*/
+/*  PROFILE_START在入口或检查点记下TIM4计数值，PROFILE_STOP计算差值并累计到统计项。
+    统计在DRV_ISR(优先级2)和SYStick_INT/USART2_INT(优先级0)中都会执行，为免共用函数的
+    数据段被抢占破坏，展开为宏；Cnt满时全部统计量减半，保持平均值和分布比例。
+    耗时包含被更高优先级中断抢占的时间，DRV_ISR不会被这三个中断抢占。 */
+#if (PROFILE_ENABLE)
+#define PROFILE_START(Start)            (Start) = TIM4__CNTR
+#define PROFILE_STOP(Id, Start)         do                                                  \
+                                        {                                                   \
+                                            uint16 _Ticks = TIM4__CNTR - (Start);           \
+                                            uint16 _Bin   = _Ticks >> PROF_HIST_SHIFT;      \
+                                            uint8  _i     = 0;                              \
+                                            while ((_Bin != 0) && (_i < PROF_HIST_NUM - 1)) \
+                                            {                                               \
+                                                _Bin >>= 1;                                 \
+                                                _i++;                                       \
+                                            }                                               \
+                                            if (Prof[Id].Cnt == 0xFFFF)                     \
+                                            {                                               \
+                                                Prof[Id].Cnt >>= 1;                         \
+                                                Prof[Id].Sum >>= 1;                         \
+                                                for (_Bin = 0; _Bin < PROF_HIST_NUM; _Bin++)\
+                                                {                                           \
+                                                    Prof[Id].Hist[_Bin] >>= 1;              \
+                                                }                                           \
+                                            }                                               \
+                                            Prof[Id].Hist[_i]++;                            \
+                                            Prof[Id].Cnt++;                                 \
+                                            Prof[Id].Sum += _Ticks;                         \
+                                            Prof[Id].Last = _Ticks;                         \
+                                            if (_Ticks < Prof[Id].Min)                      \
+                                            {                                               \
+                                                Prof[Id].Min = _Ticks;                      \
+                                            }                                               \
+                                            if (_Ticks > Prof[Id].Max)                      \
+                                            {                                               \
+                                                Prof[Id].Max = _Ticks;                      \
+                                            }                                               \
+                                        } while (0)
+#else
+#define PROFILE_START(Start)
+#define PROFILE_STOP(Id, Start)
+#endif
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void Profile_Init(void);
+extern void Profile_Reset(void);
+extern void Profile_Report(uint8 Id);
+extern void Profile_ReportHist(uint8 Id, uint8 Half);
+
+#endif
@@ -23,19 +23,38 @@
 #define ANGLE_PER_PLASE                         (float)(65536.0/PlusePerCircle)
 #define ETHETA_PER_PLASE                        (float)(65536.0/PlusePerCircle*Pole_Pairs)
 
+/* M/T法测速 */
+#define SPEED_MODE_M                            (0)                             // 纯M法
+#define SPEED_MODE_MT                           (1)                             // M法 + 低速M/T法
+#define SPEED_MT_BASE                           (uint16)(32767.0*60.0*SAMP_FREQ/(PlusePerCircle*MOTOR_SPEED_BASE)+0.5)  // 每载波1个脉冲对应的速度值
+#define SPEED_MT_CNT_MAX                        (32)                            // M法窗口(32载波)内脉冲数达到此值(约22rpm)时直接用M法
+#define SPEED_MT_SPAN_MIN                       (32)                            // M/T法最短测量区间(载波数)，与M法窗口相同
+#define SPEED_MT_IDLE_MAX                       (4096)                          // 超过此载波数(171ms)没有边沿认为静止
+#define SPEED_M_LATENCY                         (16)                            // M法等效延时，窗口的一半(载波数)
+
+/* O_Method观测器，每8个载波运行一次。位置误差Q8计数，速度Q16计数/周期，负载转矩Q8(Iq单位) */
+#define OBS_FREQ                                (SAMP_FREQ / 8.0)
+#define OBS_A                                   (2.0 * 3.1416 * OBS_BW / OBS_FREQ)
+#define OBS_B_F                                 (MOTOR_KT / MOTOR_J / (OBS_FREQ * OBS_FREQ) * PlusePerCircle / (2.0 * 3.1416) * 65536.0 / _Q15(I_ValueX(1.0)))
+#define OBS_B                                   (int16)(OBS_B_F * 256.0 + 0.5)  // Iq -> 速度增量，Q8
+#define OBS_L1                                  (int16)(3.0 * OBS_A * 256.0 + 0.5)                  // 位置校正，Q8
+#define OBS_L2                                  (int16)(3.0 * OBS_A * OBS_A * 4096.0 + 0.5)         // 速度校正，Q12
+#define OBS_L3                                  (int16)(OBS_A * OBS_A * OBS_A * 65536.0 / OBS_B_F + 0.5)  // 负载转矩校正
+#define OBS_SPEED_TO_S(Speed)                   ((((Speed) >> 4) * 375) >> 11)  // Q16计数/周期 -> 速度值
+#define OBS_LATENCY                             (uint16)(SAMP_FREQ / (2.0 * 3.1416 * OBS_BW) + 4.5) // 等效延时，OBS_BW对应的时间常数加半个观测周期(载波数)
+
 /* Exported types ------------------------------------------------------------*/
 typedef struct
 {
     uint16  Cntr;                                   //  Timer2 计数值
     uint16  CntrOld;                                //  上一个载波 Timer2 计数值
+    uint16  MechCntr;                               //  相对Z信号的机械位置，一圈65536，找到Z之前无意义
 	
     uint16  CntrM;                                //  上一个载波 Timer2 计数值
    	uint16  CntrOldM;                                //  上一个载波 Timer2 计数值
 
     int16   CntrErr;                                //  两个载波之间 CNTR的差值
 
-    uint8   M_CNT;                                //  两个载波之间 CNTR的差值
-
     int16   Cycle;                                  //  
     int32   CntrSum;                                //  累计脉冲数量（加上偏置角）
     int32   CntrSumOld;                                //  累计脉冲数量（加上偏置角）
@@ -92,10 +111,29 @@ typedef struct
 			
 			uint16 timecnt;
 
+        uint8  SpeedMode;                           //  测速模式 SPEED_MODE_M / SPEED_MODE_MT
+        uint16 IsrTick;                             //  载波计数，M/T法的时间基准
+        uint16 EdgeTick;                            //  最近一次计数变化的载波计数
+        uint16 EdgeCntr;                            //  最近一次计数变化后的Timer2计数值
+        uint16 RefTick;                             //  M/T法测量区间起点
+        uint16 RefCntr;
+        int16  SpeedMT;                             //  M/T法速度
+        int16  SpeedEst;                            //  当前选用的速度估计(滤波前)
+        uint16 SpeedLatency;                        //  速度估计的等效延时(载波数)
+
+        int32  ObsIqSum;                            //  观测周期内的转矩电流累加
+        int32  ObsPosErr;                           //  观测位置 - 实测位置，Q16计数
+        int32  ObsSpeed;                            //  观测速度，Q16计数/观测周期
+        int32  ObsLoad;                             //  观测负载转矩，Q8(Iq单位)
+        int16  ObsLoadIq;                           //  观测负载转矩(Iq单位)
+
 }QEPTypedef;
 
 extern QEPTypedef xdata mcQEP;
 extern void EXTI_Init(void);
-#ednif
+extern void QEP_SpeedMT(void);
+extern void QEP_SpeedReport(void);
+extern void QEP_Observer(void);
+#endif
 
 
@@ -0,0 +1,68 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : Sched.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 多速率任务调度。DRV_ISR(24kHz载波)和SYStick_INT(2kHz节拍)各有一组分频任务，
+/*                   每个任务由分频数和相位决定在哪个节拍执行，相位错开使较重的任务不落在同一节拍；
+/*                   单次耗时超过预算时计入超时计数，通过VISCA查询读出。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __SCHED_H_
+#define __SCHED_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define SCHED_US(us)                    (uint16)((us) * 24.0)   // 微秒 -> TIM4计数
+
+/* 任务编号，DRV_ISR任务在前，SYStick_INT任务在后，与VISCA查询中的编号一致 */
+#define SCHED_FAST_SPEED                (0)                 // DRV_ISR: M法测速/观测器，每8个载波
+#define SCHED_FAST_NUM                  (1)
+
+#define SCHED_SLOW_POS_LOOP             (1)                 // SYStick_INT: 位置误差更新，每3个节拍
+#define SCHED_SLOW_GO_TIME              (2)                 // SYStick_INT: 串口1ms计时，每2个节拍
+#define SCHED_SLOW_PHASE_LOSS           (3)                 // SYStick_INT: 缺相检测，每102个节拍(51ms)
+#define SCHED_TASK_NUM                  (4)
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint8   Div;                                            // 分频数，每Div个节拍执行一次
+    uint8   Phase;                                          // 相位，节拍数对Div取余等于Phase时执行
+    uint16  Budget;                                         // 单次耗时预算(TIM4计数)
+} SCHED_TASK;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern SCHED_TASK code SchedTask[SCHED_TASK_NUM];
+extern uint8  idata SchedCnt[SCHED_TASK_NUM];
+extern uint16 xdata SchedOverrun[SCHED_TASK_NUM];
+
+/* Exported macros ------------------------------------------------------------------------------*/
+/*  SCHED_DUE在各自中断的节拍更新之后判断任务是否到期。
+    SCHED_CHECK与PROFILE_START共用起始计数值，单次耗时超过预算时超时计数加1，计数饱和不回绕。 */
+#define SCHED_DUE(Id)                   (SchedCnt[Id] == 0)
+
+#if (PROFILE_ENABLE)
+#define SCHED_CHECK(Id, Start)          do                                                  \
+                                        {                                                   \
+                                            if (((uint16)(TIM4__CNTR - (Start)) > SchedTask[Id].Budget) \
+                                                && (SchedOverrun[Id] != 0xFFFF))            \
+                                            {                                               \
+                                                SchedOverrun[Id]++;                         \
+                                            }                                               \
+                                        } while (0)
+#else
+#define SCHED_CHECK(Id, Start)
+#endif
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void Sched_Init(void);
+extern void Sched_FastTick(void);
+extern void Sched_SlowTick(void);
+extern void Sched_Reset(void);
+extern void Sched_Report(uint8 Id);
+
+#endif
@@ -0,0 +1,93 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : Scope.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : 片上示波器。DRV_ISR中每Div个载波周期记录一次最多8路信号到xdata环形缓冲区，
+/*                   故障、|PosErr|超过阈值或收到运动指令时触发，保留触发前Pre个记录，缓冲区写满后冻结。
+/*                   冻结后可逐条通过VISCA读出，或在SPI软件调试模式下每个载波周期把一条记录的4路
+/*                   写入spidebug，由DMA1循环输出到SPI_Monitor。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __SCOPE_H_
+#define __SCOPE_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define SCOPE_BUF_WORDS                 (256)               // 缓冲区字数，记录深度 = SCOPE_BUF_WORDS / 通道数
+#define SCOPE_CH_MAX                    (8)
+
+/* 信号编号，与VISCA配置指令中的编号一致 */
+#define SCOPE_SIG_THETA                 (0)                 // FOC__THETA
+#define SCOPE_SIG_IQREF                 (1)                 // FOC_IQREF
+#define SCOPE_SIG_IQ                    (2)                 // FOC__IQ
+#define SCOPE_SIG_IDREF                 (3)                 // FOC_IDREF
+#define SCOPE_SIG_ID                    (4)                 // FOC__ID
+#define SCOPE_SIG_UQ                    (5)                 // FOC__UQ
+#define SCOPE_SIG_UD                    (6)                 // FOC__UD
+#define SCOPE_SIG_POS_ERR               (7)                 // PosErr，已限幅到±30000
+#define SCOPE_SIG_SPEED_ERR             (8)                 // speedErr，已限幅到±30000
+#define SCOPE_SIG_SPEED                 (9)                 // mcQEP.SpeedMFlt
+#define SCOPE_SIG_POS                   (10)                // mcQEP.CntrSumReal低16位
+#define SCOPE_SIG_POS_REF               (11)                // mcSP.PulsesNum低16位
+#define SCOPE_SIG_NUM                   (12)
+
+/* Scope.State */
+#define SCOPE_IDLE                      (0)                 // 不记录
+#define SCOPE_ARMED                     (1)                 // 记录中，等待触发
+#define SCOPE_POST                      (2)                 // 已触发，记录触发后部分
+#define SCOPE_DONE                      (3)                 // 缓冲区已冻结
+
+/* 触发源，Scope.Mask按位组合；Scope.Cause为实际触发的一位 */
+#define SCOPE_TRIG_FAULT                (0x01)              // mcFaultSource不为FaultNoSource
+#define SCOPE_TRIG_POS                  (0x02)              // |PosErr| >= Scope.Level
+#define SCOPE_TRIG_CMD                  (0x04)              // 接受了新的目标位置(mcSP.Cmd与启动时不同)
+#define SCOPE_TRIG_FORCE                (0x08)              // VISCA强制触发，Mask为0时预触发部分记满即触发
+
+/* 81 01 06 2D 0m FF */
+#define SCOPE_CTL_STOP                  (0)                 // 停止记录，保留缓冲区
+#define SCOPE_CTL_FORCE                 (1)                 // 强制触发
+#define SCOPE_CTL_REPLAY_OFF            (2)                 // 停止向spidebug回放
+#define SCOPE_CTL_REPLAY_LO             (3)                 // 回放第0~3路
+#define SCOPE_CTL_REPLAY_HI             (4)                 // 回放第4~7路
+
+/* Exported types -------------------------------------------------------------------------------*/
+typedef struct
+{
+    uint8   State;                                          // SCOPE_xxx
+    uint8   Num;                                            // 通道数1 ~ SCOPE_CH_MAX
+    uint8   Sig[SCOPE_CH_MAX];                              // 各通道的SCOPE_SIG_xxx
+    uint8   Div;                                            // 每Div个载波周期记录一次
+    uint8   DivCnt;
+    uint8   Mask;                                           // 允许的触发源
+    uint8   Cause;                                          // 实际触发源，冻结前为0
+    uint8   Req;                                            // Scope_Control置位的强制触发请求
+    uint8   Cmd;                                            // 启动时的mcSP.Cmd
+    uint8   Replay;                                         // 0: 不回放，1/2: 回放第0~3/4~7路
+    uint16  Level;                                          // 位置误差触发阈值(计数)
+    uint16  Size;                                           // 使用的字数，Depth * Num
+    uint16  Depth;                                          // 记录深度
+    uint16  Pre;                                            // 触发前保留的记录数
+    uint16  Fill;                                           // 启动后已写入的记录数，到Pre为止
+    uint16  Post;                                           // 触发后还需记录的数目
+    uint16  Wr;                                             // 下一条记录的字下标，冻结后为最早一条
+    uint16  Rd;                                             // 回放的字下标
+} SCOPE;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern SCOPE xdata Scope;
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void Scope_Init(void);
+extern void Scope_Config(uint8 Num, uint8 *Sig);
+extern void Scope_Arm(uint8 Mask, uint8 Div, uint8 Pre, uint16 Level);
+extern void Scope_Control(uint8 Ctl);
+extern void Scope_Sample(void);
+extern void Scope_Replay(void);
+extern void Scope_Report(void);
+extern void Scope_ReportRecord(uint16 Idx, uint8 Half);
+
+#endif
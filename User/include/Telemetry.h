@@ -0,0 +1,64 @@
+/*  -------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen ---------------------------*/
+/*  File Name      : Telemetry.h
+/*  Author         : Fortiortech  Appliction Team
+/*  Version        : V1.0
+/*  Date           : 2026-10-17
+/*  Description    : UART1遥测。DBG_MODE为UART_DBG时，控制代码在算出各量的地方用TELEM_PUT按TELEM_FRAME的
+/*                   布局直接写入xdata双缓冲中正在填写的一帧，SYStick_INT每TELEM_DIV个周期把这一帧交给DMA1
+/*                   送到UART1并切换到另一帧，不经过浮点转换和复制。16位字段按Keil C51的大端存放，
+/*                   DMA按内存顺序发送，上位机按有符号16位大端解析。
+/*  ----------------------------------------------------------------------------------------------*/
+/*                                     All Rights Reserved
+/*  ----------------------------------------------------------------------------------------------*/
+/*  Define to prevent recursive inclusion --------------------------------------------------------*/
+#ifndef __TELEMETRY_H_
+#define __TELEMETRY_H_
+
+#include <FU68xx_4_Type.h>
+
+/* Exported constants ---------------------------------------------------------------------------*/
+#define TELEM_HEAD                      (0xA5)              // 帧头
+#define TELEM_BAUD_REG                  (uint16)(MCU_CLOCK * 1000000.0 / 16.0 / TELEM_BAUD_RATE - 0.5)
+#define TELEM_LEN                       (sizeof(TELEM_FRAME))
+
+/* Exported types -------------------------------------------------------------------------------*/
+/* 帧布局，字段顺序即发送顺序，共18字节，250000bps下每帧0.72ms */
+typedef struct
+{
+    uint8   Head;                                           // TELEM_HEAD
+    uint8   Seq;                                            // 帧序号，每次交给DMA1加1，上位机据此判断丢帧
+    int16   PosErr;                                         // 位置误差(计数)，已限幅到±30000
+    int16   SpeedErr;                                       // 速度误差，已限幅到±30000
+    int16   Speed;                                          // mcQEP.SpeedMFlt
+    int16   IqRef;                                          // 速度环输出mcIqref，不含齿槽补偿；到位保持中为-HoldCtrl.Iq
+    int16   Iq;                                             // FOC__IQ
+    int16   Id;                                             // FOC__ID
+    int16   Uq;                                             // FOC__UQ
+    int16   Pos;                                            // mcQEP.CntrSumReal低16位
+} TELEM_FRAME;
+
+typedef struct
+{
+    TELEM_FRAME xdata *Frame;                               // 正在填写的一帧，另一帧可能正由DMA1发送
+    uint8   Div;                                            // SysTick分频计数
+    uint8   Seq;
+    uint16  Drop;                                           // DMA1仍在发送上一帧而放弃的帧数
+} TELEM;
+
+/* Exported variables ---------------------------------------------------------------------------*/
+extern TELEM xdata Telem;
+extern TELEM_FRAME xdata TelemBuf[2];
+
+/* Exported macros ------------------------------------------------------------------------------*/
+/*  控制代码中写入正在填写的一帧的字段，与Telem_Tick同在SYStick_INT中执行，交给DMA1之前写多次时以最后一次为准 */
+#if (DBG_MODE == UART_DBG)
+#define TELEM_PUT(Field, Value)         Telem.Frame->Field = (Value)
+#else
+#define TELEM_PUT(Field, Value)
+#endif
+
+/* Exported functions ---------------------------------------------------------------------------*/
+extern void Telem_Init(void);
+extern void Telem_Tick(void);
+
+#endif
@@ -13,6 +13,7 @@ extern void Timer2_Init(void);
 extern void Timer2_QEP_Init(void);
 extern void Timer3_Init(void);
 extern void Timer4_Init(void);
+extern void Timer4_Profile_Init(void);
 extern void TIM4_Init_RF(void);
 
 #endif
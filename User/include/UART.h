@@ -1,21 +1,89 @@
 #ifndef __UART_H__
 #define __UART_H__
 
+/* նУжϰ81...FF֡дУѭ֡ȡָŶӶʧ */
+#define UART_RXQ_NUM                    (8)                 // ֡2ݣͬʱŶUART_RXQ_NUM-1֡
+#define UART_RXQ_SIZE                   (16)                // ÿֽ֡Ч֡4 ~ 15
+
+/* UT2_BAUD = 24MHz / 16 /  - 1룬9600 -> 0x9B115200 -> 0x0C250000 -> 0x05 */
+#define UART2_BAUD_REG                  (uint16)(MCU_CLOCK * 1000000.0 / 16.0 / UART2_BAUD_RATE - 0.5)
+
+/*  ֡A5 Seq P3 P2 P1 P0 CH CL8ֽڣظ
+    PΪλĿλ(int32)CΪA5~P0CRC16-CCITT-FALSE(ӲCRCԪ)
+    Seqint8ֵһβõ֡²Ųãжֱд滮Ŀ꣬ѭ
+    ٶһVISCAλָٶȵȼ */
+#define UART_STREAM_HEAD                (0xA5)
+#define UART_STREAM_LEN                 (8)
+
+/* ָ */
+#define UART_CMD_ANY                    (0xFF)              // CmdȽR_DATA[3]
+#define UART_F_ACK                      (0x01)              // ȻظACKظ
+#define UART_F_LEARN                    (0x02)              // λѧϰڼҲӦ
+#define UART_F_IQ                       (0x04)              // ڵջִУλ˳ָڽն
+#define UART_F_MOVE                     (0x08)              // ıĿλãݲ۲ѧϰлظ޷ִ
+
+/* ָ֧ */
+#define UART_ID_MOE                     (0)                 // 81 01 06 01
+#define UART_ID_ABS_MOVE                (1)                 // 81 01 06 02
+#define UART_ID_INC_MOVE                (2)                 // 81 01 06 03
+#define UART_ID_GO_ZERO                 (3)                 // 81 01 06 04
+#define UART_ID_SET_ZERO                (4)                 // 81 01 06 08
+#define UART_ID_FF_SET                  (5)                 // 81 01 06 30
+#define UART_ID_SPEED_MODE              (6)                 // 81 01 06 31
+#define UART_ID_PROF_RESET              (7)                 // 81 01 06 20
+#define UART_ID_STOP                    (8)                 // 81 01 06 22
+#define UART_ID_START                   (9)                 // 81 01 06 33
+#define UART_ID_VERSION                 (10)                // 81 02 38 / 81 02 48
+#define UART_ID_SKP                     (11)                // 81 02 68
+#define UART_ID_SKI                     (12)                // 81 02 69
+#define UART_ID_SKD                     (13)                // 81 02 6A
+#define UART_ID_FAULT                   (14)                // 81 02 78
+#define UART_ID_FAULT_CLR               (15)                // 81 02 88
+#define UART_ID_LEARN                   (16)                // 81 09 04
+#define UART_ID_SPEED                   (17)                // 81 09 06 11
+#define UART_ID_POS                     (18)                // 81 09 06 12
+#define UART_ID_FF_GET                  (19)                // 81 09 06 30
+#define UART_ID_SPEED_MODE_GET          (20)                // 81 09 06 31
+#define UART_ID_PROF                    (21)                // 81 09 06 20
+#define UART_ID_PROF_HIST               (22)                // 81 09 06 21
+#define UART_ID_SCHED                   (23)                // 81 09 06 22
+#define UART_ID_QUEUE                   (24)                // 81 09 06 23
+#define UART_ID_STREAM                  (25)                // 81 09 06 24
+#define UART_ID_PARAM                   (26)                // 81 09 06 25
+#define UART_ID_CALIB                   (27)                // 81 09 06 26
+#define UART_ID_CALIB_SET               (28)                // 81 01 06 26
+#define UART_ID_ENC_CAL                 (29)                // 81 01 06 27
+#define UART_ID_ENC                     (30)                // 81 09 06 27
+#define UART_ID_COG_CAL                 (31)                // 81 01 06 28
+#define UART_ID_COG                     (32)                // 81 09 06 28
+#define UART_ID_TUNE_CAL                (33)                // 81 01 06 29
+#define UART_ID_TUNE                    (34)                // 81 09 06 29
+#define UART_ID_HOLD                    (35)                // 81 09 06 2A
+#define UART_ID_SCOPE_CFG               (36)                // 81 01 06 2B
+#define UART_ID_SCOPE_ARM               (37)                // 81 01 06 2C
+#define UART_ID_SCOPE_CTL               (38)                // 81 01 06 2D
+#define UART_ID_SCOPE                   (39)                // 81 09 06 2B
+#define UART_ID_SCOPE_REC               (40)                // 81 09 06 2C
+#define UART_ID_ABS                     (41)                // 81 09 06 2E
+
+/* ͶУӦ֡ƵкDMA0֡͵UART2жһ֡ */
+#define UART_TXQ_NUM                    (4)                 // ֡2ݣͬʱŶUART_TXQ_NUM-1֡
+#define UART_TXQ_SIZE                   (20)                // ÿֽ֡T_DATAͬ
+
 
 typedef struct
 {
-    uint8    R_DATA[20];//={0,0,0,0,0,0,0,0,0,0,0,0};      //
+    uint8    R_DATA[UART_RXQ_SIZE];//={0,0,0,0,0,0,0,0,0,0,0,0};      //
     uint8    T_DATA[20];//={0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};      //
     uint16   Uredata;            //ڶȡݼĴ
     uint16   UARxCnt;            //
     uint16   RxFSM;              //ݴɱ׼
-    uint16   UsaRxLen;
+    uint16   UsaRxLen;           //ǰ֡ĳȣ81FF
     uint16   flagUsaRxComm;
     uint32   CheckDate;
     uint16   ResponceCount;
-    uint8    ResponceFlag;       //ݶȡɱ־
     uint16	 UsaTxlen;
-    uint16   SendCnt;            //
+    uint8    NoActiveReq;        //жϷ֡ѭظЧָ
 	uint8    T_Len;              //ݳ
 	uint8    R_Len;							 //ݳ
 	uint16   Time_Count;		   	 //ʱʱ
@@ -35,6 +103,46 @@ typedef struct
     uint8    SendSpeed_Flag;
 }MCUART;
 
+typedef struct
+{
+    uint8    Buf[UART_RXQ_NUM][UART_RXQ_SIZE];
+    uint8    Len[UART_RXQ_NUM];
+    uint8    Head;               //һȡֻ֡ѭƽ
+    uint8    Tail;               //ڽյֻ֡ɽжƽ
+    uint16   Drop;               //֡
+}UART_RXQ;
+
+typedef struct
+{
+    uint8    Buf[UART_STREAM_LEN];
+    uint8    Seq;                //õ
+    uint8    SeqValid;           //Ѳù֡SeqЧ
+    uint16   Ok;                 //õ֡
+    uint16   CrcErr;             //CRC֡
+    uint16   Stale;              //ظ֡
+}UART_STREAM;
+
+typedef struct
+{
+    uint8    Cat;                //R_DATA[1]01 02ѯ 09״̬ѯ
+    uint8    Grp;                //R_DATA[2]
+    uint8    Cmd;                //R_DATA[3]UART_CMD_ANYȽ
+    uint8    LenMin;             //֡Χ81FF
+    uint8    LenMax;
+    uint8    Flag;               //UART_F_xxx
+    uint8    Id;                 //֧ UART_ID_xxx
+}UART_CMD;
+
+typedef struct
+{
+    uint8    Buf[UART_TXQ_NUM][UART_TXQ_SIZE];
+    uint8    Len[UART_TXQ_NUM];
+    uint8    Head;               //ڷ͵ֻ֡DMAжƽ
+    uint8    Tail;               //һдֻ֡ѭƽ
+    uint8    Busy;               //DMAڷ
+    uint16   Drop;               //֡
+}UART_TXQ;
+
 typedef enum
 {
   PowerOn    = 0,
@@ -82,11 +190,18 @@ extern SELFLEARN Power;
 extern UART_FLAG xdata UARTFL;
 
 extern MCUART Uart;
+extern UART_RXQ xdata UartRxQ;
+extern UART_STREAM xdata UartStream;
+extern UART_TXQ xdata UartTxQ;
 extern uint16 MinAngleCode  ; //306 
 extern uint16 MaxAngleCode  ; //14CD         
 extern uint16 MiddleAngleCode  ;
 extern void UART_Init(void);
-extern void UART_SendData(uint8 T_Data);
+extern void Uart_TxInit(void);
+extern void Uart_TxPush(uint8 *Buf, uint8 Len);
+extern void Uart_PutWord(uint8 Pos, uint16 Value);
+extern uint8 Uart_RxPop(void);
+extern void Uart_StreamRx(void);
 extern void UartDealResponse(void);
 extern void UartDealComm(void);
 extern void UartDealComm2(void);
@@ -109,4 +224,13 @@ extern void Send_Success(void);
 extern void Send_Fail(void);
 extern void Speed_Handle(uint8 level);
 
+/* DMA0Ͷͷһ֡DMA0Uart_TxInitΪXDATA->UART2 */
+#define UART_TX_START()                 do                                                          \
+                                        {                                                           \
+                                            DMA0_LEN = UartTxQ.Len[UartTxQ.Head] - 1;               \
+                                            DMA0_BA  = (uint16)UartTxQ.Buf[UartTxQ.Head] & 0x07FF;  \
+                                            SetBit(DMA0_CR0, DMAEN | DMABSY);                       \
+                                            UartTxQ.Busy = 1;                                       \
+                                        } while (0)
+
 #endif
\ No newline at end of file
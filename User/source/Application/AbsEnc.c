@@ -0,0 +1,401 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : AbsEnc.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : PWM绝对值编码器的帧检查、中值滤波和启动角度换算。
+                     启动角度原为浮点公式: Angle = (Duty / 32767 * 4098 - 1) / 4095 * 360 - Offset(整度)，
+                     FOC__THETA = _Q15(Angle / 180)，TIM2__CNTR = -P_Value(Angle) / Pole_Pairs。
+                     这里按有理数精确计算后截断，浮点只在极少数恰好落在量化边界附近的点上因舍入差1。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+/* Angle * 32767 / 180 = (ABS_FRAME * Duty - 32767) * 2 / ABS_CODES - Offset * 32767 / 180，通分到ABS_THETA_DEN */
+#define ABS_THETA_DEN                   (4L * ABS_CODES)                            // 16380
+#define ABS_OFFSET_GAIN                 (32767L * (ABS_THETA_DEN / 180))            // 2981797
+#define ABS_CNTR_DEN                    (ABS_THETA_DEN * 32767UL)                   // 536723460
+#define ABS_HALF                        ((ABS_CODES + 1) / 2)                       // 半个电周期的角度码
+
+ABS_ENC xdata AbsEnc;
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_MulDiv
+    Description    : (A * B + Round) / C，A不大于C，结果不超过B。MDU与DRV_ISR共用，主循环中调用时关中断
+    Date           : 2026-10-17
+    Parameter      : A, B, C, Round: [输入]
+    ------------------------------------------------------------------------------------------------- */
+static uint16 AbsEnc_MulDiv(uint16 A, uint16 B, uint16 C, uint16 Round)
+{
+    uint16 H, L;
+    uint16 Q;
+
+    EA = 0;
+    Muilt_MDU(A, B, H, L);
+    L += Round;
+
+    if (L < Round)
+    {
+        H++;
+    }
+
+    DivQ_L_MDU(H, L, C, Q);
+    EA = 1;
+
+    return Q;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Duty
+    Description    : 占空比 = Dr * 32767 / Arr，Q15，Dr不小于Arr时为32767
+    Date           : 2026-10-17
+    Parameter      : Dr: [输入] 高电平计数
+                     Arr: [输入] 周期计数
+    ------------------------------------------------------------------------------------------------- */
+uint16 AbsEnc_Duty(uint16 Dr, uint16 Arr)
+{
+    if (Dr >= Arr)
+    {
+        return (Arr == 0) ? 0 : 32767;
+    }
+
+    return AbsEnc_MulDiv(Dr, 32767, Arr, 0);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Init
+    Description    : 清空缓冲区和窗口，在开中断之前调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AbsEnc_Init(void)
+{
+    memset(&AbsEnc, 0, sizeof(AbsEnc));
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Capture
+    Description    : TIM3_INT周期中断中调用，把一帧的高电平和周期放入缓冲区，缓冲区满时丢弃并计数
+    Date           : 2026-10-17
+    Parameter      : Dr: [输入] TIM3__DR
+                     Arr: [输入] TIM3__ARR
+    ------------------------------------------------------------------------------------------------- */
+void AbsEnc_Capture(uint16 Dr, uint16 Arr)
+{
+    uint8 Wr = AbsEnc.RawWr;
+
+    if (((Wr + 1) & (ABS_RAW_NUM - 1)) == AbsEnc.RawRd)
+    {
+        if (AbsEnc.Lost != 0xFFFF)
+        {
+            AbsEnc.Lost++;
+        }
+        return;
+    }
+
+    AbsEnc.RawDr[Wr]  = Dr;
+    AbsEnc.RawArr[Wr] = Arr;
+    AbsEnc.RawWr      = (Wr + 1) & (ABS_RAW_NUM - 1);
+    AbsEnc.Stuck      = 0;
+}
+
+/* 错误计数，饱和不回绕 */
+static void AbsEnc_Fault(uint8 Status)
+{
+    AbsEnc.Status = Status;
+    AbsEnc.Conf   = 0;
+
+    if (AbsEnc.Error != 0xFFFF)
+    {
+        AbsEnc.Error++;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Median
+    Description    : 以最新一帧为参考把窗口内的角度码换算为[-ABS_HALF, ABS_HALF)内的差值，0/ABS_CODES两侧的码
+                     不会被当作相差一个电周期；排序后取中值，同时得到极差和中值所在帧的延迟
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+static void AbsEnc_Median(void)
+{
+    int16 Diff[ABS_MEDIAN_N];
+    uint8 Age[ABS_MEDIAN_N];
+    uint16 Ref;
+    int16 D;
+    uint8 Idx;
+    uint8 i, j;
+
+    Idx = (AbsEnc.Wr == 0) ? (ABS_MEDIAN_N - 1) : (AbsEnc.Wr - 1);
+    Ref = AbsEnc.Code[Idx];
+
+    for (i = 0; i < ABS_MEDIAN_N; i++)
+    {
+        D = (int16)AbsEnc.Code[Idx] - (int16)Ref;
+
+        if (D >= ABS_HALF)
+        {
+            D -= ABS_CODES;
+        }
+        else if (D < -ABS_HALF)
+        {
+            D += ABS_CODES;
+        }
+
+        for (j = i; (j > 0) && (Diff[j - 1] > D); j--)  // 插入排序，按差值升序
+        {
+            Diff[j] = Diff[j - 1];
+            Age[j]  = Age[j - 1];
+        }
+
+        Diff[j] = D;
+        Age[j]  = i;
+        Idx     = (Idx == 0) ? (ABS_MEDIAN_N - 1) : (Idx - 1);
+    }
+
+    D = (int16)Ref + Diff[ABS_MEDIAN_N / 2];
+
+    if (D < 0)
+    {
+        D += ABS_CODES;
+    }
+    else if (D > ABS_CODES)
+    {
+        D -= ABS_CODES;
+    }
+
+    AbsEnc.Median  = D;
+    AbsEnc.Latency = Age[ABS_MEDIAN_N / 2];
+    AbsEnc.Jitter  = Diff[ABS_MEDIAN_N - 1] - Diff[0];
+    AbsEnc.Duty    = AbsEnc_Duty(D + ABS_INIT_CLKS, ABS_FRAME);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Frame
+    Description    : 检查一帧的周期和帧格式，有效时把角度码放入窗口
+    Date           : 2026-10-17
+    Parameter      : Dr: [输入] 高电平计数
+                     Arr: [输入] 周期计数
+    ------------------------------------------------------------------------------------------------- */
+static void AbsEnc_Frame(uint16 Dr, uint16 Arr)
+{
+    uint16 Tol;
+    uint16 Clks;
+
+    if (Arr == 0)
+    {
+        AbsEnc_Fault(ABS_ERR_INIT);
+        return;
+    }
+
+    if (AbsEnc.ArrRef == 0)
+    {
+        AbsEnc.ArrRef = Arr;
+    }
+
+    Tol = AbsEnc.ArrRef >> ABS_ARR_TOL_SHIFT;
+
+    if ((Arr > AbsEnc.ArrRef + Tol) || (Arr < AbsEnc.ArrRef - Tol))
+    {
+        AbsEnc.Status = ABS_GLITCH;
+
+        if (AbsEnc.Glitch != 0xFFFF)
+        {
+            AbsEnc.Glitch++;
+        }
+
+        if (++AbsEnc.GlitchRun >= ABS_MEDIAN_N)             // 周期确实变了(如上电时参考值取自毛刺)，改用新周期
+        {
+            AbsEnc.GlitchRun = 0;
+            AbsEnc.ArrRef    = Arr;
+        }
+        return;
+    }
+
+    AbsEnc.GlitchRun = 0;
+    AbsEnc.ArrRef   += (int16)(Arr - AbsEnc.ArrRef) >> 3;
+
+    if (Dr > Arr)
+    {
+        AbsEnc_Fault(ABS_ERR_FLAG);
+        return;
+    }
+
+    Clks = AbsEnc_MulDiv(Dr, ABS_FRAME, Arr, Arr >> 1);    // 高电平的编码器时钟数，四舍五入
+
+    if (Clks < ABS_INIT_CLKS)
+    {
+        AbsEnc_Fault(ABS_ERR_INIT);
+        return;
+    }
+
+    if (Clks > ABS_INIT_CLKS + ABS_CODES)
+    {
+        AbsEnc_Fault(ABS_ERR_FLAG);
+        return;
+    }
+
+    AbsEnc.Code[AbsEnc.Wr] = Clks - ABS_INIT_CLKS;
+    AbsEnc.Wr = (AbsEnc.Wr + 1 >= ABS_MEDIAN_N) ? 0 : (AbsEnc.Wr + 1);
+
+    if (AbsEnc.Frames != 0xFFFF)
+    {
+        AbsEnc.Frames++;
+    }
+
+    if (AbsEnc.Conf != 0xFF)
+    {
+        AbsEnc.Conf++;
+    }
+
+    if (AbsEnc.Conf >= ABS_MEDIAN_N)
+    {
+        AbsEnc.Status = ABS_OK;
+        AbsEnc_Median();
+    }
+    else
+    {
+        AbsEnc.Status = ABS_WAIT;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Task
+    Description    : 主循环中调用，处理缓冲区中的帧和TIM3_INT记下的卡死
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AbsEnc_Task(void)
+{
+    uint8 Rd;
+    uint8 Stuck = AbsEnc.Stuck;
+
+    if (Stuck != 0)
+    {
+        AbsEnc.Stuck = 0;
+        AbsEnc_Fault(Stuck);
+    }
+
+    while (AbsEnc.RawRd != AbsEnc.RawWr)
+    {
+        Rd = AbsEnc.RawRd;
+        AbsEnc_Frame(AbsEnc.RawDr[Rd], AbsEnc.RawArr[Rd]);
+        AbsEnc.RawRd = (Rd + 1) & (ABS_RAW_NUM - 1);
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Ready
+    Description    : 窗口内都是上次出错后的有效帧且极差不超过Jitter时，中值读数可用于启动
+    Date           : 2026-10-17
+    Parameter      : Jitter: [输入] 允许的极差，ABS_JITTER_MAX或ABS_ALIGN_JITTER
+    ------------------------------------------------------------------------------------------------- */
+uint8 AbsEnc_Ready(uint16 Jitter)
+{
+    return (AbsEnc.Conf >= ABS_MEDIAN_N) && (AbsEnc.Jitter <= Jitter);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Report
+    Description    : 应答读数或统计
+    Date           : 2026-10-17
+    Parameter      : Field: [输入] 0: 延迟、中值、抖动、可信度，其他: 有效帧、毛刺、错误、丢帧
+    ------------------------------------------------------------------------------------------------- */
+void AbsEnc_Report(uint8 Field)
+{
+    Uart.T_DATA[2] = AbsEnc.Status;
+
+    if (Field == 0)
+    {
+        Uart.T_DATA[3] = AbsEnc.Latency;
+        Uart_PutWord(4, AbsEnc.Median);
+        Uart_PutWord(8, AbsEnc.Jitter);
+        Uart_PutWord(12, AbsEnc.Conf);
+        Uart.T_Len = 17;
+    }
+    else
+    {
+        Uart_PutWord(3, AbsEnc.Frames);
+        Uart_PutWord(7, AbsEnc.Glitch);
+        Uart_PutWord(11, AbsEnc.Error);
+        Uart_PutWord(15, AbsEnc.Lost);
+        Uart.T_Len = 20;
+    }
+
+    Uart.RxFSM = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Angle
+    Description    : 帧内角度，Q15 (32767 = 360°)，即原_Q15(Angle / 360.0)
+    Date           : 2026-10-17
+    Parameter      : Duty: [输入] AbsEnc_Duty的结果
+    ------------------------------------------------------------------------------------------------- */
+int16 AbsEnc_Angle(uint16 Duty)
+{
+    return (int16)(((int32)ABS_FRAME * Duty - 32767) / ABS_CODES);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_OffsetDeg
+    Description    : 零位角(Q15，32767 = 360°)换算为度，向零取整，与原来写入int16的LreanAngleFlt相同
+    Date           : 2026-10-17
+    Parameter      : AngleFlt: [输入] mcQEP.AngleFlt
+    ------------------------------------------------------------------------------------------------- */
+int16 AbsEnc_OffsetDeg(int16 AngleFlt)
+{
+    return (int16)((int32)AngleFlt * 360 / 32767);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_ThetaNum
+    Description    : Angle * 32767 / 180 * ABS_THETA_DEN，Duty不大于32767、|OffsetDeg|不大于360时不超过2^31
+    Date           : 2026-10-17
+    Parameter      : Duty: [输入]
+                     OffsetDeg: [输入]
+    ------------------------------------------------------------------------------------------------- */
+static int32 AbsEnc_ThetaNum(uint16 Duty, int16 OffsetDeg)
+{
+    return 8 * ((int32)ABS_FRAME * Duty - 32767) - OffsetDeg * ABS_OFFSET_GAIN;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Theta
+    Description    : 启动电角度，原_Q15(Angle / 180.0)，超过180°按int16回绕
+    Date           : 2026-10-17
+    Parameter      : Duty: [输入]
+                     OffsetDeg: [输入] AbsEnc_OffsetDeg的结果
+    ------------------------------------------------------------------------------------------------- */
+int16 AbsEnc_Theta(uint16 Duty, int16 OffsetDeg)
+{
+    return (int16)(AbsEnc_ThetaNum(Duty, OffsetDeg) / ABS_THETA_DEN);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AbsEnc_Cntr
+    Description    : 启动时的TIM2__CNTR，原-P_Value(Angle) / Pole_Pairs。PlusePerCircle为65536时
+                     P = Angle * 65536 / 360 = Num * 32768 / ABS_CNTR_DEN，Num * 32768超过32位，
+                     按Num / ABS_THETA_DEN的商和余数分开计算
+    Date           : 2026-10-17
+    Parameter      : Duty: [输入]
+                     OffsetDeg: [输入] AbsEnc_OffsetDeg的结果
+    ------------------------------------------------------------------------------------------------- */
+int16 AbsEnc_Cntr(uint16 Duty, int16 OffsetDeg)
+{
+    int32  Num = AbsEnc_ThetaNum(Duty, OffsetDeg);
+    uint32 AbsNum = (Num < 0) ? -Num : Num;
+    uint32 Q = AbsNum / ABS_THETA_DEN;
+    uint32 R = AbsNum % ABS_THETA_DEN;
+    int32  P;
+
+    P = (int32)(Q + (Q * ABS_THETA_DEN + (R << 15)) / ABS_CNTR_DEN);
+
+    if (Num < 0)
+    {
+        P = -P;
+    }
+
+    return (int16)(-P / (int16)Pole_Pairs);
+}
@@ -19,7 +19,6 @@ FaultStateType             mcFaultSource;
 FaultVarible       idata   mcFaultDect;
 CurrentVarible     mcCurVarible;
 ProtectVarible     xdata   mcProtectTime;
-PWMINPUTCAL    xdata mcPwmInput;
 
 MCRAMP             idata   mcSpeedRamp;
 MCRAMP             idata   mcPluseramp;
@@ -29,11 +28,39 @@ FOCCTRL            xdata   mcFocCtrl;
 UQ_Posi						 xdata   UqPo;
 
 SPlanTypeDef   xdata mcSP;
+FFTypeDef      xdata mcFF;
+GSTypeDef      xdata mcGS;
+FWTypeDef      xdata mcFW;
+CTRL_PID       xdata mcPosPID;
 
-_PID  pid_Pose;               //
+/* 速度环增益调度表，按|speedRef|和|PosErr|分别线性插值，两个倍数相乘后作用于AutoTune.SKp/SKi。
+   静止时加大Kp、到位附近加大Ki以消除摩擦带来的静差，高速时减小Ki，大行程减速段不因积分饱和而超调。
+   高速段Kp保持1.0，降到0.75或0.5时大行程的跟随误差和超调都变大。 */
+static GSPointTypeDef code GSSpeedTab[GS_POINTS] =
+{
+    {0,              GS_GAIN(1.5),   GS_GAIN(1.0)},
+    {S_Value(5.0),   GS_GAIN(1.0),   GS_GAIN(1.0)},
+    {S_Value(30.0),  GS_GAIN(1.0),   GS_GAIN(0.75)},
+    {S_Value(120.0), GS_GAIN(1.0),   GS_GAIN(0.75)},
+};
+
+static GSPointTypeDef code GSErrTab[GS_POINTS] =
+{
+    {0,              GS_GAIN(1.0),   GS_GAIN(8.0)},
+    {80,             GS_GAIN(1.0),   GS_GAIN(4.0)},
+    {700,            GS_GAIN(1.0),   GS_GAIN(1.0)},
+    {4000,           GS_GAIN(1.0),   GS_GAIN(1.0)},
+};
 
-extern float MinAngleLim;
-extern float MaxAngleLim;
+/* 弱磁Id前馈表，按|速度|线性插值，与电压裕量调节器的输出相加。默认云台电机在120rpm时反电势只有
+   母线可用电压的十分之一，不需要前馈，全为0；换用高反电势电机时按实测的Uq饱和转速填写。 */
+static FWPointTypeDef code FWIdTab[FW_POINTS] =
+{
+    {0,              I_Value(0.0)},
+    {S_Value(60.0),  I_Value(0.0)},
+    {S_Value(90.0),  I_Value(0.0)},
+    {S_Value(120.0), I_Value(0.0)},
+};
 
 
 /*  -------------------------------------------------------------------------------------------------
@@ -54,6 +81,40 @@ uint32 Abs_F32(int32 value)
     }
 }
 
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sqrt_U32
+    Description    : 32位整数开方，逐位试商，不用MDU，可在主循环中使用
+    Date           : 2026-10-17
+    Parameter      : X: [输入]
+    ------------------------------------------------------------------------------------------------- */
+uint16 Sqrt_U32(uint32 X)
+{
+    uint32 Root = 0;
+    uint32 Bit  = 1UL << 30;
+
+    while (Bit > X)
+    {
+        Bit >>= 2;
+    }
+
+    while (Bit != 0)
+    {
+        if (X >= Root + Bit)
+        {
+            X   -= Root + Bit;
+            Root = (Root >> 1) + Bit;
+        }
+        else
+        {
+            Root >>= 1;
+        }
+
+        Bit >>= 2;
+    }
+
+    return (uint16)Root;
+}
+
 
 /*  -------------------------------------------------------------------------------------------------
     Function Name  : HW_One_PI
@@ -105,46 +166,6 @@ int16 HW_PI_3(int16 Xn1)
 }
 
 
-float PID_pose(_PID * PID, float err)
-{
-    //误差
-    PID->err = err;
-    //    if (PID->err > 4000) PID->err = 4000;
-    //    if (PID->err < -4000) PID->err = -4000;
-    //    if (PID->err < 30 && PID->err > -30)
-    //    {
-    //        PID->err  = 0;
-    //        PID->integral = 0;
-    //    }
-    //    if (PID->err < 200){
-    //误差积分
-    PID->integral += PID->err;
-    //  }
-    // 积分限幅
-    PID->integral = (PID->integral > I_Value(0.05)) ?  I_Value(0.05) : PID->integral;
-    PID->integral = (PID->integral < -I_Value(0.05)) ? -I_Value(0.05) : PID->integral;
-    PID->voltage    = PID->Kp * PID->err
-        + PID->Ki * PID->integral;
-    //                    + PID->Kd * (PID->err - PID->err_last);
-    PID->voltage = (PID->voltage > I_Value(0.6)) ?  I_Value(0.6) : PID->voltage;
-    PID->voltage = (PID->voltage < -I_Value(0.6)) ? -I_Value(0.6) : PID->voltage;
-    //上一次的误差
-    PID->err_last = PID->err;
-    return PID->voltage ;
-}
-//用于初始化PID值
-void PID_init(_PID * PID, float Kp, float Ki, float Kd)
-{
-    PID->SetVal = 45;
-    PID->ActualVal = 0;
-    PID->err = 0;
-    PID->err_last = 0;
-    PID->integral = 0;
-    PID->Kp = Kp;
-    PID->Ki = Ki;
-    PID->Kd = Kd;
-}
-
 ///
 /*  -------------------------------------------------------------------------------------------------
     Function Name  : Speed_response
@@ -155,8 +176,6 @@ void PID_init(_PID * PID, float Kp, float Ki, float Kd)
 int32 speedRef;
 
 int32 speedErr;
-uint8 pos_loopCnt = 0;
-extern float spd;
 int32 PosErr;
 
 extern uint8 singal;
@@ -176,18 +195,41 @@ void Speed_response(void)
             case 0:
             {
                 mcFocCtrl.CtrlMode  = 1;
-                FOC_DQKP            = DQKP;
-                FOC_DQKI            = DQKI;
+                FOC_DQKP            = AutoTune.DqKp;
+                FOC_DQKI            = AutoTune.DqKi;
+                mcGS.Kp             = PI2_KP;
+                mcGS.Ki             = PI2_KI;
+                mcFW.IdAcc          = 0;
+                mcFW.Id             = ID_Start_CURRENT;
+                Ctrl_PidReset(&mcPosPID);
             }
             break;
             
             case 1:
             {							 
-                if (pos_loopCnt < 2)
+                #if (CALIB_TOOL_ENABLE)
+                if (EncComp.Sweep)                          //编码器偏心标定拖动中，位置给定跟随转子，速度环不积分
                 {
-                    pos_loopCnt ++;
+                    SpeedPlanReset(mcQEP.CntrSumReal);
+                    EncComp_Ramp();
+                    break;
                 }
-                else
+
+                if (AutoTune.Drive || AutoTune.Relay)       //参数整定，电压阶跃或Iq继电期间位置给定跟随转子，速度环不积分
+                {
+                    SpeedPlanReset(mcQEP.CntrSumReal);
+
+                    if (AutoTune.Relay)
+                    {
+                        AutoTune_Relay();
+                    }
+                    break;
+                }
+                #endif
+
+                SpeedPlanMs();
+
+                if (SCHED_DUE(SCHED_SLOW_POS_LOOP))
                 {      
 									PosErr =  mcSP.PulsesNum - mcQEP.CntrSumReal;        
 									if (PosErr > 30000)
@@ -198,10 +240,11 @@ void Speed_response(void)
 									{
 											PosErr = -30000;
 									}        
-									speedRef = (PosErr);//(PosErr<<2)+(PosErr>>1);
-                  pos_loopCnt = 0;
+                    Ctrl_Pid(&mcPosPID, (int16)PosErr);     //与位置误差同周期，Ki、Kd按每3个节拍一次计
                 }
 								mcFocCtrl.PosiErr = PosErr;
+                TELEM_PUT(PosErr, (int16)PosErr);
+                speedRef = mcPosPID.Out;
                 mc_ramp(&mcSpeedRampLim);        //10
                 LPF_MDU(mcSpeedRampLim.ActualValue, 5, mcSpeedRampLim.ActualValueFlt, mcSpeedRampLim.ActualValueFlt_LSB);
                 
@@ -214,11 +257,15 @@ void Speed_response(void)
                 {
                     speedRef = - mcSpeedRampLim.ActualValueFlt ;
                 }
+
+                /* 位置环只修正跟随误差，规划速度按Kv叠加到速度给定 */
+                mcFF.SpeedFF = (SPLAN_SPEED_TO_S(mcSP.Speed) * (int32)mcFF.Kv) >> 12;
+                speedRef += mcFF.SpeedFF;
                 #if (Speed_Method == T_Method)
                 {
                     speedErr = (int32)speedRef - mcFocCtrl.SpeedFlt;
                 }
-                #elif (Speed_Method == M_Method)
+                #else
                 {
                     speedErr = (int32)speedRef - mcQEP.SpeedMFlt;
                 }
@@ -232,6 +279,7 @@ void Speed_response(void)
                 {
                     speedErr = -30000;
                 }
+                TELEM_PUT(SpeedErr, (int16)speedErr);
 								if((speedErr >= -70)&&(speedErr <= 70))
 								{
 									mcQEP.timecnt++;
@@ -249,21 +297,56 @@ void Speed_response(void)
 									}
 									
 								}
-                mcFocCtrl.mcIqref =  HW_PI_2(speedErr);
+                /* 规划加速度按 J / Kt 折算为Iq前馈，叠加在速度环输出上 */
+                mcFF.IqFF = (mcSP.Acc * (int32)mcFF.Ka) >> 16;
+                SpeedGainSched(speedRef, PosErr);
+                HoldCtrl_Tick();
+
+                if (HoldCtrl.Mode != HOLD_IQ)               //到位保持中速度环不计算，只跟踪误差，退出时第一次计算没有比例项突变
+                {
+                    PI2_EK1 = speedErr;
+                    TELEM_PUT(IqRef, -HoldCtrl.Iq);         //保持电流直接写FOC_IQREF，按mcIqref的符号上报
+                    break;
+                }
+
+                FieldWeaken();
+                IqSum = (int32)HW_PI_2(speedErr) + mcFF.IqFF;
+
+                if (IqSum > SOUTMAX)
+                {
+                    IqSum = SOUTMAX;
+                }
+
+                if (IqSum < SOUTMIN)
+                {
+                    IqSum = SOUTMIN;
+                }
+
+                mcFocCtrl.mcIqref =  IqSum;
+                TELEM_PUT(IqRef, mcFocCtrl.mcIqref);
 								if(mcFocCtrl.ThetaIQ_SOURCE == 0)
 								{
-									FOC_IQREF = -mcFocCtrl.mcIqref;
+									EA = 0;                                  //DRV_ISR在IqBase上叠加齿槽补偿
+									CogComp.IqBase = -mcFocCtrl.mcIqref;
+									FOC_IQREF = CogComp.IqBase + CogComp.Iq;
+									EA = 1;
 								}
 								else
 								{
 									
 								}
+                #if (CALIB_TOOL_ENABLE)
+                CogComp_Tick();
+                AutoTune_Tick();
+                #endif
             }
             break;
         }
     }
     else
     {
+        SpeedPlanReset(mcQEP.CntrSumReal);
+
         //        if (Uart.Go_State == 2) //错误 没有执行
         //        {
         //            if (Uart.Go_Time > 3000) //3s 没有执行
@@ -277,79 +360,335 @@ void Speed_response(void)
     }
 }
 
-void PWMInputCapture(void)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : SpeedPlanMs
+    Description    : 位置曲线规划，每个SysTick节拍在Speed_response中调用一次。
+                     先按最大速度/加速度生成梯形曲线，减速段速度按 sqrt(2*a*剩余距离) 限制，
+                     再对梯形速度做SPLAN_JERK_TICKS点滑动平均得到S曲线(加速度线性变化)。
+                     输出位置给定PulsesNum、速度给定Speed、加速度给定Acc，到位后Done置1。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void SpeedPlanMs(void)
 {
-    uint16 MotorSpeedVSP;
-    
-    if (mcPwmInput.PwmUpdateFlag == 1) // 有新的duty更新
+    int32  Err;
+    uint32 Dist;
+    int32  SpeedLim;
+    int32  Temp;
+
+    /* -----梯形曲线----- */
+    Err = mcSP.TargetPulsesNum - mcSP.TrapPulsesNum;
+
+    if ((ABS(Err) <= 1) && (ABS(mcSP.TrapSpeed) <= mcSP.AccMax))
     {
-        if ((Abs_F32(mcPwmInput.TimeDR - mcPwmInput.PwmCompareOld) < 0xFF) // 误差在1个Byte之间再处理
-            && (Abs_F32(mcPwmInput.PwmArrOld - mcPwmInput.TimeARR) < 0xFF))      // 误差在1个Byte之间再处理
+        mcSP.TrapPulsesNum     = mcSP.TargetPulsesNum;
+        mcSP.TrapPulsesNum_LSB = 0;
+        mcSP.TrapSpeed         = 0;
+    }
+    else
+    {
+        Dist = ABS(Err);
+
+        if (Dist >= (uint32)(0x3FFFFFFF / mcSP.AccMax))
         {
-            mcPwmInput.PwmCompare = (mcPwmInput.TimeDR >> 1);// 对其乘以32768
-            mcPwmInput.PwmArr     = mcPwmInput.TimeARR;
-            mcPwmInput.PwmDuty = _Q15((float)mcPwmInput.TimeDR/mcPwmInput.TimeARR);
-//            DivQ_L_MDU(mcPwmInput.PwmCompare, 0x0000, mcPwmInput.PwmArr, mcPwmInput.PwmDuty);
-//            ClrBit(TIM3_CR1, T3IPE);          //输入Timer PWM周期检测中断使能 0-->Disable  1-->Enable
-//            ClrBit(TIM3_CR1, T3IFE);          //计数器上溢中断使能 0-->Disable  1-->Enable
+            SpeedLim = mcSP.SpeedMax;
         }
-        
-        mcPwmInput.PwmUpdateFlag = 0;
-        mcPwmInput.PwmCompareOld = mcPwmInput.TimeDR;//将此次比较值赋值给上次比较值
-        mcPwmInput.PwmArrOld     = mcPwmInput.TimeARR;//将此次周期值赋值给上次周期值
+        else
+        {
+            /* 离散减速少算半个节拍的加速度，保证不越过目标 */
+            SpeedLim = ((int32)Sqrt_U32((uint32)(mcSP.AccMax << 1) * Dist) << 8) - (mcSP.AccMax >> 1);
+
+            if (SpeedLim < 0)
+            {
+                SpeedLim = 0;
+            }
+
+            if (SpeedLim > mcSP.SpeedMax)
+            {
+                SpeedLim = mcSP.SpeedMax;
+            }
+        }
+
+        if (Err < 0)
+        {
+            SpeedLim = -SpeedLim;
+        }
+
+        Temp = SpeedLim - mcSP.TrapSpeed;
+
+        if (Temp > mcSP.AccMax)
+        {
+            Temp = mcSP.AccMax;
+        }
+
+        if (Temp < -mcSP.AccMax)
+        {
+            Temp = -mcSP.AccMax;
+        }
+
+        mcSP.TrapSpeed        += Temp;
+        Temp                   = (int32)mcSP.TrapPulsesNum_LSB + mcSP.TrapSpeed;
+        mcSP.TrapPulsesNum    += Temp >> 16;
+        mcSP.TrapPulsesNum_LSB = (uint16)Temp;
+    }
+
+    /* -----速度滑动平均----- */
+    mcSP.SpeedSum                   += mcSP.TrapSpeed - mcSP.SpeedBuf[mcSP.BufIndex];
+    mcSP.SpeedBuf[mcSP.BufIndex]     = mcSP.TrapSpeed;
+    mcSP.BufIndex                    = (mcSP.BufIndex + 1) & (SPLAN_JERK_TICKS - 1);
+
+    Temp                             = mcSP.Speed;
+    mcSP.Speed                       = mcSP.SpeedSum >> SPLAN_JERK_SHIFT;
+    mcSP.Acc                         = mcSP.Speed - Temp;
+
+    /* SpeedSum为速度的SPLAN_JERK_TICKS倍，小数部分按Q(16 + SPLAN_JERK_SHIFT)累加，不丢位置 */
+    mcSP.PulsesNum_LSB              += mcSP.SpeedSum;
+    mcSP.PulsesNum                  += mcSP.PulsesNum_LSB >> (16 + SPLAN_JERK_SHIFT);
+    mcSP.PulsesNum_LSB              &= ((int32)1 << (16 + SPLAN_JERK_SHIFT)) - 1;
+
+    /* -----到位：梯形曲线停在目标且缓冲全部为0----- */
+    if ((mcSP.TrapSpeed == 0) && (mcSP.TrapPulsesNum == mcSP.TargetPulsesNum))
+    {
+        if (mcSP.HoldCnt < SPLAN_JERK_TICKS)
+        {
+            mcSP.HoldCnt++;
+        }
+        else
+        {
+            mcSP.PulsesNum     = mcSP.TargetPulsesNum;
+            mcSP.PulsesNum_LSB = 0;
+            mcSP.Speed         = 0;
+            mcSP.Acc           = 0;
+            mcSP.Done          = 1;
+        }
+    }
+    else
+    {
+        mcSP.HoldCnt = 0;
+        mcSP.Done    = 0;
     }
 }
 
-void SpeedPlanMs(void)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : SpeedPlanSet
+    Description    : 设置新的目标位置，运动中也可以改变目标，曲线从当前给定平滑过渡。目标改变时mcSP.Cmd加1，
+                     到位保持中请求退出锁定，下一个SysTick周期由HoldCtrl_Tick退出；与当前目标相同时不处理。
+                     在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : Target: [输入] 目标位置(计数)
+    ------------------------------------------------------------------------------------------------- */
+void SpeedPlanSet(int32 Target)
+{
+    EA = 0;
+
+    if (Target != mcSP.TargetPulsesNum)
+    {
+        HoldCtrl.ExitReq     = 1;
+        mcSP.TargetPulsesNum = Target;
+        mcSP.Cmd++;
+    }
+
+    EA = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : SpeedPlanReset
+    Description    : 位置给定复位到Pos并清零速度，目标位置不变。电机不在运行状态时在SysTick中调用，
+                     重新运行时从实际位置规划到目标
+    Date           : 2026-10-17
+    Parameter      : Pos: [输入] 当前位置(计数)
+    ------------------------------------------------------------------------------------------------- */
+void SpeedPlanReset(int32 Pos)
+{
+    uint8 i;
+
+    mcSP.PulsesNum         = Pos;
+    mcSP.PulsesNum_LSB     = 0;
+    mcSP.Speed             = 0;
+    mcSP.Acc               = 0;
+    mcSP.TrapPulsesNum     = Pos;
+    mcSP.TrapPulsesNum_LSB = 0;
+    mcSP.TrapSpeed         = 0;
+    mcSP.SpeedSum          = 0;
+    mcSP.BufIndex          = 0;
+    mcSP.HoldCnt           = 0;
+    mcSP.Done              = 0;
+
+    for (i = 0; i < SPLAN_JERK_TICKS; i++)
+    {
+        mcSP.SpeedBuf[i] = 0;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : FF_Load
+    Description    : 从校准块读取前馈增益，在MotorcontrolInit中Calib_Load之后调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void FF_Load(void)
+{
+    mcFF.Kv      = Calib.Blk.FFKv;
+    mcFF.Ka      = Calib.Blk.FFKa;
+    mcFF.SpeedFF = 0;
+    mcFF.IqFF    = 0;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : FF_Save
+    Description    : 当前前馈增益写入校准块保存，由Param_Task在后台烧写
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void FF_Save(void)
+{
+    Calib.Blk.FFKv = mcFF.Kv;
+    Calib.Blk.FFKa = mcFF.Ka;
+    Calib_Save();
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : FF_Report
+    Description    : 填写前馈增益到应答帧 90 50 Kv(4个半字节) Ka(4个半字节) FF
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void FF_Report(void)
+{
+    Uart.T_DATA[2]  = (mcFF.Kv >> 12) & 0x0F;
+    Uart.T_DATA[3]  = (mcFF.Kv >> 8) & 0x0F;
+    Uart.T_DATA[4]  = (mcFF.Kv >> 4) & 0x0F;
+    Uart.T_DATA[5]  = mcFF.Kv & 0x0F;
+    Uart.T_DATA[6]  = (mcFF.Ka >> 12) & 0x0F;
+    Uart.T_DATA[7]  = (mcFF.Ka >> 8) & 0x0F;
+    Uart.T_DATA[8]  = (mcFF.Ka >> 4) & 0x0F;
+    Uart.T_DATA[9]  = mcFF.Ka & 0x0F;
+    Uart.T_Len      = 11;
+    Uart.RxFSM      = 1;
+}
+
+/* 在调度表Tab中按X线性插值，输出Kp和Ki倍数，Q8 */
+static void SpeedGainLookup(GSPointTypeDef code *Tab, uint32 X, uint16 *KpMul, uint16 *KiMul)
+{
+    uint8  i;
+    uint16 F;
+
+    if (X >= Tab[GS_POINTS - 1].X)
+    {
+        *KpMul = Tab[GS_POINTS - 1].KpMul;
+        *KiMul = Tab[GS_POINTS - 1].KiMul;
+        return;
+    }
+
+    for (i = 1; X > Tab[i].X; i++)
+    {
+    }
+
+    F      = (uint16)(((X - Tab[i - 1].X) << 8) / (Tab[i].X - Tab[i - 1].X));
+    *KpMul = Tab[i - 1].KpMul + (int16)((((int32)Tab[i].KpMul - Tab[i - 1].KpMul) * F) >> 8);
+    *KiMul = Tab[i - 1].KiMul + (int16)((((int32)Tab[i].KiMul - Tab[i - 1].KiMul) * F) >> 8);
+}
+
+/* Gain向Target靠近1/2^GS_SLEW_SHIFT，差值很小时直接到达 */
+static uint16 SpeedGainSlew(uint16 Gain, uint16 Target)
+{
+    int16 Step = (int16)(((int32)Target - Gain) >> GS_SLEW_SHIFT);
+
+    return (Step == 0) ? Target : (Gain + Step);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : SpeedGainSched
+    Description    : 在Speed_response中HW_PI_2之前调用，按|speedRef|和|PosErr|查表得到速度环增益，
+                     平滑后写入PI2。PI2为增量式，改增益不改变输出，只改变之后的增量，切换无扰。
+                     齿槽补偿学习和参数整定时不调度，使用其设定的增益
+    Date           : 2026-10-17
+    Parameter      : Ref: [输入] 速度给定(S_Value); Err: [输入] 位置误差(计数)
+    ------------------------------------------------------------------------------------------------- */
+void SpeedGainSched(int32 Ref, int32 Err)
 {
-    //    float PulsesErr;
-    //    float temp;
-    //
-    //    PulsesErr = mcSP.TargetPulsesNum - mcSP.PulsesNum;
-    //
-    //    if (PulsesErr >= mcSP.ACCPulsesNum)
-    //    {
-    //        if (mcSP.Speed < (mcSP.TargetSpeed-mcSP.Acc))
-    //        {
-    //            mcSP.Speed += mcSP.Acc;
-    //            mcSP.AccReal = mcSP.Acc;
-    //        }
-    //    }
-    //    else  if (PulsesErr <= -mcSP.ACCPulsesNum)
-    //    {
-    //        if (mcSP.Speed > (-mcSP.TargetSpeed+mcSP.Acc))
-    //        {
-    //            mcSP.Speed  -= mcSP.Acc;
-    //            mcSP.AccReal = -mcSP.Acc;
-    //        }
-    //    }
-    //    else if (PulsesErr < mcSP.ACCPulsesNum && PulsesErr>1)
-    //    {
-    //        if (mcSP.Speed > mcSP.Acc)
-    //        {
-    //            mcSP.Speed  -= mcSP.Acc;
-    //            mcSP.AccReal = -mcSP.Acc;
-    //        }
-    //    }
-    //    else if(PulsesErr >= -mcSP.ACCPulsesNum && PulsesErr < -1)
-    //    {
-    //        if (mcSP.Speed < (-mcSP.Acc))
-    //        {
-    //            mcSP.Speed += mcSP.Acc;
-    //            mcSP.AccReal = mcSP.Acc;
-    //        }
-    //        else
-    //        {
-    //            mcSP.AccReal = 0;
-    //        }
-    //    }
-    //    else
-    //    {
-    //        mcSP.AccReal = 0;
-    //        mcSP.Speed = 0;
-    //    }
-    //
-    //    mcSP.PulsesNum = mcSP.PulsesNum + mcSP.Speed;
+    #if (GS_ENABLE)
+    uint16 KpS, KiS;
+    uint16 KpE, KiE;
+    uint32 Kp;
+    uint32 Ki;
+
+    if (CogComp.Busy || AutoTune.Busy)
+    {
+        return;
+    }
+
+    SpeedGainLookup(GSSpeedTab, Abs_F32(Ref), &KpS, &KiS);
+    SpeedGainLookup(GSErrTab, Abs_F32(Err), &KpE, &KiE);
+    mcGS.KpMul = (uint16)(((uint32)KpS * KpE) >> 8);
+    mcGS.KiMul = (uint16)(((uint32)KiS * KiE) >> 8);
+
+    Kp = ((uint32)AutoTune.SKp * mcGS.KpMul) >> 8;
+    Ki = ((uint32)AutoTune.SKi * mcGS.KiMul) >> 8;
+    mcGS.Kp = SpeedGainSlew(mcGS.Kp, (Kp > 0x7FFF) ? 0x7FFF : (uint16)Kp);
+    mcGS.Ki = SpeedGainSlew(mcGS.Ki, (Ki > 0x7FFF) ? 0x7FFF : (uint16)Ki);
+    PI2_KP  = mcGS.Kp;
+    PI2_KI  = mcGS.Ki;
+    #endif
+}
+
+/* 在Id前馈表中按X线性插值 */
+static int16 FieldWeakLookup(uint32 X)
+{
+    uint8  i;
+    uint16 F;
+
+    if (X >= FWIdTab[FW_POINTS - 1].X)
+    {
+        return FWIdTab[FW_POINTS - 1].Id;
+    }
+
+    for (i = 1; X > FWIdTab[i].X; i++)
+    {
+    }
+
+    F = (uint16)(((X - FWIdTab[i - 1].X) << 8) / (FWIdTab[i].X - FWIdTab[i - 1].X));
+    return FWIdTab[i - 1].Id + (int16)((((int32)FWIdTab[i].Id - FWIdTab[i - 1].Id) * F) >> 8);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : FieldWeaken
+    Description    : 在Speed_response中速度环计算之前调用，按|速度|查表得到Id前馈，|FOC__UQ|超过
+                     FW_UQ_LIM时积分出更负的Id，低于时向0回退，两者之和限幅于FW_ID_MIN~0后写入FOC_IDREF。
+                     负Id使q轴电压减小ωL|Id|，反电势接近母线电压时还能继续加速；静止和低速时Id为0
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void FieldWeaken(void)
+{
+    #if (FW_ENABLE)
+    int32 Id;
+    int16 Uq = FOC__UQ;
+
+    mcFW.Uq     = (Uq < 0) ? -Uq : Uq;
+    mcFW.IdFF   = FieldWeakLookup(Abs_F32(mcQEP.SpeedMFlt));
+    mcFW.IdAcc += (int32)FW_UQ_LIM - mcFW.Uq;
+
+    if (mcFW.IdAcc > 0)
+    {
+        mcFW.IdAcc = 0;
+    }
+
+    if (mcFW.IdAcc < FW_ID_ACC_MIN)
+    {
+        mcFW.IdAcc = FW_ID_ACC_MIN;
+    }
+
+    Id = (int32)mcFW.IdFF + (mcFW.IdAcc >> FW_KI_SHIFT);
+
+    if (Id < FW_ID_MIN)
+    {
+        Id = FW_ID_MIN;
+    }
+
+    mcFW.Id   = (int16)Id;
+    FOC_IDREF = mcFW.Id;
+    #endif
 }
 
 void mc_ramp(MCRAMP * hSpeedramp)
@@ -0,0 +1,566 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : AutoTune.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 电流环和速度环参数自整定、保存和VISCA应答。
+                     1. 电流环关闭，d轴电压从TUNE_UD1阶跃到TUNE_UD2，由两段稳态电流之差得到电阻，
+                        由阶跃后电流与稳态之差的积分得到时间常数L/R。
+                     2. 按TUNE_SPIN_LEVEL匀速运行，取平均Iq和平均速度，再以平均Iq为中心对Iq做
+                        继电振荡，由加速、减速半周期的平均加速度得到Kt/J和摩擦电流。
+                     3. 电流环按Kp = wc*L，Ki = wc*R，速度环按Kp = ws*J/Kt、零点ws/TUNE_SPD_ZERO计算。
+                        电流环参数在第1步后、速度环参数在第2步后立即使用，返回起点到位后保存，
+                        加速度前馈也在这时才使用并保存；中途失败或返回超时恢复原参数。带宽为0的环只辨识不改参数。
+                     81 01 06 29 0c 0c 0s 0s FF     开始整定，c为电流环带宽(x20Hz)，s为速度环带宽(Hz)，
+                                                    c和s都为0时恢复默认参数
+                     81 09 06 29 00 FF              -> 90 50 0s 电阻(mOhm) 电感(uH) Kt/J 摩擦电流(mA) FF
+                     81 09 06 29 01 FF              -> 90 50 0s DQKP DQKI SKP SKI FF
+                     s为AutoTune.State，其余各4个半字节。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+AUTO_TUNE xdata AutoTune;
+
+/* 恢复默认参数 */
+static void AutoTune_Default(void)
+{
+    AutoTune.DqKp = DQKP;
+    AutoTune.DqKi = DQKI;
+    AutoTune.SKp  = SKP;
+    AutoTune.SKi  = SKI;
+}
+
+/* 读取保存的参数，没有记录时使用默认值 */
+static void AutoTune_Load(void)
+{
+    uint8 Buf[8];
+
+    AutoTune_Default();
+
+    if (Param_Read(PARAM_KEY_GAIN, Buf))
+    {
+        AutoTune.DqKp = ((uint16)Buf[0] << 8) | Buf[1];
+        AutoTune.DqKi = ((uint16)Buf[2] << 8) | Buf[3];
+        AutoTune.SKp  = ((uint16)Buf[4] << 8) | Buf[5];
+        AutoTune.SKi  = ((uint16)Buf[6] << 8) | Buf[7];
+    }
+}
+
+#if (CALIB_TOOL_ENABLE)
+/* 当前速度反馈，与Speed_response中速度环使用的一致 */
+static int16 AutoTune_Speed(void)
+{
+    #if (Speed_Method == T_Method)
+    return mcFocCtrl.SpeedFlt;
+    #else
+    return mcQEP.SpeedMFlt;
+    #endif
+}
+
+/* 把正在使用的参数写入电流环和速度环 */
+static void AutoTune_Apply(void)
+{
+    EA = 0;
+    FOC_DQKP = AutoTune.DqKp;
+    FOC_DQKI = AutoTune.DqKi;
+    PI2_KP   = AutoTune.SKp;
+    PI2_KI   = AutoTune.SKi;
+    EA = 1;
+}
+
+/* 保存正在使用的参数 */
+static void AutoTune_Save(void)
+{
+    uint8 Buf[8];
+
+    Buf[0] = (uint8)(AutoTune.DqKp >> 8);
+    Buf[1] = (uint8)AutoTune.DqKp;
+    Buf[2] = (uint8)(AutoTune.DqKi >> 8);
+    Buf[3] = (uint8)AutoTune.DqKi;
+    Buf[4] = (uint8)(AutoTune.SKp >> 8);
+    Buf[5] = (uint8)AutoTune.SKp;
+    Buf[6] = (uint8)(AutoTune.SKi >> 8);
+    Buf[7] = (uint8)AutoTune.SKi;
+    Param_Write(PARAM_KEY_GAIN, Buf);
+}
+
+/* 由电阻和时间常数按带宽计算电流环参数 */
+static void AutoTune_CurGain(void)
+{
+    uint32 W;
+    uint32 X;
+
+    if (AutoTune.CurBw)
+    {
+        W = (uint32)AutoTune.CurBw * TUNE_CUR_BW_UNIT;
+        W = (W > TUNE_CUR_BW_MAX) ? TUNE_CUR_BW_MAX : W;
+        W = W * 62832 / 10000;                              //rad/s
+        X = W * AutoTune.TauQ8 / SAMP_FREQ;                 //wc * L/R，Q8
+        X = (X * AutoTune.Rq12) >> 8;
+        AutoTune.DqKp = (X > TUNE_KP_MAX) ? TUNE_KP_MAX : (uint16)X;
+        X = W * AutoTune.Rq12 / (SAMP_FREQ / 8);            //wc * R / fs，Q15
+        AutoTune.DqKi = (X > TUNE_KP_MAX) ? TUNE_KP_MAX : ((X == 0) ? 1 : (uint16)X);
+    }
+}
+
+/* 由Kt/J按带宽计算速度环参数和加速度前馈 */
+static void AutoTune_SpdGain(void)
+{
+    uint32 W;
+    uint32 X;
+
+    if (AutoTune.SpdBw)
+    {
+        W = (AutoTune.SpdBw > TUNE_SPD_BW_MAX) ? TUNE_SPD_BW_MAX : AutoTune.SpdBw;
+        W = W * 62832 / 10000;
+        X = W * (uint32)(4096.0 * 65536.0 / SPLAN_FREQ) / AutoTune.Kq16;   //ws / (Kt/J)，Q12
+        AutoTune.SKp = (X > TUNE_KP_MAX) ? TUNE_KP_MAX : (uint16)X;
+        X = (uint32)AutoTune.SKp * W / (uint32)(TUNE_SPD_ZERO * SPLAN_FREQ / 8);  //Kp * ws / (4 * fs)，Q15
+        AutoTune.SKi = (X > TUNE_KP_MAX) ? TUNE_KP_MAX : ((X == 0) ? 1 : (uint16)X);
+
+        AutoTune.Ka  = (uint16)((4UL * SPLAN_S_GAIN * 65536UL) / AutoTune.Kq16);   //加速度前馈同样按J/Kt，到位后才使用
+    }
+}
+
+/* 结束整定，恢复速度档位，成功时保存参数和加速度前馈，失败时恢复原参数 */
+static void AutoTune_Stop(uint8 Result)
+{
+    EA = 0;
+    AutoTune.Drive = 0;
+    AutoTune.Relay = 0;
+    AutoTune.Busy  = 0;
+    EA = 1;
+
+    if (Result == TUNE_FAIL)
+    {
+        AutoTune_Load();
+        AutoTune_Apply();
+        mcFF.Ka = Calib.Blk.FFKa;
+    }
+    else
+    {
+        AutoTune_Save();
+
+        if (AutoTune.SpdBw)
+        {
+            mcFF.Ka = AutoTune.Ka;
+            FF_Save();
+        }
+    }
+
+    Speed_Handle(AutoTune.SavedLevel);
+    AutoTune.State = Result;
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Init
+    Description    : 上电读取保存的参数，没有记录时使用CUSTOMER.h中的默认值，在MotorcontrolInit中调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Init(void)
+{
+    AutoTune.Busy  = 0;
+    AutoTune.Drive = 0;
+    AutoTune.Relay = 0;
+    AutoTune.State = TUNE_IDLE;
+    AutoTune.Rq12  = 0;
+    AutoTune.TauQ8 = 0;
+    AutoTune.Kq16  = 0;
+    AutoTune.If    = 0;
+    AutoTune_Load();
+}
+
+#if (CALIB_TOOL_ENABLE)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Start
+    Description    : 开始整定。只在编码器角度闭环的电流闭环中有效，到位锁定由Uart_Dispatch先退出，整定期间不再进入，只在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : CurBw: [输入] 电流环带宽，单位TUNE_CUR_BW_UNIT; SpdBw: [输入] 速度环带宽(Hz)
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Start(uint8 CurBw, uint8 SpdBw)
+{
+    if ((mcState != mcRun) || !GP42 || (HoldCtrl.Mode != HOLD_IQ) || AutoTune.Busy || EncComp.Sweep || CogComp.Busy)
+    {
+        return;
+    }
+
+    AutoTune.CurBw      = CurBw;
+    AutoTune.SpdBw      = SpdBw;
+    AutoTune.SavedLevel = Uart.Speed_Level;
+
+    EA = 0;
+    AutoTune.Start           = mcSP.TargetPulsesNum;
+    AutoTune.Cycle           = 0;
+    AutoTune.SumI1           = 0;
+    AutoTune.SumArea         = 0;
+    AutoTune.SumI2           = 0;
+    AutoTune.Busy            = 1;
+    AutoTune.Drive           = 1;
+    EA = 1;
+
+    AutoTune.State = TUNE_RL;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Clear
+    Description    : 恢复默认参数并保存，只在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Clear(void)
+{
+    if (AutoTune.Busy)
+    {
+        return;
+    }
+
+    AutoTune_Default();
+    AutoTune_Apply();
+    AutoTune_Save();
+    AutoTune.State = TUNE_IDLE;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Task
+    Description    : 整定状态机，在主循环中调用，辨识计算和参数计算都在这里完成
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Task(void)
+{
+    int32 I1;
+    int32 I2;
+    int32 Di;
+    int32 Area;
+    int32 Up;
+    int32 Dn;
+
+    if (!AutoTune.Busy)
+    {
+        return;
+    }
+
+    if (mcState != mcRun)
+    {
+        AutoTune_Stop(TUNE_FAIL);
+        return;
+    }
+
+    switch (AutoTune.State)
+    {
+        case TUNE_RL:
+            if (AutoTune.Drive)
+            {
+                break;
+            }
+
+            I1   = AutoTune.SumI1 >> TUNE_AVG_SHIFT;
+            I2   = AutoTune.SumI2 >> TUNE_AVG_SHIFT;
+            Di   = I2 - I1;
+
+            if (Di < TUNE_DI_MIN)                           //相线开路或电流采样方向不对
+            {
+                AutoTune_Stop(TUNE_FAIL);
+                break;
+            }
+
+            Up   = ((uint32)(TUNE_UD2 - TUNE_UD1) << 12) / Di;
+            AutoTune.Rq12 = (Up > 0xFFFF) ? 0xFFFF : (uint16)Up;
+            Area = (I2 << TUNE_AREA_SHIFT) - AutoTune.SumArea;
+            Area = (Area < 0) ? 0 : (int32)(((uint32)Area << 8) / Di) - TUNE_DELAY_Q8;
+            AutoTune.TauQ8 = (Area < 1) ? 1 : ((Area > TUNE_TAU_MAX) ? TUNE_TAU_MAX : (uint16)Area);
+            AutoTune_CurGain();                             //电流环先用新参数，继电辨识时Iq跟随更快
+            AutoTune_Apply();
+
+            Speed_Handle(TUNE_SPIN_LEVEL);
+            SpeedPlanSet(AutoTune.Start + TUNE_SPIN_CNT);
+            AutoTune.Ticks = 0;
+            AutoTune.State = TUNE_SPIN;
+            break;
+
+        case TUNE_SPIN:
+            EA = 0;
+
+            if ((mcSP.Acc != 0) || (mcSP.Speed == 0))
+            {
+                AutoTune.Ticks = 0;
+            }
+
+            Di = AutoTune.Ticks;
+            EA = 1;
+
+            if (mcSP.Done)                                  //没有进入匀速段就到位
+            {
+                AutoTune_Stop(TUNE_FAIL);
+            }
+            else if (Di >= TUNE_SETTLE_TICKS)
+            {
+                EA = 0;
+                AutoTune.IqSum  = 0;
+                AutoTune.SpdSum = 0;
+                AutoTune.Cnt    = 0;
+                EA = 1;
+                AutoTune.State  = TUNE_BIAS;
+            }
+            break;
+
+        case TUNE_BIAS:
+            if (AutoTune.Cnt < TUNE_BIAS_TICKS)             //累计满后AutoTune_Tick不再改
+            {
+                break;
+            }
+
+            AutoTune.Ib = (int16)(AutoTune.IqSum >> TUNE_BIAS_SHIFT);
+            AutoTune.V0 = (int16)(AutoTune.SpdSum >> TUNE_BIAS_SHIFT);
+
+            EA = 0;
+            AutoTune.Dir   = 1;
+            AutoTune.Skip  = 0;
+            AutoTune.Cnt   = 0;
+            AutoTune.DvUp  = 0;
+            AutoTune.DvDn  = 0;
+            AutoTune.TUp   = 0;
+            AutoTune.TDn   = 0;
+            AutoTune.IqHalf = 0;
+            AutoTune.IqUp  = 0;
+            AutoTune.IqDn  = 0;
+            AutoTune.Ticks = 0;
+            AutoTune.VSw   = 0;
+            AutoTune.Relay = 1;
+            EA = 1;
+            AutoTune.State = TUNE_RELAY;
+            break;
+
+        case TUNE_RELAY:
+            if (AutoTune.Relay)
+            {
+                break;
+            }
+
+            if ((AutoTune.Cnt < TUNE_RELAY_HALF) || (AutoTune.TUp == 0) || (AutoTune.TDn == 0))
+            {
+                AutoTune_Stop(TUNE_FAIL);                   //超时，规划在继电期间一直跟随转子，停在原地
+                break;
+            }
+
+            Up   = (AutoTune.DvUp << 8) / AutoTune.TUp;     //平均加速度，Q8
+            Dn   = (AutoTune.DvDn << 8) / AutoTune.TDn;
+            I1   = AutoTune.IqUp / AutoTune.TUp;            //平均实测电流，电流环跟不上继电给定时按实测计算
+            I2   = AutoTune.IqDn / AutoTune.TDn;
+            Area = I1 - I2;
+
+            if ((Area < TUNE_RELAY_IQ / 2) || (Up <= Dn))
+            {
+                AutoTune_Stop(TUNE_FAIL);
+                break;
+            }
+
+            Di = ((Up - Dn) << 8) / Area;                   //(Up - Dn) / (I1 - I2)，Q16
+            AutoTune.Kq16 = (Di > 0xFFFF) ? 0xFFFF : (uint16)Di;
+            AutoTune.If   = (int16)((I1 + I2) / 2 - ((Up + Dn) << 7) / AutoTune.Kq16);
+            AutoTune_SpdGain();                             //返回起点时已用新参数
+            AutoTune_Apply();
+
+            SpeedPlanSet(AutoTune.Start);
+            EA = 0;
+            AutoTune.Ticks = 0;
+            AutoTune.Cnt   = 0;
+            EA = 1;
+            AutoTune.State = TUNE_RETURN;
+            break;
+
+        case TUNE_RETURN:                                   //到位后再结束，避免返回途中的大误差被带入到位锁定
+            EA = 0;
+
+            if (!mcSP.Done || (mcSP.PulsesNum != AutoTune.Start)
+                || (mcFocCtrl.PosiErr > TUNE_HOLD_ERR) || (mcFocCtrl.PosiErr < -TUNE_HOLD_ERR))
+            {
+                AutoTune.Ticks = 0;
+            }
+
+            Di = AutoTune.Ticks;
+            EA = 1;
+
+            if (Di >= TUNE_SETTLE_TICKS)
+            {
+                AutoTune_Stop(TUNE_DONE);
+            }
+            else if (AutoTune.Cnt >= TUNE_RETURN_TIMEOUT)   //返回起点不能稳定，新参数不保存
+            {
+                AutoTune_Stop(TUNE_FAIL);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Step
+    Description    : 在DRV_ISR中AutoTune.Drive置位时调用，电流环已关闭，输出d轴电压阶跃并累计Id，
+                     结束时清Drive，下一个周期电流环从0无扰恢复
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Step(void)
+{
+    int16  Id = FOC__ID;
+    uint16 k;
+
+    FOC__UQ = 0;
+    AutoTune.Cycle++;
+
+    if (AutoTune.Cycle <= TUNE_STEP_TICKS)
+    {
+        FOC__UD = TUNE_UD1;
+
+        if (AutoTune.Cycle > TUNE_STEP_TICKS - (1 << TUNE_AVG_SHIFT))
+        {
+            AutoTune.SumI1 += Id;
+        }
+
+        return;
+    }
+
+    FOC__UD = TUNE_UD2;
+    k = AutoTune.Cycle - TUNE_STEP_TICKS;
+
+    if (k <= TUNE_AREA_TICKS)
+    {
+        AutoTune.SumArea += Id;
+    }
+
+    if (k > TUNE_STEP_TICKS - (1 << TUNE_AVG_SHIFT))
+    {
+        AutoTune.SumI2 += Id;
+    }
+
+    if (k >= TUNE_STEP_TICKS)
+    {
+        FOC__UD        = 0;
+        AutoTune.Drive = 0;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Relay
+    Description    : 在Speed_response中代替速度环调用，速度偏离V0超过回差后Iq在Ib两侧切换，
+                     统计每个半周期的速度变化和时长
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Relay(void)
+{
+    int16 V = AutoTune_Speed() - AutoTune.V0;
+
+    if (++AutoTune.Ticks >= TUNE_RELAY_TIMEOUT)
+    {
+        AutoTune.Relay = 0;
+        return;
+    }
+
+    AutoTune.IqHalf -= FOC__IQ;                             //FOC_IQREF = -mcIqref
+
+    if ((AutoTune.Dir > 0) ? (V >= TUNE_RELAY_HYS) : (V <= -TUNE_RELAY_HYS))
+    {
+        if (AutoTune.Skip < TUNE_RELAY_SKIP)
+        {
+            AutoTune.Skip++;
+        }
+        else if (AutoTune.Dir > 0)
+        {
+            AutoTune.DvUp += V - AutoTune.VSw;
+            AutoTune.TUp  += AutoTune.Ticks;
+            AutoTune.IqUp += AutoTune.IqHalf;
+            AutoTune.Cnt++;
+        }
+        else
+        {
+            AutoTune.DvDn += V - AutoTune.VSw;
+            AutoTune.TDn  += AutoTune.Ticks;
+            AutoTune.IqDn += AutoTune.IqHalf;
+            AutoTune.Cnt++;
+        }
+
+        AutoTune.VSw    = V;
+        AutoTune.IqHalf = 0;
+        AutoTune.Ticks  = 0;
+        AutoTune.Dir   = -AutoTune.Dir;
+
+        if (AutoTune.Cnt >= TUNE_RELAY_HALF)
+        {
+            AutoTune.Relay = 0;
+            return;
+        }
+    }
+
+    mcFocCtrl.mcIqref = AutoTune.Ib + ((AutoTune.Dir > 0) ? TUNE_RELAY_IQ : -TUNE_RELAY_IQ);
+    EA = 0;
+    CogComp.IqBase = -mcFocCtrl.mcIqref;
+    FOC_IQREF      = CogComp.IqBase + CogComp.Iq;
+    EA = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Tick
+    Description    : 在Speed_response中速度环输出之后调用，计等待时间，累计匀速段平均Iq和平均速度，
+                     返回起点时计超时
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Tick(void)
+{
+    if (AutoTune.Ticks < 0xFFFF)
+    {
+        AutoTune.Ticks++;
+    }
+
+    if ((AutoTune.State == TUNE_BIAS) && (AutoTune.Cnt < TUNE_BIAS_TICKS))
+    {
+        AutoTune.IqSum  += mcFocCtrl.mcIqref;
+        AutoTune.SpdSum += AutoTune_Speed();
+        AutoTune.Cnt++;
+    }
+    else if ((AutoTune.State == TUNE_RETURN) && (AutoTune.Cnt < 0xFFFF))
+    {
+        AutoTune.Cnt++;
+    }
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : AutoTune_Report
+    Description    : 填写整定状态和辨识结果或正在使用的参数到应答帧
+    Date           : 2026-10-17
+    Parameter      : Field: [输入] 0为辨识结果，1为正在使用的参数
+    ------------------------------------------------------------------------------------------------- */
+void AutoTune_Report(uint8 Field)
+{
+    uint32 R;
+
+    Uart.T_DATA[2] = AutoTune.State;
+
+    if (Field == 0)
+    {
+        R = (uint32)AutoTune.Rq12 * (uint16)mcFocCtrl.mcDcbusFlt / TUNE_R_DIV;
+        Uart_PutWord(3, (uint16)R);
+        Uart_PutWord(7, (uint16)(R * AutoTune.TauQ8 / TUNE_L_DIV));
+        Uart_PutWord(11, (uint16)(((uint32)AutoTune.Kq16 * TUNE_KJ_GAIN) >> 16));
+        Uart_PutWord(15, (uint16)((int32)AutoTune.If * 1000 / I_Value(1.0)));
+    }
+    else
+    {
+        Uart_PutWord(3, AutoTune.DqKp);
+        Uart_PutWord(7, AutoTune.DqKi);
+        Uart_PutWord(11, AutoTune.SKp);
+        Uart_PutWord(15, AutoTune.SKi);
+    }
+
+    Uart.T_Len = 20;
+    Uart.RxFSM = 1;
+}
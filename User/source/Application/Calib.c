@@ -0,0 +1,275 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : Calib.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 校准块的上电读取、迁移、保存和VISCA读写。
+                     参数记录区中有校准块时只用校准块；记录的CRC全部不对或块内标志、版本、长度、CRC不对时
+                     使用默认值并清除CALIB_F_ANGLE，上电走预定位重新学习零位角，用户零位为0即回到Z信号处，
+                     不按错误的零位做归零运动。没有校准块时从升级前的参数或零位页转换并立即保存。
+                     81 09 06 26 0f FF              -> 90 50 字段值 FF，8个半字节
+                     81 01 06 26 0f 0v*8 FF         写字段f并保存，f为CALIB_FIELD_xxx
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+CALIB xdata Calib;
+
+/* 默认值，零位角无效 */
+static void Calib_Default(void)
+{
+    Calib.Blk.Magic       = CALIB_MAGIC;
+    Calib.Blk.Version     = CALIB_VERSION;
+    Calib.Blk.Len         = CALIB_LEN;
+    Calib.Blk.Flags       = 0;
+    Calib.Blk.AngleFlt    = 0;
+    Calib.Blk.ZeroNewCntr = 0;
+    Calib.Blk.FFKv        = FF_KV_DEFAULT;
+    Calib.Blk.FFKa        = FF_KA_DEFAULT;
+    Calib.Blk.Crc         = 0;
+}
+
+/* 校准块按Flash格式排列到Buf，不含CRC */
+static void Calib_Pack(CALIB_BLOCK *Blk, uint8 *Buf)
+{
+    Buf[0]  = Blk->Magic;
+    Buf[1]  = Blk->Version;
+    Buf[2]  = Blk->Len;
+    Buf[3]  = Blk->Flags;
+    Buf[4]  = Blk->AngleFlt >> 8;
+    Buf[5]  = Blk->AngleFlt;
+    Buf[6]  = Blk->ZeroNewCntr >> 24;
+    Buf[7]  = Blk->ZeroNewCntr >> 16;
+    Buf[8]  = Blk->ZeroNewCntr >> 8;
+    Buf[9]  = Blk->ZeroNewCntr;
+    Buf[10] = Blk->FFKv >> 8;
+    Buf[11] = Blk->FFKv;
+    Buf[12] = Blk->FFKa >> 8;
+    Buf[13] = Blk->FFKa;
+}
+
+/* 检查Flash格式的校准块，有效时写入Calib.Blk并返回1，否则Calib.Blk不变 */
+static uint8 Calib_Unpack(uint8 *Buf)
+{
+    CALIB_BLOCK Blk;
+
+    Blk.Magic   = Buf[0];
+    Blk.Version = Buf[1];
+    Blk.Len     = Buf[2];
+    Blk.Crc     = ((uint16)Buf[CALIB_LEN - 2] << 8) | Buf[CALIB_LEN - 1];
+
+    if ((Blk.Magic != CALIB_MAGIC) || (Blk.Len != CALIB_LEN)
+        || (Param_Crc(Buf, CALIB_LEN - 2) != Blk.Crc))
+    {
+        return 0;
+    }
+
+    switch (Blk.Version)
+    {
+        case CALIB_VERSION:
+            Blk.Flags       = Buf[3];
+            Blk.AngleFlt    = ((int16)Buf[4] << 8) | Buf[5];
+            Blk.ZeroNewCntr = ((int32)Buf[6] << 24) | ((int32)Buf[7] << 16) | ((int32)Buf[8] << 8) | Buf[9];
+            Blk.FFKv        = ((uint16)Buf[10] << 8) | Buf[11];
+            Blk.FFKa        = ((uint16)Buf[12] << 8) | Buf[13];
+            break;
+
+        default:                                            //未知版本
+            return 0;
+    }
+
+    Calib.Blk = Blk;
+    return 1;
+}
+
+/* 从升级前的参数(PARAM_KEY_ANGLE/ZERO/FF)或零位页转换，有任何一项时返回1 */
+static uint8 Calib_Migrate(void)
+{
+    uint8 Data[6];
+    uint8 Found = 0;
+    uint8 Sum   = 0;
+    uint8 i;
+
+    if (Param_Read(PARAM_KEY_ANGLE, Data))
+    {
+        Calib.Blk.AngleFlt = ((int16)Data[0] << 8) | Data[1];
+        Calib.Blk.Flags   |= CALIB_F_ANGLE;
+        Found              = 1;
+
+        if (Param_Read(PARAM_KEY_ZERO, Data))               //自学习只保存零位角时用户零位为0
+        {
+            Calib.Blk.ZeroNewCntr = ((int32)Data[0] << 24) | ((int32)Data[1] << 16) | ((int32)Data[2] << 8) | Data[3];
+        }
+    }
+    else
+    {
+        for (i = 0; i < 6; i++)
+        {
+            Data[i] = *(uint8 code *)(STARTPAGEROMADDRESS + i);
+            Sum    |= Data[i];
+        }
+
+        if (Sum != 0)                                       //零位页擦除后全为0，视为没有学习过
+        {
+            Calib.Blk.AngleFlt    = ((int16)Data[0] << 8) | Data[1];
+            Calib.Blk.ZeroNewCntr = ((int32)Data[2] << 24) | ((int32)Data[3] << 16) | ((int32)Data[4] << 8) | Data[5];
+            Calib.Blk.Flags      |= CALIB_F_ANGLE;
+            Found                 = 1;
+        }
+    }
+
+    if (Param_Read(PARAM_KEY_FF, Data))
+    {
+        Calib.Blk.FFKv = ((uint16)Data[0] << 8) | Data[1];
+        Calib.Blk.FFKa = ((uint16)Data[2] << 8) | Data[3];
+        Found          = 1;
+    }
+
+    return Found;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Calib_Load
+    Description    : 上电读取校准块到Calib，在MotorcontrolInit中Param_Init之后、使用零位和前馈增益之前调用。
+                     转换来的校准块立即保存，旧参数从记录区中删除；损坏的校准块不覆盖，等重新学习后再保存。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Calib_Load(void)
+{
+    uint8 Buf[CALIB_LEN];
+
+    Calib_Default();
+
+    if (Param_Read(PARAM_KEY_CALIB, Buf))
+    {
+        Calib.Status = Calib_Unpack(Buf) ? CALIB_OK : CALIB_CORRUPT;
+    }
+    else if (Param.Bad & (1 << PARAM_KEY_CALIB))
+    {
+        Calib.Status = CALIB_CORRUPT;
+    }
+    else if (Calib_Migrate())
+    {
+        Calib.Status = CALIB_MIGRATED;
+        Calib_Save();
+        Param_Drop(PARAM_KEY_ANGLE);
+        Param_Drop(PARAM_KEY_ZERO);
+        Param_Drop(PARAM_KEY_FF);
+    }
+    else
+    {
+        Calib.Status = CALIB_EMPTY;
+    }
+
+    Calib.Relearn = !(Calib.Blk.Flags & CALIB_F_ANGLE);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Calib_Save
+    Description    : 补齐标志、版本、长度和CRC后整块写入参数记录区，由Param_Task在后台烧写。只在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Calib_Save(void)
+{
+    uint8 Buf[CALIB_LEN];
+
+    Calib.Blk.Magic   = CALIB_MAGIC;
+    Calib.Blk.Version = CALIB_VERSION;
+    Calib.Blk.Len     = CALIB_LEN;
+    Calib_Pack(&Calib.Blk, Buf);
+    Calib.Blk.Crc     = Param_Crc(Buf, CALIB_LEN - 2);
+    Buf[CALIB_LEN - 2] = Calib.Blk.Crc >> 8;
+    Buf[CALIB_LEN - 1] = Calib.Blk.Crc;
+    Param_Write(PARAM_KEY_CALIB, Buf);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Calib_Report
+    Description    : 填写字段Field的值到应答帧，编号越界时回复无效指令
+    Date           : 2026-10-17
+    Parameter      : Field: [输入] CALIB_FIELD_xxx
+    ------------------------------------------------------------------------------------------------- */
+void Calib_Report(uint8 Field)
+{
+    uint32 Value;
+    uint8  i;
+
+    switch (Field)
+    {
+        case CALIB_FIELD_ANGLE:
+            Value = (uint32)(int32)Calib.Blk.AngleFlt;
+            break;
+
+        case CALIB_FIELD_ZERO:
+            Value = (uint32)Calib.Blk.ZeroNewCntr;
+            break;
+
+        case CALIB_FIELD_KV:
+            Value = Calib.Blk.FFKv;
+            break;
+
+        case CALIB_FIELD_KA:
+            Value = Calib.Blk.FFKa;
+            break;
+
+        case CALIB_FIELD_STATUS:
+            Value = ((uint32)Calib.Blk.Version << 16) | ((uint16)Calib.Blk.Flags << 8) | Calib.Status;
+            break;
+
+        default:
+            Send_NoActive();
+            return;
+    }
+
+    for (i = 0; i < 8; i++)
+    {
+        Uart.T_DATA[2 + i] = (Value >> (28 - (i << 2))) & 0x0F;
+    }
+
+    Uart.T_Len = 11;
+    Uart.RxFSM = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Calib_Set
+    Description    : 串口写字段Field并保存校准块，同时更新运行中的变量；只读或越界的编号不处理。
+                     写零位角后下次上电不再重新学习。
+    Date           : 2026-10-17
+    Parameter      : Field: [输入] CALIB_FIELD_xxx; Value: [输入] 字段值
+    ------------------------------------------------------------------------------------------------- */
+void Calib_Set(uint8 Field, int32 Value)
+{
+    switch (Field)
+    {
+        case CALIB_FIELD_ANGLE:
+            Calib.Blk.AngleFlt  = (int16)Value;
+            Calib.Blk.Flags    |= CALIB_F_ANGLE;
+            mcQEP.AngleFlt      = Calib.Blk.AngleFlt;       //下次启动时生效
+            break;
+
+        case CALIB_FIELD_ZERO:
+            Calib.Blk.ZeroNewCntr = Value;
+            EA = 0;                                         //Uart_StreamRx在中断中使用
+            mcQEP.ZeroNewCntr     = Value;
+            EA = 1;
+            break;
+
+        case CALIB_FIELD_KV:
+            Calib.Blk.FFKv = (uint16)Value;
+            mcFF.Kv        = Calib.Blk.FFKv;
+            break;
+
+        case CALIB_FIELD_KA:
+            Calib.Blk.FFKa = (uint16)Value;
+            mcFF.Ka        = Calib.Blk.FFKa;
+            break;
+
+        default:
+            return;
+    }
+
+    Calib_Save();
+}
@@ -0,0 +1,468 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : CogComp.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 齿槽转矩补偿表的学习、保存、速度波动测试和VISCA应答。
+                     学习在主循环中按CogComp_Task推进：每格定位、等速度环稳定后取平均保持电流，
+                     逐字节烧写到Flash表。每格都从同一方向到位，静摩擦带来的偏置对各格相同，
+                     作为均值从表中减去。学习结束后自动做一次速度波动测试。
+                     81 01 06 28 01 FF              学习补偿表并测试，运行状态下有效，约需3分钟
+                     81 01 06 28 02 FF              只测试补偿前后的速度波动，需有补偿表
+                     81 01 06 28 00 FF              清除补偿表
+                     81 09 06 28 FF                 -> 90 50 0s 已学习格数 补偿前 补偿后 FF
+                     s为CogComp.State，速度误差均方根为S_Value，各4个半字节。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+COG_COMP xdata CogComp;
+
+/* 打开或关闭DRV_ISR中的补偿，关闭时补偿电流清零 */
+static void CogComp_Switch(uint8 On)
+{
+    EA = 0;
+    CogComp.On = On;
+
+    if (!On)
+    {
+        CogComp.Iq = 0;
+    }
+
+    EA = 1;
+}
+
+/* 表中第Sector个扇区累加到CRC16-CCITT-FALSE，软件逐位计算，不关UART2中断，也不占用Uart_StreamRx使用的CRC单元 */
+static uint16 CogComp_CrcSector(uint16 Crc, uint8 Sector)
+{
+    uint8 code *Buf = (uint8 code *)(COGROMADDRESS + (uint16)Sector * PARAM_SECTOR_SIZE);
+    uint8 i;
+    uint8 k;
+
+    for (i = 0; i < PARAM_SECTOR_SIZE; i++)
+    {
+        Crc ^= (uint16)Buf[i] << 8;
+
+        for (k = 0; k < 8; k++)
+        {
+            Crc = (Crc & 0x8000) ? ((Crc << 1) ^ 0x1021) : (Crc << 1);
+        }
+    }
+
+    return Crc;
+}
+
+#if (CALIB_TOOL_ENABLE)
+/* 定位到Goal，重新开始计等待时间 */
+static void CogComp_Goto(int32 Goal)
+{
+    CogComp.Goal = Goal;
+    EA = 0;
+    mcSP.TargetPulsesNum = Goal;
+    CogComp.Ticks        = 0;
+    CogComp.Wait         = 0;
+    EA = 1;
+}
+
+/* 位置给定到达Goal以来的SysTick周期数，未到达时为0 */
+static uint8 CogComp_Settled(void)
+{
+    uint8 Ticks;
+
+    EA = 0;
+
+    if (!mcSP.Done || (mcSP.PulsesNum != CogComp.Goal))
+    {
+        CogComp.Ticks = 0;
+    }
+
+    Ticks = CogComp.Ticks;
+    EA = 1;
+
+    return Ticks;
+}
+
+/* 本次定位已等待Limit个SysTick周期，位置给定被其他指令改走或一直不稳定 */
+static uint8 CogComp_Timeout(uint16 Limit)
+{
+    uint16 Wait;
+
+    EA = 0;
+    Wait = CogComp.Wait;
+    EA = 1;
+
+    return Wait >= Limit;
+}
+
+/* 保存表的格数、均值和CRC，Bins为0表示无补偿表 */
+static void CogComp_Save(uint16 Bins, uint16 Crc)
+{
+    uint8  Buf[6];
+
+    Buf[0] = (uint8)(Bins >> 8);
+    Buf[1] = (uint8)Bins;
+    Buf[2] = (uint8)((uint16)CogComp.Mean >> 8);
+    Buf[3] = (uint8)CogComp.Mean;
+    Buf[4] = (uint8)(Crc >> 8);
+    Buf[5] = (uint8)Crc;
+    Param_Write(PARAM_KEY_COG, Buf);
+}
+
+/* 开始速度波动测试的一段：0为不补偿正转，1为返回起点，2为补偿后正转 */
+static void CogComp_RippleStart(uint8 Phase)
+{
+    CogComp_Switch((Phase == 2) && CogComp.Valid);
+
+    EA = 0;
+    CogComp.RipSum   = 0;
+    CogComp.RipSq    = 0;
+    CogComp.RipCnt   = 0;
+    CogComp.RipPhase = Phase;
+    EA = 1;
+
+    CogComp_Goto(CogComp.Goal + ((Phase == 1) ? -COG_RIPPLE_CNT : COG_RIPPLE_CNT));
+}
+
+/* 本段匀速部分速度误差的均方根，去掉平均值 */
+static uint16 CogComp_Rms(void)
+{
+    int32  Mean;
+    uint32 Sq;
+
+    if (CogComp.RipCnt == 0)
+    {
+        return 0;
+    }
+
+    Mean = CogComp.RipSum / CogComp.RipCnt;
+    Sq   = CogComp.RipSq / CogComp.RipCnt;
+    Sq   = (Sq > (uint32)(Mean * Mean)) ? (Sq - (uint32)(Mean * Mean)) : 0;
+
+    return Sqrt_U32(Sq);
+}
+
+/* 结束学习或测试，恢复速度环积分系数和速度档位 */
+static void CogComp_Stop(uint8 Result)
+{
+    EA = 0;
+    PI2_KI         = AutoTune.SKi;
+    CogComp.Sample = 0;
+    CogComp.Busy   = 0;
+    EA = 1;
+
+    Speed_Handle(CogComp.SavedLevel);
+    CogComp.State = Result;
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : CogComp_Init
+    Description    : 上电读取补偿表记录并校验Flash表，在MotorcontrolInit中Param_Init之后调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void CogComp_Init(void)
+{
+    uint8  Buf[6];
+    uint16 Crc = 0xFFFF;
+    uint8  i;
+
+    CogComp.Valid = 0;
+    CogComp.On    = 0;
+    CogComp.Busy  = 0;
+    CogComp.Iq    = 0;
+    CogComp.Mean  = 0;
+    CogComp.Cnt   = 0;
+
+    for (i = 0; i < COG_SECTOR_NUM; i++)
+    {
+        Crc = CogComp_CrcSector(Crc, i);
+    }
+
+    if (Param_Read(PARAM_KEY_COG, Buf)
+        && ((((uint16)Buf[0] << 8) | Buf[1]) == COG_BIN_NUM)
+        && ((((uint16)Buf[4] << 8) | Buf[5]) == Crc))
+    {
+        CogComp.Mean  = (int16)(((uint16)Buf[2] << 8) | Buf[3]);
+        CogComp.Cnt   = COG_BIN_NUM;
+        CogComp.Valid = 1;
+    }
+
+    CogComp.State = CogComp.Valid ? COG_DONE : COG_IDLE;
+}
+
+#if (CALIB_TOOL_ENABLE)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : CogComp_Start
+    Description    : 开始学习补偿表或速度波动测试。到位锁定中不开始，由Uart_Dispatch先退出，学习期间不再进入，只在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : Mode: [输入] 1为学习并测试，2为只测试
+    ------------------------------------------------------------------------------------------------- */
+void CogComp_Start(uint8 Mode)
+{
+    if ((mcState != mcRun) || !GP42 || (HoldCtrl.Mode != HOLD_IQ) || CogComp.Busy || EncComp.Sweep || AutoTune.Busy
+        || ((Mode == 2) && !CogComp.Valid))
+    {
+        return;
+    }
+
+    CogComp.SavedLevel = Uart.Speed_Level;
+    CogComp.Before     = 0;
+    CogComp.After      = 0;
+
+    EA = 0;
+    CogComp.Goal             = mcSP.TargetPulsesNum;
+    CogComp.Busy             = 1;
+    EA = 1;
+
+    if (Mode == 2)
+    {
+        Speed_Handle(COG_RIPPLE_LEVEL);
+        CogComp_RippleStart(0);
+        CogComp.State = COG_RIPPLE;
+        return;
+    }
+
+    CogComp_Switch(0);
+    CogComp.Valid  = 0;
+    CogComp.Cnt    = 0;
+    CogComp.Sector = 0;
+    EA = 0;
+    PI2_KI = COG_LEARN_KI;
+    EA = 1;
+    Speed_Handle(COG_LEARN_LEVEL);
+    CogComp.State  = COG_ERASE;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : CogComp_Clear
+    Description    : 清除补偿表，保存格数为0的记录，只在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void CogComp_Clear(void)
+{
+    if (CogComp.Busy)
+    {
+        return;
+    }
+
+    CogComp_Switch(0);
+    CogComp.Valid = 0;
+    CogComp.Mean  = 0;
+    CogComp.Cnt   = 0;
+    CogComp_Save(0, 0);
+    CogComp.State = COG_IDLE;
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : CogComp_Task
+    Description    : 学习和测试的状态机，主循环中每次执行一步，每步最多擦除一个扇区、烧写一个字节或计算一个扇区的CRC
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void CogComp_Task(void)
+{
+    #if (CALIB_TOOL_ENABLE)
+    int16  Val;
+    uint16 Mech;
+    uint16 Addr;
+    #endif
+
+    if (!CogComp.Busy)
+    {
+        if (CogComp.On != (CogComp.Valid && (Learn.State == LearnOver)))   //上电找到Z之后打开
+        {
+            CogComp_Switch(!CogComp.On);
+        }
+
+        return;
+    }
+
+    #if (CALIB_TOOL_ENABLE)
+    if (mcState != mcRun)                                   //学习中停机或故障，未写完的表CRC不对，上电不会使用
+    {
+        CogComp_Stop(COG_FAIL);
+        return;
+    }
+
+    switch (CogComp.State)
+    {
+        case COG_ERASE:
+            Flash_Sector_Erase((uint8 xdata *)(COGROMADDRESS + (uint16)CogComp.Sector * PARAM_SECTOR_SIZE));
+
+            if (++CogComp.Sector < COG_SECTOR_NUM)
+            {
+                break;
+            }
+
+            EA = 0;
+            Mech         = mcQEP.MechCntr;
+            CogComp.Base = mcQEP.CntrSumReal - Mech;
+            EA = 1;
+
+            CogComp.First  = (Mech >> COG_BIN_SHIFT) + 1;   //从前方最近的格开始，每格都正向到位
+            CogComp.TabSum = 0;
+            CogComp_Goto(CogComp.Base + ((int32)CogComp.First << COG_BIN_SHIFT));
+            CogComp.State  = COG_MOVE;
+            break;
+
+        case COG_MOVE:
+            if (CogComp_Settled() >= COG_SETTLE_TICKS)
+            {
+                EA = 0;
+                CogComp.IqSum  = 0;
+                CogComp.IqCnt  = 0;
+                CogComp.Sample = 1;
+                EA = 1;
+                CogComp.State  = COG_SAMPLE;
+            }
+            else if (CogComp_Timeout(COG_MOVE_TIMEOUT))
+            {
+                CogComp_Stop(COG_FAIL);
+            }
+            break;
+
+        case COG_SAMPLE:
+            if (CogComp.IqCnt < COG_AVG_TICKS)              //累计满后Speed_response不再改IqSum
+            {
+                break;
+            }
+
+            CogComp.Sample = 0;
+            Val  = (int16)(CogComp.IqSum >> (COG_AVG_SHIFT + COG_IQ_SHIFT));
+            Val  = (Val > 127) ? 127 : ((Val < -127) ? -127 : Val);
+            Addr = COGROMADDRESS + ((CogComp.First + CogComp.Cnt) & (COG_BIN_NUM - 1));
+            Flash_Sector_Write((uint8 xdata *)Addr, (uint8)Val);
+
+            if (*(uint8 code *)(Addr) != (uint8)Val)
+            {
+                CogComp_Stop(COG_FAIL);
+                break;
+            }
+
+            CogComp.TabSum += Val;
+
+            if (++CogComp.Cnt < COG_BIN_NUM)
+            {
+                CogComp_Goto(CogComp.Goal + (1 << COG_BIN_SHIFT));
+                CogComp.State = COG_MOVE;
+                break;
+            }
+
+            CogComp.Mean   = (int16)((CogComp.TabSum << COG_IQ_SHIFT) / COG_BIN_NUM);
+            CogComp.Crc    = 0xFFFF;
+            CogComp.Sector = 0;
+            CogComp.State  = COG_CRC;
+            break;
+
+        case COG_CRC:
+            CogComp.Crc = CogComp_CrcSector(CogComp.Crc, CogComp.Sector);
+
+            if (++CogComp.Sector < COG_SECTOR_NUM)
+            {
+                break;
+            }
+
+            CogComp.Valid = 1;
+            CogComp_Save(COG_BIN_NUM, CogComp.Crc);
+            EA = 0;
+            PI2_KI = AutoTune.SKi;
+            EA = 1;
+            Speed_Handle(COG_RIPPLE_LEVEL);
+            CogComp_RippleStart(0);
+            CogComp.State = COG_RIPPLE;
+            break;
+
+        case COG_RIPPLE:
+            if (CogComp_Settled() == 0)
+            {
+                if (CogComp_Timeout(COG_RIPPLE_TIMEOUT))
+                {
+                    CogComp_Stop(COG_FAIL);
+                }
+                break;
+            }
+
+            if (CogComp.RipPhase == 0)
+            {
+                CogComp.Before = CogComp_Rms();
+                CogComp_RippleStart(1);
+            }
+            else if (CogComp.RipPhase == 1)
+            {
+                CogComp_RippleStart(2);
+            }
+            else
+            {
+                CogComp.After = CogComp_Rms();
+                CogComp_Stop(COG_DONE);
+            }
+            break;
+
+        default:
+            break;
+    }
+    #endif
+}
+
+#if (CALIB_TOOL_ENABLE)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : CogComp_Tick
+    Description    : 在Speed_response中速度环输出之后调用，计等待时间，累计保持电流和匀速段速度误差
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void CogComp_Tick(void)
+{
+    int32 Err;
+
+    if (CogComp.Ticks < 255)
+    {
+        CogComp.Ticks++;
+    }
+
+    if (CogComp.Wait < 0xFFFF)
+    {
+        CogComp.Wait++;
+    }
+
+    if (CogComp.Sample && (CogComp.IqCnt < COG_AVG_TICKS))
+    {
+        CogComp.IqSum -= mcFocCtrl.mcIqref;                 //FOC_IQREF = -mcIqref
+        CogComp.IqCnt++;
+    }
+
+    if ((CogComp.State == COG_RIPPLE) && (CogComp.RipPhase != 1) && (mcSP.Acc == 0) && (mcSP.Speed != 0)
+        && (CogComp.RipCnt < COG_RIPPLE_MAX))
+    {
+        #if (Speed_Method == T_Method)
+        Err = SPLAN_SPEED_TO_S(mcSP.Speed) - mcFocCtrl.SpeedFlt;
+        #else
+        Err = SPLAN_SPEED_TO_S(mcSP.Speed) - mcQEP.SpeedMFlt;
+        #endif
+        Err = (Err > COG_RIPPLE_ERR) ? COG_RIPPLE_ERR : ((Err < -COG_RIPPLE_ERR) ? -COG_RIPPLE_ERR : Err);
+        CogComp.RipSum += Err;
+        CogComp.RipSq  += (uint32)(Err * Err);
+        CogComp.RipCnt++;
+    }
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : CogComp_Report
+    Description    : 填写学习状态、已学习格数和补偿前后的速度误差均方根到应答帧
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void CogComp_Report(void)
+{
+    Uart.T_DATA[2] = CogComp.State;
+    Uart_PutWord(3, CogComp.Cnt);
+    Uart_PutWord(7, CogComp.Before);
+    Uart_PutWord(11, CogComp.After);
+    Uart.T_Len = 16;
+    Uart.RxFSM = 1;
+}
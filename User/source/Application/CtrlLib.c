@@ -0,0 +1,223 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : CtrlLib.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 定点PID与速度档位换算。Ctrl_Pid在SYStick_INT中调用，使用MDU；DRV_ISR也使用MDU，
+                     与Speed_response中已有的LPF_MDU一样，依赖DRV_ISR在每次MDU运算完成后才读写结果。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+/* 档位 -> S_Value，与原来的S_Value(level * 0.83 + 0.333)浮点计算一致，编译时生成 */
+#define LEVEL_SPEED(n)                  S_Value(((n) * SPEED_LEVEL_K + SPEED_LEVEL_B))
+#define LEVEL_SPEED8(n)                 LEVEL_SPEED(n),     LEVEL_SPEED(n + 1), LEVEL_SPEED(n + 2), LEVEL_SPEED(n + 3), \
+                                        LEVEL_SPEED(n + 4), LEVEL_SPEED(n + 5), LEVEL_SPEED(n + 6), LEVEL_SPEED(n + 7)
+
+static int16 code LevelSpeedTab[SPEED_LEVEL_MAX + 1] =
+{
+    LEVEL_SPEED8(0x00), LEVEL_SPEED8(0x08), LEVEL_SPEED8(0x10), LEVEL_SPEED8(0x18),
+    LEVEL_SPEED8(0x20), LEVEL_SPEED8(0x28), LEVEL_SPEED8(0x30), LEVEL_SPEED8(0x38),
+    LEVEL_SPEED8(0x40), LEVEL_SPEED8(0x48), LEVEL_SPEED8(0x50), LEVEL_SPEED8(0x58),
+    LEVEL_SPEED8(0x60), LEVEL_SPEED8(0x68), LEVEL_SPEED8(0x70), LEVEL_SPEED8(0x78),
+    LEVEL_SPEED8(0x80), LEVEL_SPEED8(0x88), LEVEL_SPEED(0x90),
+};
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_Sat16
+    Description    : 32位值限幅到int16
+    Date           : 2026-10-17
+    Parameter      : Value: [输入]
+    ------------------------------------------------------------------------------------------------- */
+int16 Ctrl_Sat16(int32 Value)
+{
+    if (Value > 32767)
+    {
+        return 32767;
+    }
+
+    if (Value < -32768)
+    {
+        return -32768;
+    }
+
+    return (int16)Value;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_MulS
+    Description    : MDU有符号乘法，返回32位乘积
+    Date           : 2026-10-17
+    Parameter      : A: [输入]
+                     B: [输入]
+    ------------------------------------------------------------------------------------------------- */
+static int32 Ctrl_MulS(int16 A, int16 B)
+{
+    uint16 H, L;
+
+    MuiltS_MDU(A, B, H, L);
+    return (int32)(((uint32)H << 16) | L);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_PidInit
+    Description    : 设置增益和输出限幅并清零状态，OutMin须不大于零、OutMax须不小于零
+    Date           : 2026-10-17
+    Parameter      : Pid: [输入/输出]
+                     Kp, Ki, Kd: [输入] 增益，Q12/Q15/Q12
+                     OutMin, OutMax: [输入] 输出限幅
+    ------------------------------------------------------------------------------------------------- */
+void Ctrl_PidInit(CTRL_PID xdata *Pid, int16 Kp, int16 Ki, int16 Kd, int16 OutMin, int16 OutMax)
+{
+    Pid->Kp     = Kp;
+    Pid->Ki     = Ki;
+    Pid->Kd     = Kd;
+    Pid->OutMin = OutMin;
+    Pid->OutMax = OutMax;
+    Ctrl_PidReset(Pid);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_PidReset
+    Description    : 清零积分和上一次的误差，增益和限幅不变
+    Date           : 2026-10-17
+    Parameter      : Pid: [输入/输出]
+    ------------------------------------------------------------------------------------------------- */
+void Ctrl_PidReset(CTRL_PID xdata *Pid)
+{
+    Pid->ErrLast  = 0;
+    Pid->Integral = 0;
+    Pid->Out      = 0;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_Pid
+    Description    : Out = (Kp * Err >> 12) + (Integral >> 15) + (Kd * (Err - ErrLast) >> 12)，限幅到
+                     [OutMin, OutMax]。积分限制在输出限幅以内；输出饱和时若本次误差使输出继续向饱和方向
+                     变化(Ki不小于零)，积分保持上一次的值
+    Date           : 2026-10-17
+    Parameter      : Pid: [输入/输出]
+                     Err: [输入] 误差
+    ------------------------------------------------------------------------------------------------- */
+int16 Ctrl_Pid(CTRL_PID xdata *Pid, int16 Err)
+{
+    int32 Out;
+    int32 Integral;
+    int32 Lim;
+
+    Out = Ctrl_MulS(Err, Pid->Kp) >> 12;
+
+    Integral = Pid->Integral;
+
+    if (Pid->Ki != 0)
+    {
+        Integral += Ctrl_MulS(Err, Pid->Ki);                // |Ki * Err| < 2^30，积分不超过2^30，和不会溢出
+        Lim = (int32)Pid->OutMax << 15;
+
+        if (Integral > Lim)
+        {
+            Integral = Lim;
+        }
+
+        Lim = (int32)Pid->OutMin << 15;
+
+        if (Integral < Lim)
+        {
+            Integral = Lim;
+        }
+
+        Out += Integral >> 15;
+    }
+
+    if (Pid->Kd != 0)
+    {
+        Out += Ctrl_MulS(Ctrl_Sat16((int32)Err - Pid->ErrLast), Pid->Kd) >> 12;
+    }
+
+    Pid->ErrLast = Err;
+
+    if (Out > Pid->OutMax)
+    {
+        Out = Pid->OutMax;
+
+        if (Err > 0)
+        {
+            Integral = Pid->Integral;
+        }
+    }
+    else if (Out < Pid->OutMin)
+    {
+        Out = Pid->OutMin;
+
+        if (Err < 0)
+        {
+            Integral = Pid->Integral;
+        }
+    }
+
+    Pid->Integral = Integral;
+    Pid->Out      = (int16)Out;
+
+    return Pid->Out;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_LevelToSpeed
+    Description    : 速度档位换算为S_Value，超过SPEED_LEVEL_MAX按SPEED_LEVEL_MAX
+    Date           : 2026-10-17
+    Parameter      : Level: [输入]
+    ------------------------------------------------------------------------------------------------- */
+int16 Ctrl_LevelToSpeed(uint8 Level)
+{
+    if (Level > SPEED_LEVEL_MAX)
+    {
+        Level = SPEED_LEVEL_MAX;
+    }
+
+    return LevelSpeedTab[Level];
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Ctrl_SpeedToLevel
+    Description    : 转速(S_Value)换算为最接近的速度档位，二分查表，不计方向
+    Date           : 2026-10-17
+    Parameter      : Speed: [输入]
+    ------------------------------------------------------------------------------------------------- */
+uint8 Ctrl_SpeedToLevel(int16 Speed)
+{
+    uint8 Lo = 0;
+    uint8 Hi = SPEED_LEVEL_MAX;
+    uint8 Mid;
+
+    if (Speed < 0)
+    {
+        Speed = (Speed == -32768) ? 32767 : -Speed;
+    }
+
+    if (Speed <= LevelSpeedTab[0])
+    {
+        return 0;
+    }
+
+    if (Speed >= LevelSpeedTab[SPEED_LEVEL_MAX])
+    {
+        return SPEED_LEVEL_MAX;
+    }
+
+    while (Hi - Lo > 1)                                     // LevelSpeedTab[Lo] < Speed < LevelSpeedTab[Hi]
+    {
+        Mid = (Lo + Hi) >> 1;
+
+        if (LevelSpeedTab[Mid] <= Speed)
+        {
+            Lo = Mid;
+        }
+        else
+        {
+            Hi = Mid;
+        }
+    }
+
+    return ((LevelSpeedTab[Hi] - Speed) < (Speed - LevelSpeedTab[Lo])) ? Hi : Lo;
+}
@@ -0,0 +1,406 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : EncComp.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 编码器偏心补偿的标定、拟合、查表生成、保存和VISCA应答。
+                     标定在主循环中按EncComp_Task推进，DRV_ISR只负责拖动和查表插值。
+                     拖动时转子滞后拖动角度一个与转速和负载有关的固定角，拟合时不用直流分量；
+                     随机械角变化的负载(如偏重)会混入1倍分量，标定应在空载或平衡状态下进行。
+                     81 01 06 27 01 FF              开始标定，运行状态下有效
+                     81 01 06 27 00 FF              清除补偿表
+                     81 09 06 27 FF                 -> 90 50 0s 补偿前1倍 2倍 补偿后1倍 2倍 FF
+                     s为EncComp.State，幅值各4个半字节，单位为1/4个计数。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+ENC_COMP xdata EncComp;
+
+/* 一圈64点正弦表，Q15；余弦取后移1/4圈的值 */
+static int16 code EncSin[ENC_BIN_NUM] =
+{
+         0,   3212,   6393,   9512,  12539,  15446,  18204,  20787,
+     23170,  25329,  27245,  28898,  30273,  31356,  32137,  32609,
+     32767,  32609,  32137,  31356,  30273,  28898,  27245,  25329,
+     23170,  20787,  18204,  15446,  12539,   9512,   6393,   3212,
+         0,  -3212,  -6393,  -9512, -12539, -15446, -18204, -20787,
+    -23170, -25329, -27245, -28898, -30273, -31356, -32137, -32609,
+    -32767, -32609, -32137, -31356, -30273, -28898, -27245, -25329,
+    -23170, -20787, -18204, -15446, -12539,  -9512,  -6393,  -3212,
+};
+
+#define ENC_SIN(k)                      EncSin[(k) & (ENC_BIN_NUM - 1)]
+#define ENC_COS(k)                      EncSin[((k) + ENC_BIN_NUM / 4) & (ENC_BIN_NUM - 1)]
+
+/* 按Coef生成查表，系数全为0时不补偿。生成期间停止查表，避免DRV_ISR读到一半新一半旧的表 */
+static void EncComp_Build(void)
+{
+    int32 Sum;
+    uint8 Any = 0;
+    uint8 k;
+
+    EA = 0;
+    EncComp.On = 0;
+    EncComp.Delta  = 0;
+    EA = 1;
+
+    for (k = 0; k < ENC_COEF_NUM; k++)
+    {
+        Any |= (EncComp.Coef[k] != 0);
+    }
+
+    for (k = 0; k < ENC_BIN_NUM; k++)
+    {
+        Sum = (int32)EncComp.Coef[0] * ENC_COS(k) + (int32)EncComp.Coef[1] * ENC_SIN(k)
+            + (int32)EncComp.Coef[2] * ENC_COS(k << 1) + (int32)EncComp.Coef[3] * ENC_SIN(k << 1);
+        EncComp.Lut[k] = (int16)((Sum + (1L << 16)) >> 17);   // 计数Q2 x Q15 -> 计数，四舍五入
+    }
+
+    EncComp.Lut[ENC_BIN_NUM] = EncComp.Lut[0];
+    EncComp.Valid        = Any;
+    EncComp.On           = Any && (Learn.State == LearnOver);
+}
+
+#if (CALIB_TOOL_ENABLE)
+/* 转一圈回到第一个边沿时的误差Drift是拖动滞后角在这一圈中的变化，按记录顺序线性扣除 */
+static void EncComp_Detrend(int16 Drift)
+{
+    uint8 n;
+    uint8 k;
+
+    for (k = 0; k < ENC_BIN_NUM; k++)
+    {
+        n = ((EncComp.Target > 0) ? (k - EncComp.First) : (EncComp.First - k)) & (ENC_BIN_NUM - 1);
+        EncComp.Err[k] -= (int16)(((int32)Drift * n) >> 6);
+    }
+}
+
+/* 由Err拟合1倍、2倍谐波系数(计数Q2)和幅值，a = 2/64 * sum(Err * cos) */
+static void EncComp_Fit(int16 *Coef, uint16 *Amp)
+{
+    int32 Sum[ENC_COEF_NUM];
+    uint8 k;
+
+    for (k = 0; k < ENC_COEF_NUM; k++)
+    {
+        Sum[k] = 0;
+    }
+
+    for (k = 0; k < ENC_BIN_NUM; k++)
+    {
+        Sum[0] += ((int32)EncComp.Err[k] * ENC_COS(k)) >> 6;
+        Sum[1] += ((int32)EncComp.Err[k] * ENC_SIN(k)) >> 6;
+        Sum[2] += ((int32)EncComp.Err[k] * ENC_COS(k << 1)) >> 6;
+        Sum[3] += ((int32)EncComp.Err[k] * ENC_SIN(k << 1)) >> 6;
+    }
+
+    for (k = 0; k < ENC_COEF_NUM; k++)
+    {
+        Sum[k] >>= 14;
+        Coef[k] = (int16)((Sum[k] > ENC_COEF_MAX) ? ENC_COEF_MAX : ((Sum[k] < -ENC_COEF_MAX) ? -ENC_COEF_MAX : Sum[k]));
+    }
+
+    Amp[0] = Sqrt_U32((int32)Coef[0] * Coef[0] + (int32)Coef[1] * Coef[1]);
+    Amp[1] = Sqrt_U32((int32)Coef[2] * Coef[2] + (int32)Coef[3] * Coef[3]);
+}
+
+/* 系数按高字节在前保存到参数记录区 */
+static void EncComp_Save(void)
+{
+    uint8 Buf[ENC_COEF_NUM * 2];
+    uint8 k;
+
+    for (k = 0; k < ENC_COEF_NUM; k++)
+    {
+        Buf[k << 1]       = EncComp.Coef[k] >> 8;
+        Buf[(k << 1) + 1] = EncComp.Coef[k];
+    }
+
+    Param_Write(PARAM_KEY_ENC, Buf);
+}
+
+/* 停止拖动，回到编码器角度闭环。拖动期间Speed_response每次把曲线规划复位到当前位置，目标也停在当前位置 */
+static void EncComp_Stop(uint8 Result)
+{
+    EA = 0;
+    EncComp.Sweep            = 0;
+    EncComp.Step             = 0;
+    EncComp.Target           = 0;
+    mcFocCtrl.ThetaIQ_SOURCE = 0;
+    mcSP.TargetPulsesNum     = mcQEP.CntrSumReal;
+    EA = 1;
+    EncComp.State = Result;
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : EncComp_Init
+    Description    : 上电读取补偿系数并生成查表，在MotorcontrolInit中Param_Init之后调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void EncComp_Init(void)
+{
+    uint8 Buf[ENC_COEF_NUM * 2];
+    uint8 k;
+
+    memset(&EncComp, 0, sizeof(EncComp));
+
+    if (Param_Read(PARAM_KEY_ENC, Buf))
+    {
+        for (k = 0; k < ENC_COEF_NUM; k++)
+        {
+            EncComp.Coef[k] = ((int16)Buf[k << 1] << 8) | Buf[(k << 1) + 1];
+        }
+    }
+
+    EncComp_Build();
+    EncComp.State = EncComp.Valid ? ENC_DONE : ENC_IDLE;
+}
+
+#if (CALIB_TOOL_ENABLE)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : EncComp_Start
+    Description    : 开始标定。只在编码器角度闭环的电流闭环中有效(到位锁定由Uart_Dispatch先退出)，标定中重复调用不重新开始。
+                     原补偿表暂停使用，d轴电压从当前电角度开始拖动，位置环和速度环在标定期间暂停
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void EncComp_Start(void)
+{
+    uint8 k;
+
+    if ((mcState != mcRun) || !GP42 || (HoldCtrl.Mode != HOLD_IQ) || EncComp.Sweep || CogComp.Busy || AutoTune.Busy)
+    {
+        return;
+    }
+
+    for (k = 0; k < ENC_COEF_NUM; k++)
+    {
+        EncComp.Old[k]  = EncComp.Coef[k];
+        EncComp.Coef[k] = 0;
+    }
+
+    EncComp_Build();
+
+    for (k = 0; k < 2; k++)
+    {
+        EncComp.Before[k] = 0;
+        EncComp.After[k]  = 0;
+    }
+
+    EA = 0;
+    EncComp.ThetaSum         = 0;
+    EncComp.Start            = mcQEP.CntrSumReal;
+    mcFocCtrl.ThetaIQ_SOURCE = 1;
+    EncComp.Step             = 0;
+    EncComp.Target           = ENC_SWEEP_STEP;
+    EncComp.Sweep            = 1;
+    EA = 1;
+    EncComp.State = ENC_WARMUP;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : EncComp_Clear
+    Description    : 清除补偿表并保存全0系数，标定中不处理
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void EncComp_Clear(void)
+{
+    uint8 k;
+
+    if (EncComp.Sweep)
+    {
+        return;
+    }
+
+    for (k = 0; k < ENC_COEF_NUM; k++)
+    {
+        EncComp.Coef[k] = 0;
+    }
+
+    EncComp_Build();
+    EncComp_Save();
+    EncComp.State = ENC_IDLE;
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : EncComp_Task
+    Description    : 标定状态机，在主循环中调用。每过一个格边沿记录一次
+                     (补偿后计数 - 第一个边沿的计数) - (拖动电角度 - 第一个边沿的电角度) / 极对数，
+                     正转记在新格，反转记在旧格，都对应格的起点；回到第一个边沿时扣除滞后角漂移。
+                     正转一圈拟合后生成补偿表，
+                     反转一圈拟合残差，残差减小才保存，否则恢复原补偿表。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void EncComp_Task(void)
+{
+    #if (CALIB_TOOL_ENABLE)
+    int32  Pos;
+    int32  Theta;
+    int32  Err;
+    int16  Delta;
+    uint16 Mech;
+    int16  Coef[ENC_COEF_NUM];
+    uint8  Bin;
+    uint8  Idx;
+    uint8  k;
+    #endif
+
+    if ((EncComp.State < ENC_WARMUP) || (EncComp.State > ENC_VERIFY))
+    {
+        EncComp.On = EncComp.Valid && (Learn.State == LearnOver);   //上电找到Z之后打开
+        return;
+    }
+
+    #if (CALIB_TOOL_ENABLE)
+
+    if (mcState != mcRun)                                   //标定中停机或故障
+    {
+        for (k = 0; k < ENC_COEF_NUM; k++)
+        {
+            EncComp.Coef[k] = EncComp.Old[k];
+        }
+
+        EncComp_Build();
+        EncComp_Stop(ENC_FAIL);
+        return;
+    }
+
+    EA = 0;
+    Pos   = mcQEP.CntrSumReal;
+    Theta = EncComp.ThetaSum;
+    Delta = EncComp.Delta;
+    Mech  = mcQEP.MechCntr;
+    EA = 1;
+
+    Bin = (uint8)(Mech >> ENC_BIN_SHIFT);
+
+    switch (EncComp.State)
+    {
+        case ENC_WARMUP:
+        case ENC_TURN:
+            if (EncComp.Step != EncComp.Target)            //步长变化中，从到达目标时开始计等待距离
+            {
+                EncComp.Start = Pos;
+            }
+            else if ((Pos - EncComp.Start >= ENC_SETTLE_CNT) || (EncComp.Start - Pos >= ENC_SETTLE_CNT))
+            {
+                EncComp.Bin = Bin;
+                EncComp.Cnt = 0;
+                EncComp.State++;
+            }
+            break;
+
+        case ENC_MEASURE:
+        case ENC_VERIFY:
+            if (Bin == EncComp.Bin)
+            {
+                break;
+            }
+
+            Idx         = (EncComp.Target > 0) ? Bin : EncComp.Bin;
+            EncComp.Bin = Bin;
+
+            if (EncComp.Cnt == 0)
+            {
+                EncComp.PosRef   = Pos - Delta;
+                EncComp.ThetaRef = Theta;
+                EncComp.First    = Idx;
+            }
+
+            Err = ((Pos - Delta - EncComp.PosRef) << 2) - ((Theta - EncComp.ThetaRef) << 2) / (int8)Pole_Pairs;
+            Err = (Err > 32767) ? 32767 : ((Err < -32767) ? -32767 : Err);
+
+            if (EncComp.Cnt < ENC_BIN_NUM)
+            {
+                EncComp.Err[Idx] = (int16)Err;
+                EncComp.Cnt++;
+                break;
+            }
+
+            EncComp_Detrend((int16)Err);                    //转满一圈回到第一个边沿
+
+            if (EncComp.State == ENC_MEASURE)
+            {
+                EncComp_Fit(EncComp.Coef, EncComp.Before);
+                EncComp_Build();
+                EncComp.Target = -ENC_SWEEP_STEP;
+                EncComp.State = ENC_TURN;
+            }
+            else
+            {
+                EncComp_Fit(Coef, EncComp.After);
+
+                if (EncComp.After[0] + EncComp.After[1] < EncComp.Before[0] + EncComp.Before[1])
+                {
+                    EncComp_Save();
+                    EncComp_Stop(ENC_DONE);
+                }
+                else
+                {
+                    for (k = 0; k < ENC_COEF_NUM; k++)
+                    {
+                        EncComp.Coef[k] = EncComp.Old[k];
+                    }
+
+                    EncComp_Build();
+                    EncComp_Stop(ENC_FAIL);
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+    #endif
+}
+
+#if (CALIB_TOOL_ENABLE)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : EncComp_Ramp
+    Description    : 拖动步长每ENC_RAMP_TICKS个SysTick周期向目标变化1，在SYStick_INT的Speed_response中拖动期间调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void EncComp_Ramp(void)
+{
+    if (++EncComp.RampCnt < ENC_RAMP_TICKS)
+    {
+        return;
+    }
+
+    EncComp.RampCnt = 0;
+
+    if (EncComp.Step < EncComp.Target)
+    {
+        EncComp.Step++;
+    }
+    else if (EncComp.Step > EncComp.Target)
+    {
+        EncComp.Step--;
+    }
+}
+#endif
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : EncComp_Report
+    Description    : 填写标定状态和最近一次标定的补偿前后误差幅值到应答帧
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void EncComp_Report(void)
+{
+    Uart.T_DATA[2] = EncComp.State;
+    Uart_PutWord(3, EncComp.Before[0]);
+    Uart_PutWord(7, EncComp.Before[1]);
+    Uart_PutWord(11, EncComp.After[0]);
+    Uart_PutWord(15, EncComp.After[1]);
+    Uart.T_Len = 20;
+    Uart.RxFSM = 1;
+}
@@ -0,0 +1,363 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : HoldCtrl.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 到位保持的模式切换，在Speed_response中每个SysTick周期调用一次。
+                     1. Iq -> 锁定: 曲线规划到位且位置误差持续在HOLD_ENTER_ERR内，冻结当前电角度，
+                        d轴电流环关闭并从当前输出电压斜坡到UD_Align_Duty_Max，q轴电流环保持切换时的
+                        给定，重力等负载转矩不因切换而卸掉。锁定中速度环不运行，只跟踪误差。
+                     2. 锁定 -> Iq: 新的目标位置、标定/整定开始或位置误差超过HOLD_SLIP_ERR，
+                        速度环积分预置为保持电流，电流环从锁定时的电压继续调节。主循环和USART2_INT只置
+                        HoldCtrl.ExitReq，退出都在这里完成，HoldCtrl_Exit只在SYStick_INT中调用。
+                     3. 锁定 -> 低功耗: 锁定HOLD_IDLE_DELAY后d轴电压斜坡到零，之后q轴电流给定每节拍向零递减
+                        HOLD_IQ_STEP，转子蠕动超过HOLD_CREEP_ERR时回加HOLD_IQ_MARGIN并停止递减，
+                        得到克服重力等负载所需的最小电流；递减到零后HOLD_SETTLE_TICKS内仍不动时
+                        摩擦和齿槽转矩足以保持，关闭三相输出。编码器位置变化超过HOLD_SLIP_ERR或收到新指令时在一个SysTick周期内
+                        恢复输出并回到电流闭环。
+                     每次切换后HOLD_PROBE_TICKS内统计位置跟踪误差、实测Iq的最大变化和Iq给定每节拍的最大变化。
+                     81 09 06 2A 0f FF              -> 90 50 0m 次数 位置 Iq Iq给定 FF
+                     f=0/1为最近一次进入/退出锁定，f=2/3为历次进入/退出中的最大值，
+                     m为HoldCtrl.Mode，其余各4个半字节。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+HOLD_CTRL xdata HoldCtrl;
+
+/* 绝对值限幅到16位 */
+static uint16 HoldCtrl_Abs(int32 Value)
+{
+    uint32 Abs = Abs_F32(Value);
+
+    return (Abs > 0xFFFF) ? 0xFFFF : (uint16)Abs;
+}
+
+/* 结束本次跳变统计，更新历次最大值 */
+static void HoldCtrl_ProbeEnd(void)
+{
+    HOLD_JUMP xdata *Jump;
+
+    if (HoldCtrl.Probe == 0)
+    {
+        return;
+    }
+
+    Jump = &HoldCtrl.Jump[HoldCtrl.Probe - 1];
+
+    if (Jump->Pos > Jump->PosMax)
+    {
+        Jump->PosMax = Jump->Pos;
+    }
+
+    if (Jump->Iq > Jump->IqMax)
+    {
+        Jump->IqMax = Jump->Iq;
+    }
+
+    if (Jump->Ref > Jump->RefMax)
+    {
+        Jump->RefMax = Jump->Ref;
+    }
+
+    HoldCtrl.Probe = 0;
+}
+
+/* 开始统计一次切换，Idx为HOLD_JUMP_xxx，上一次没有统计完的先结束 */
+static void HoldCtrl_ProbeStart(uint8 Idx)
+{
+    HOLD_JUMP xdata *Jump = &HoldCtrl.Jump[Idx];
+
+    HoldCtrl_ProbeEnd();
+
+    if (Jump->Num != 0xFFFF)
+    {
+        Jump->Num++;
+    }
+
+    Jump->Pos           = 0;
+    Jump->Iq            = 0;
+    Jump->Ref           = 0;
+    HoldCtrl.Err0       = mcFocCtrl.PosiErr;
+    HoldCtrl.Iq0        = FOC__IQ;
+    HoldCtrl.IqRefOld   = FOC_IQREF;
+    HoldCtrl.ProbeTicks = 0;
+    HoldCtrl.Probe      = Idx + 1;
+}
+
+/* 统计时间只有10ms，新目标引起的退出在这段时间内曲线规划的加速度还很小，统计值主要是切换本身带来的跳变 */
+static void HoldCtrl_ProbeTick(void)
+{
+    HOLD_JUMP xdata *Jump;
+    int16  IqRef;
+    uint16 Value;
+
+    if (HoldCtrl.Probe == 0)
+    {
+        return;
+    }
+
+    Jump  = &HoldCtrl.Jump[HoldCtrl.Probe - 1];
+    Value = HoldCtrl_Abs(mcFocCtrl.PosiErr - HoldCtrl.Err0);
+
+    if (Value > Jump->Pos)
+    {
+        Jump->Pos = Value;
+    }
+
+    Value = HoldCtrl_Abs((int32)FOC__IQ - HoldCtrl.Iq0);
+
+    if (Value > Jump->Iq)
+    {
+        Jump->Iq = Value;
+    }
+
+    IqRef = FOC_IQREF;
+    Value = HoldCtrl_Abs((int32)IqRef - HoldCtrl.IqRefOld);
+    HoldCtrl.IqRefOld = IqRef;
+
+    if (Value > Jump->Ref)
+    {
+        Jump->Ref = Value;
+    }
+
+    if (++HoldCtrl.ProbeTicks >= HOLD_PROBE_TICKS)
+    {
+        HoldCtrl_ProbeEnd();
+    }
+}
+
+/* 进入锁定，在关中断时调用。电角度、d轴电压和q轴电流给定都取切换时刻的值 */
+static void HoldCtrl_Enter(void)
+{
+    HoldCtrl.Theta = FOC__THETA;
+    HoldCtrl.Ud    = FOC__UD;
+    HoldCtrl.Iq    = FOC_IQREF;
+    HoldCtrl.Pos   = mcQEP.CntrSumReal;
+    SetBit(FOC_CR2, UDD);
+    ClrBit(FOC_CR2, UQD);
+    FOC__UD        = HoldCtrl.Ud;
+    FOC_IQREF      = HoldCtrl.Iq;
+    mcFocCtrl.ThetaIQ_SOURCE = 1;
+    HoldCtrl.Mode  = HOLD_RAMP;
+    HoldCtrl.Cnt   = 0;
+    HoldCtrl_ProbeStart(HOLD_JUMP_IN);
+}
+
+/* 低功耗: d轴电压和q轴电流给定向零递减，都到零后再等HOLD_SETTLE_TICKS仍不动才关闭三相输出，
+   负载接近静摩擦时转子在电流过零后才开始蠕动 */
+static void HoldCtrl_Idle(int32 Move)
+{
+    int16 Iq = HoldCtrl.Iq;
+
+    if (HoldCtrl.Trim && ((Move > HOLD_CREEP_ERR) || (Move < -HOLD_CREEP_ERR)))
+    {
+        Iq += (Move > 0) ? HOLD_IQ_MARGIN : -HOLD_IQ_MARGIN;  // 转子开始蠕动，向阻止蠕动的方向加一点余量，之后不再递减
+        HoldCtrl.Trim = 0;
+    }
+    else if (HoldCtrl.Ud > HOLD_UD_STEP)
+    {
+        HoldCtrl.Ud -= HOLD_UD_STEP;
+    }
+    else if (HoldCtrl.Ud != 0)
+    {
+        HoldCtrl.Ud = 0;
+    }
+    else if (HoldCtrl.Trim)                                 // d轴电压撤掉后才递减q轴电流
+    {
+        if (Iq > HOLD_IQ_STEP)
+        {
+            Iq -= HOLD_IQ_STEP;
+        }
+        else if (Iq < -HOLD_IQ_STEP)
+        {
+            Iq += HOLD_IQ_STEP;
+        }
+        else
+        {
+            Iq = 0;
+        }
+    }
+
+    HoldCtrl.Iq = Iq;
+    EA = 0;
+    FOC__UD   = HoldCtrl.Ud;
+    FOC_IQREF = Iq;
+
+    if (HoldCtrl.Trim && (Iq == 0) && (HoldCtrl.Ud == 0) && (++HoldCtrl.Cnt >= HOLD_SETTLE_TICKS))
+    {
+        SetBit(FOC_CR2, UQD);
+        FOC__UQ = 0;
+        MOE     = 0;
+        HoldCtrl.Mode = HOLD_OFF;
+    }
+
+    EA = 1;
+}
+
+/* 退出锁定回到电流闭环，只在HoldCtrl_Tick中关中断调用。三相输出已关闭时先恢复输出(有故障时不恢复)。
+   速度环积分和CogComp.IqBase预置为当前的保持电流，锁定中Speed_response已把速度误差写入PI2_EK1，
+   第一次计算没有比例项突变；dq轴电流环从锁定电压开始调节，电角度在下一个载波周期由DRV_ISR改回编码器角度 */
+static void HoldCtrl_Exit(void)
+{
+    if ((HoldCtrl.Mode == HOLD_OFF) && (mcFaultSource == FaultNoSource))
+    {
+        MOE = 1;
+    }
+
+    CogComp.IqBase = HoldCtrl.Iq - CogComp.Iq;
+    PI2_UKH = -CogComp.IqBase;
+    PI2_UKL = 0;
+    ClrBit(FOC_CR2, UDD);
+    ClrBit(FOC_CR2, UQD);
+    mcFocCtrl.ThetaIQ_SOURCE = 0;
+    HoldCtrl.Mode = HOLD_IQ;
+    HoldCtrl.Cnt  = 0;
+    HoldCtrl_ProbeStart(HOLD_JUMP_OUT);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HoldCtrl_Init
+    Description    : 从电流闭环开始，清除跳变统计，在MotorcontrolInit中调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HoldCtrl_Init(void)
+{
+    memset(&HoldCtrl, 0, sizeof(HoldCtrl));
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HoldCtrl_Release
+    Description    : 需要电流闭环的指令执行前在主循环中调用。到位保持中请求HoldCtrl_Tick退出并返回0，
+                     调用者留到下一轮再试，最多等一个SysTick周期；已在电流闭环或电机不在运行时返回1
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+uint8 HoldCtrl_Release(void)
+{
+    if ((HoldCtrl.Mode == HOLD_IQ) || (mcState != mcRun))
+    {
+        return 1;
+    }
+
+    HoldCtrl.ExitReq = 1;
+    return 0;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HoldCtrl_Tick
+    Description    : 模式切换、d轴电压斜坡和低功耗电流递减，在Speed_response中更新mcFocCtrl.PosiErr之后、
+                     速度环计算之前调用。mcFocCtrl.PosiErr每3个节拍才更新，只用于判断进入；进入后的滑动、
+                     蠕动和HOLD_OFF唤醒按mcQEP.CntrSumReal相对HoldCtrl.Pos的变化每节拍判断
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void HoldCtrl_Tick(void)
+{
+    int32 Err  = mcFocCtrl.PosiErr;
+    int32 Move = mcQEP.CntrSumReal - HoldCtrl.Pos;
+    uint8 ExitReq = HoldCtrl.ExitReq;
+
+    HoldCtrl.ExitReq = 0;
+    HoldCtrl_ProbeTick();
+
+    if (HoldCtrl.Mode == HOLD_IQ)
+    {
+        if (ExitReq || (mcFocCtrl.Timedelay < HOLD_DELAY) || !mcSP.Done || CogComp.Busy || AutoTune.Busy
+            || (Err > HOLD_ENTER_ERR) || (Err < -HOLD_ENTER_ERR)
+            || (HoldCtrl.Cnt == 0) || (Err - HoldCtrl.ErrRef > HOLD_CREEP_ERR) || (HoldCtrl.ErrRef - Err > HOLD_CREEP_ERR))
+        {
+            HoldCtrl.Cnt    = 1;
+            HoldCtrl.ErrRef = Err;
+            return;
+        }
+
+        if (++HoldCtrl.Cnt >= HOLD_SETTLE_TICKS)
+        {
+            EA = 0;
+            HoldCtrl_Enter();
+            EA = 1;
+        }
+        return;
+    }
+
+    if (ExitReq || (Move > HOLD_SLIP_ERR) || (Move < -HOLD_SLIP_ERR))
+    {
+        EA = 0;
+        HoldCtrl_Exit();
+        EA = 1;
+        return;
+    }
+
+    switch (HoldCtrl.Mode)
+    {
+        case HOLD_RAMP:
+            if (HoldCtrl.Ud < UD_Align_Duty_Max - HOLD_UD_STEP)
+            {
+                HoldCtrl.Ud += HOLD_UD_STEP;
+            }
+            else if (HoldCtrl.Ud > UD_Align_Duty_Max + HOLD_UD_STEP)
+            {
+                HoldCtrl.Ud -= HOLD_UD_STEP;
+            }
+            else
+            {
+                HoldCtrl.Ud   = UD_Align_Duty_Max;
+                HoldCtrl.Mode = HOLD_LOCK;
+            }
+
+            EA = 0;
+            FOC__UD = HoldCtrl.Ud;
+            EA = 1;
+            break;
+
+        case HOLD_LOCK:
+            if (++HoldCtrl.Cnt >= HOLD_IDLE_DELAY)
+            {
+                HoldCtrl.Pos    = mcQEP.CntrSumReal;        // 锁定中转子会被拉到锁定角，以此为蠕动和滑动的参考
+                HoldCtrl.Trim   = 1;
+                HoldCtrl.Cnt    = 0;
+                HoldCtrl.Mode   = HOLD_IDLE;
+            }
+            break;
+
+        case HOLD_IDLE:
+            HoldCtrl_Idle(Move);
+            break;
+
+        default:                                            // HOLD_OFF: 只检测位置变化
+            break;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : HoldCtrl_Report
+    Description    : 应答切换统计
+    Date           : 2026-10-17
+    Parameter      : Field: [输入] 0/1最近一次进入/退出，2/3历次进入/退出的最大值
+    ------------------------------------------------------------------------------------------------- */
+void HoldCtrl_Report(uint8 Field)
+{
+    HOLD_JUMP xdata *Jump = &HoldCtrl.Jump[Field & 0x01];
+
+    Uart.T_DATA[2] = HoldCtrl.Mode;
+    Uart_PutWord(3, Jump->Num);
+
+    if (Field < 2)
+    {
+        Uart_PutWord(7, Jump->Pos);
+        Uart_PutWord(11, Jump->Iq);
+        Uart_PutWord(15, Jump->Ref);
+    }
+    else
+    {
+        Uart_PutWord(7, Jump->PosMax);
+        Uart_PutWord(11, Jump->IqMax);
+        Uart_PutWord(15, Jump->RefMax);
+    }
+
+    Uart.T_Len = 20;
+    Uart.RxFSM = 1;
+}
@@ -14,9 +14,6 @@ uint16 xdata spidebug[4] = { 0 };
 
 extern  int32 speedRef;
 
-extern  uint8 SYST_Times;
-uint8 Learn_Data[2]={0};
-
 /*  -------------------------------------------------------------------------------------------------
     Function Name  : EXTI_INT
     Description    : EXTI0 INT，Z
@@ -68,8 +65,17 @@ void TIM1_INT(void) interrupt 5
 void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
 {
     int32 tempCntrSum;
+    uint8 EncIdx;
+    uint16 CogIdx;
+    int16 CogA;
     static uint16 idata PeriodTime;
 	  int16  *aa;
+    #if (PROFILE_ENABLE)
+    uint16 ProfIsr;
+    uint16 ProfItem;
+    #endif
+    
+    PROFILE_START(ProfIsr);
     
     if (ReadBit(DRV_SR, FGIF))
     {
@@ -78,18 +84,20 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
     
     if (ReadBit(DRV_SR, DCIF))    // 比较中断
     {
-        	 
+        PROFILE_START(ProfItem);
         mcQEP.CntrOld    = mcQEP.Cntr;
         mcQEP.Cntr       = TIM2__CNTR;   // 计数值
         mcQEP.PeriodTime = TIM2__ARR;
         mcQEP.CntrErr = mcQEP.Cntr - mcQEP.CntrOld;
-			
+        mcQEP.MechCntr = mcQEP.Cntr - (uint16)mcQEP.ZeroCntr; // 上电时计数只按PWM编码器电角度对齐，机械位置以Z为准
+        mcQEP.IsrTick++;
+        Sched_FastTick();
 
-				if(UqPo.UqPoaiFlag == 0)
-				{
-					UqPo.ThetaN = FOC__THETA;
-					UqPo.IQN = FOC_IQREF;
-				}
+        if (mcQEP.CntrErr != 0)
+        {
+            mcQEP.EdgeTick = mcQEP.IsrTick;
+            mcQEP.EdgeCntr = mcQEP.Cntr;
+        }
         
         if (mcQEP.CntrErr < 0)
         {
@@ -112,7 +120,7 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
             mcQEP.Dir = 0;
         }
 					
-				 *(int16 *)(&tempCntrSum) = mcQEP.Cycle;
+				 tempCntrSum = (int32)mcQEP.Cycle << 16;     // Cycle为高16位，不依赖大小端
     
         mcQEP.CntrSumReal =  tempCntrSum + mcQEP.Cntr;
 
@@ -123,7 +131,15 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
             mcQEP.PeriodTime = QEPPluseMinTime + 1;
         }
         
-        MuiltS_L_MDU(mcQEP.Cntr, ETHETA_PER_PLASE, mcQEP.Theta);
+        if (EncComp.On)                     // 编码器偏心补偿，格内线性插值，只修正电角度
+        {
+            EncIdx = mcQEP.MechCntr >> ENC_BIN_SHIFT;
+            MuiltS1_H_MDU(EncComp.Lut[EncIdx + 1] - EncComp.Lut[EncIdx], (mcQEP.MechCntr & ENC_BIN_MASK) << (15 - ENC_BIN_SHIFT), EncComp.Delta);
+            EncComp.Delta += EncComp.Lut[EncIdx];
+        }
+
+        MuiltS_L_MDU(mcQEP.Cntr - EncComp.Delta, ETHETA_PER_PLASE, mcQEP.Theta);
+        PROFILE_STOP(PROF_QEP, ProfItem);
 
         #if (Speed_Method == T_Method)
         {
@@ -160,12 +176,10 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
         }
         #elif (Speed_Method == M_Method)
         {
-            /*************************2K的M法测速*******************************/
-            mcQEP.M_CNT++;
-        
-            if (mcQEP.M_CNT == 8)
+            /*************************3K的M法测速*******************************/
+            if (SCHED_DUE(SCHED_FAST_SPEED))
             {
-                mcQEP.M_CNT = 0;
+                PROFILE_START(ProfItem);
                 mcQEP.CntrM = mcQEP.Cntr;
                 mcQEP.PosDiff =  mcQEP.CntrM - mcQEP.CntrOldM;
                 mcQEP.PosDiffSum += mcQEP.PosDiff - mcQEP.PosDiffArray[mcQEP.ArrayPointer];
@@ -179,20 +193,50 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
 								
 								
 							mcQEP.PosDiffSumTemp = mcQEP.PosDiffSum;
-              if (mcQEP.PosDiffSumTemp>200)
+              if (mcQEP.PosDiffSumTemp>174)                    //(174 >> 1) * 375 = 32625，再大乘积超出int16回绕成反向速度
 							{
-								mcQEP.PosDiffSumTemp =200;
+								mcQEP.PosDiffSumTemp =174;
 							}
-							if (mcQEP.PosDiffSumTemp<-200)
+							if (mcQEP.PosDiffSumTemp<-174)
 							{
-								mcQEP.PosDiffSumTemp= -200;
+								mcQEP.PosDiffSumTemp= -174;
 							}
                 MuiltS_L_MDU(mcQEP.PosDiffSumTemp>>1, 375, mcQEP.SpeedM);
                 mcQEP.CntrOldM = mcQEP.CntrM;
-                LPF_MDU(mcQEP.SpeedM, 150, mcQEP.SpeedMFlt, mcQEP.SpeedMFlt_LSB);
+
+                if (mcQEP.SpeedMode == SPEED_MODE_MT)
+                {
+                    QEP_SpeedMT();
+                }
+                else
+                {
+                    mcQEP.SpeedEst     = mcQEP.SpeedM;
+                    mcQEP.SpeedLatency = SPEED_M_LATENCY;
+                }
+
+                LPF_MDU(mcQEP.SpeedEst, 150, mcQEP.SpeedMFlt, mcQEP.SpeedMFlt_LSB);
         
                 if (mcQEP.SpeedMFlt < 2 && mcQEP.SpeedMFlt > -2)
                 { mcQEP.SpeedMFlt = 0; }
+
+                PROFILE_STOP(PROF_SPEED_M, ProfItem);
+                SCHED_CHECK(SCHED_FAST_SPEED, ProfItem);
+            }
+        }
+        #elif (Speed_Method == O_Method)
+        {
+            /*************************3K的观测器测速*******************************/
+            mcQEP.ObsIqSum -= FOC__IQ;                       // FOC_IQREF为负时正转
+
+            if (SCHED_DUE(SCHED_FAST_SPEED))
+            {
+                PROFILE_START(ProfItem);
+                mcQEP.CntrM    = mcQEP.Cntr;
+                mcQEP.PosDiff  = mcQEP.CntrM - mcQEP.CntrOldM;
+                mcQEP.CntrOldM = mcQEP.CntrM;
+                QEP_Observer();
+                PROFILE_STOP(PROF_SPEED_M, ProfItem);
+                SCHED_CHECK(SCHED_FAST_SPEED, ProfItem);
             }
         }
         #endif
@@ -213,57 +257,71 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
                 FOC__THETA += 5;
 							GP15 = 1;
             }
+
+            if (CogComp.On)                 // 齿槽补偿，格内线性插值后叠加到速度环输出上
+            {
+                CogIdx = mcQEP.MechCntr >> COG_BIN_SHIFT;
+                CogA   = COG_TAB(CogIdx);
+                MuiltS1_H_MDU(COG_TAB((CogIdx + 1) & (COG_BIN_NUM - 1)) - CogA, (mcQEP.MechCntr & COG_BIN_MASK) << (15 - COG_BIN_SHIFT), CogComp.Iq);
+                CogComp.Iq = ((CogComp.Iq + CogA) << COG_IQ_SHIFT) - CogComp.Mean;
+                FOC_IQREF  = CogComp.IqBase + CogComp.Iq;
+            }
         }
 /*----------------------------------------切强拖与预定位--------------------------------------*/
-				if(mcFocCtrl.Timedelay >= 5000)
+				PROFILE_START(ProfItem);
+				#if (CALIB_TOOL_ENABLE)
+				if(EncComp.Sweep)                             // 编码器偏心标定，d轴电压按固定步长拖动
 				{
-					if((mcFocCtrl.PosiErr <= 700) && (mcFocCtrl.PosiErr >= -700))
-					{
-						mcFocCtrl.ThetaIQ_SOURCE = 1;
-						mcFocCtrl.UQTurnFlag = 1;
-					}
+					FOC_IQREF = 0;
+					SetBit(FOC_CR2, UDD);
+					SetBit(FOC_CR2, UQD);
+					FOC__UD = UD_Align_Duty_Max;
+					FOC__UQ = 0;
+					FOC__THETA += EncComp.Step;
+					EncComp.ThetaSum += EncComp.Step;
+					DRV_CMR |= 0x3F;
+					MOE = 1;
 				}
-				if(mcFocCtrl.UQTurnFlag)
+				else if(AutoTune.Drive)                       // 参数整定，电流环关闭，d轴电压阶跃辨识电阻和电感
 				{
-					GP12 = ~GP12;
 					FOC_IQREF = 0;
 					SetBit(FOC_CR2, UDD);
 					SetBit(FOC_CR2, UQD);
-					FOC__UQ = UD_Align_Duty_Max;
-					FOC__UD = 0;
-					FOC__THETA += 3;
-					DRV_CMR |= 0x3F;                         // U、V、W相输出
+					AutoTune_Step();
+					DRV_CMR |= 0x3F;
 					MOE = 1;
-                    if((mcFocCtrl.PosiErr <= 80) && (mcFocCtrl.PosiErr >= -80))
-                    {
-                        FOC__THETA = UqPo.ThetaN;
-                        FOC__UD = UD_Align_Duty_Max;
-                        FOC__UQ = 0;
-                        mcFocCtrl.UQTurnFlag = 0;
-                        mcFocCtrl.UQLockFlag = 1;
-                    }
-                }
-                else
-                {
-                    if(mcFocCtrl.UQLockFlag)
-                    {
-                        SetBit(FOC_CR2, UDD);
-                        ClrBit(FOC_CR2, UQD);
-                        FOC__UQ = 0;
-                        FOC__UD = UD_Align_Duty_Max;
-                        FOC__THETA = UqPo.ThetaN;
-                        DRV_CMR |= 0x3F;
-                        MOE = 1;
-                    }
-                    else
-                    {
-                        ClrBit(FOC_CR2, UDD);
-                        ClrBit(FOC_CR2, UQD);
-                    }
-                }
+				}
+				else
+				#endif
+				if(HoldCtrl.Mode != HOLD_IQ)             // 到位保持，电角度冻结，d轴电压和Iq给定由HoldCtrl_Tick给出
+				{
+					FOC__THETA = HoldCtrl.Theta;
+				}
+				else
+				{
+					ClrBit(FOC_CR2, UDD);
+					ClrBit(FOC_CR2, UQD);
+				}
+				PROFILE_STOP(PROF_UQ_LOCK, ProfItem);
 /*-----------------------------------------------------------------------------------------*/				
 				
+        #if (SCOPE_ENABLE)
+        if ((Scope.State == SCOPE_ARMED) || (Scope.State == SCOPE_POST))
+        {
+            PROFILE_START(ProfItem);
+            Scope_Sample();
+            PROFILE_STOP(PROF_SCOPE, ProfItem);
+        }
+        #endif
+
         #if (DBG_MODE == SPI_DBG_SW)            // 软件调试模式
+        #if (SCOPE_ENABLE)
+        if (Scope.Replay)                       // 示波器缓冲区回放
+        {
+            Scope_Replay();
+        }
+        else
+        #endif
         {
             spidebug[0] = FOC__THETA;//_Q15(Angle /180.0);//mcQEP.Cycle;
             spidebug[1] = FOC__THETA;//mcQEP.CntrSumReal;
@@ -273,6 +331,8 @@ void DRV_ISR(void) interrupt 3 //测试用时间   M法%78占空比    T法%67
         #endif
         SetReg(DRV_SR, 0xFF, SYSTIE | DCIM1 | SYSTIF);
     }
+    
+    PROFILE_STOP(PROF_DRV_ISR, ProfIsr);
 }
 
 void TIM2_INT(void) interrupt 4
@@ -332,24 +392,23 @@ uint32 Timex = 0;
 
 void SYStick_INT(void) interrupt 10  //2K的执行周期  %55
 {
-    static uint8  SYST_Cnt;
+    #if (PROFILE_ENABLE)
+    uint16 ProfIsr;
+    uint16 ProfItem;
+    #endif
+    
+    PROFILE_START(ProfIsr);
     
     if (ReadBit(DRV_SR, SYSTIF))          // SYS TICK中断
     {
 			mcQEP.g1msflg++;
         //          GP05 = 1;
         SetBit(ADC_CR, ADCBSY);           //使能ADC的DCBUS采样
-	
+        Sched_SlowTick();
         
-        if (Uart.EnableTimeCnt == 1)
+        if ((Uart.EnableTimeCnt == 1) && SCHED_DUE(SCHED_SLOW_GO_TIME))
         {
-            SYST_Cnt++;//
-            
-            if (SYST_Cnt == SYST_Times) //2次1ms
-            {
-                SYST_Cnt = 0;
-                Uart.Go_Time++;
-            }
+            Uart.Go_Time++;           //1ms
         }
         if(mcFocCtrl.Timedelay <= 10000)
 				{
@@ -357,10 +416,17 @@ void SYStick_INT(void) interrupt 10  //2K的执行周期  %55
 				}
 				
         /* -----环路响应，如速度环、转矩环、功率环等----- */
+        PROFILE_START(ProfItem);
         Speed_response();  //152us
+        PROFILE_STOP(PROF_SPEED_RESPONSE, ProfItem);
+        #if (DBG_MODE == UART_DBG)
+        Telem_Tick();                     //遥测帧交给DMA1
+        #endif
         LPF_MDU(ADC14_DR, 100, mcFocCtrl.mcDcbusFlt, mcFocCtrl.mcDcbusFlt_LSB);
         mcFocCtrl.mcDcbusFlt = ADC14_DR;
+        PROFILE_START(ProfItem);
         Fault_Detection(); //52us
+        PROFILE_STOP(PROF_FAULT_DETECTION, ProfItem);
         //Fault_Communication();
         GP00 = ~GP00;
         /* ****电机状态机的时序处理**** */
@@ -377,23 +443,6 @@ void SYStick_INT(void) interrupt 10  //2K的执行周期  %55
                 mcFocCtrl.SoftStart_Flag = 1;
             }
         }
-        if (GP42 == 0)
-        {           
-            if (mcFocCtrl.Lrean_State == 1)
-            {
-
-                mcFocCtrl.Lrean_State = 0;
-              
-                Learn_Data[0] = mcFocCtrl.LreanAngle >> 8;
-                Learn_Data[1] = mcFocCtrl.LreanAngle;
-                EA = 0;
-                Flash_ErasePageRom(STARTPAGEROMADDRESS);
-                
-                Flash_Sector_Write(STARTPAGEROMADDRESS, Learn_Data[0]);
-                Flash_Sector_Write(STARTPAGEROMADDRESS+1, Learn_Data[1]);
-                EA = 1;            
-            }
-        } 
 
         /***********测试转动*********************/
         #if OPEN_TEST
@@ -405,23 +454,23 @@ void SYStick_INT(void) interrupt 10  //2K的执行周期  %55
             if (Timex == 80000)
             {
                 Timex = 0;
-                mcSP.PulsesNum      = P_Value(134);
+                mcSP.TargetPulsesNum = P_Value(134);
                 Speed_Handle(0X18);
             }
             
             if (Timex == 60000)
             {
-                mcSP.PulsesNum      = P_Value(10) ;
+                mcSP.TargetPulsesNum = P_Value(10) ;
                 Speed_Handle(SpeedLevel);
             }
             else if (Timex == 40000)
             {
-                mcSP.PulsesNum      = P_Value(134);
+                mcSP.TargetPulsesNum = P_Value(134);
                 Speed_Handle(0X18);
             }
             else if (Timex == 20000)
             {
-                mcSP.PulsesNum      = P_Value(210);
+                mcSP.TargetPulsesNum = P_Value(210);
                 Speed_Handle(0X18);
             }
         }
@@ -429,6 +478,8 @@ void SYStick_INT(void) interrupt 10  //2K的执行周期  %55
         #endif
         SetReg(DRV_SR, 0xFF, SYSTIE | DCIM1 | DCIF);
     }
+    
+    PROFILE_STOP(PROF_SYST_INT, ProfIsr);
 }
 /*  -------------------------------------------------------------------------------------------------
     Function Name  : CMP3_INT
@@ -481,22 +532,15 @@ void CMP3_INT(void)  interrupt 12
 void USART2_INT(void)  interrupt 14
 {
     uint8 Uredata = 0;
+    #if (PROFILE_ENABLE)
+    uint16 ProfIsr;
+    #endif
+    
+    PROFILE_START(ProfIsr);
     
     if (ReadBit(UT2_CR, UT2TI))
     {
-        ClrBit(UT2_CR, UT2TI);
-        
-        if (Uart.SendCnt < Uart.T_Len - 1)
-        {
-            Uart.SendCnt++;
-            UART_SendData(Uart.T_DATA[Uart.SendCnt]);
-        }
-        
-        //        if(Uart.T_DATA[Uart.SendCnt] != 0xff)
-        //        {
-        //            Uart.SendCnt++;
-        //            UART_SendData(Uart.T_DATA[Uart.SendCnt]);
-        //        }
+        ClrBit(UT2_CR, UT2TI);          //发送由DMA0整帧完成，见DMA_INT
     }
     
     if (ReadBit(UT2_CR, UT2RI) )
@@ -509,9 +553,14 @@ void USART2_INT(void)  interrupt 14
             case 0:
                 if (Uredata == 0x81)
                 {
-                    Uart.R_DATA[Uart.UARxCnt++] = Uredata;
+                    UartRxQ.Buf[UartRxQ.Tail][Uart.UARxCnt++] = Uredata;   //Tail帧对主循环不可见，直接在队列中组帧
                     Uart.Read_State = 1;
                 }
+                else if (Uredata == UART_STREAM_HEAD)
+                {
+                    UartStream.Buf[Uart.UARxCnt++] = Uredata;
+                    Uart.Read_State = 2;
+                }
                 
                 //                else
                 //                {
@@ -523,12 +572,11 @@ void USART2_INT(void)  interrupt 14
                 break;
                 
             case 1:
-                Uart.R_DATA[Uart.UARxCnt++] = Uredata;
+                UartRxQ.Buf[UartRxQ.Tail][Uart.UARxCnt++] = Uredata;
                 
-                if (Uart.UARxCnt >= 20)
+                if (Uart.UARxCnt >= UART_RXQ_SIZE)
                 {
                     Uart.UARxCnt = 0;
-                    Uart.ResponceFlag = 0;
                     Uart.Read_State =  0;
                 }
                 
@@ -536,31 +584,75 @@ void USART2_INT(void)  interrupt 14
                 {
                     if (Uart.UARxCnt >= 4 && Uart.UARxCnt <= 15)
                     {
+                        if (((UartRxQ.Tail + 1) & (UART_RXQ_NUM - 1)) != UartRxQ.Head)
+                        {
+                            UartRxQ.Len[UartRxQ.Tail] = Uart.UARxCnt;
+                            UartRxQ.Tail = (UartRxQ.Tail + 1) & (UART_RXQ_NUM - 1);
+                        }
+                        else if (UartRxQ.Drop != 0xFFFF)
+                        {
+                            UartRxQ.Drop++;             //队列满，丢弃本帧
+                        }
                         Uart.UARxCnt = 0;
-                        Uart.ResponceFlag = 1;
                         Uart.Read_State =  0;
                     }
                     else
                     {
                         Uart.UARxCnt = 0;
-                        Uart.ResponceFlag = 0;
                         Uart.Read_State =  0;
-                        Send_NoActive(); //无效指令  长度不对
+                        Uart.NoActiveReq = 1; //无效指令  长度不对，由主循环回复
                     }
                 }
                 
                 break;
                 
+            case 2:                                         //二进制连续给定帧，定长，收齐后校验并写入目标
+                UartStream.Buf[Uart.UARxCnt++] = Uredata;
+                
+                if (Uart.UARxCnt >= UART_STREAM_LEN)
+                {
+                    Uart.UARxCnt = 0;
+                    Uart.Read_State =  0;
+                    Uart_StreamRx();
+                }
+                
+                break;
+                
             default:
                 Uart.UARxCnt = 0;
-                Uart.ResponceFlag = 0;
                 Uart.Read_State =  0;
                 break;
         }
     }
+    
+    PROFILE_STOP(PROF_UART_INT, ProfIsr);
 }
 
 
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : DMA_INT
+    Description    : DMA0把一帧应答送完后推进发送队列，队列非空则启动下一帧
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void DMA_INT(void) interrupt 15
+{
+    if (ReadBit(DMA0_CR0, DMAIF))
+    {
+        ClrBit(DMA0_CR0, DMAIF);
+        UartTxQ.Head = (UartTxQ.Head + 1) & (UART_TXQ_NUM - 1);
+
+        if (UartTxQ.Head != UartTxQ.Tail)
+        {
+            UART_TX_START();
+        }
+        else
+        {
+            UartTxQ.Busy = 0;
+        }
+    }
+}
+
 void TIM3_INT(void) interrupt 9
 {
     if (ReadBit(TIM3_CR1, T3IR))
@@ -570,26 +662,13 @@ void TIM3_INT(void) interrupt 9
     
     if (ReadBit(TIM3_CR1, T3IP))//周期中断
     {
-        mcPwmInput.TimeDR    = TIM3__DR;
-        mcPwmInput.TimeARR        = TIM3__ARR;
-        mcPwmInput.PwmUpdateFlag = 1;
+        AbsEnc_Capture(TIM3__DR, TIM3__ARR);
         ClrBit(TIM3_CR1, T3IP);
     }
     
-    if (ReadBit(TIM3_CR1, T3IF))
+    if (ReadBit(TIM3_CR1, T3IF))//计数器溢出，一个计数周期内没有边沿
     {
-        if (ReadBit(P1, PIN1))//PWM 100%输出
-        {
-            mcPwmInput.TimeDR = 4000;
-            mcPwmInput.TimeARR     = 4000;
-        }
-        else//PWM 为0%
-        {
-            mcPwmInput.TimeDR = 0;
-            mcPwmInput.TimeARR     = 4000;
-        }
-        
-        mcPwmInput.PwmUpdateFlag = 1;
+        AbsEnc.Stuck = ReadBit(P1, PIN1) ? ABS_STUCK_HIGH : ABS_STUCK_LOW;
         ClrBit(TIM3_CR1, T3IF);
     }
 }
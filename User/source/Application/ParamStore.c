@@ -0,0 +1,403 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : ParamStore.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 参数记录区的上电扫描、后台烧写和VISCA查询。
+                     上电时从最旧的扇区到最新的扇区依次读出CRC正确的记录，后写的覆盖先写的；
+                     记录的编号字节最先烧写，掉电留下的半条记录CRC不对被跳过，长度不对则当前扇区不再追加。
+                     换扇区时全部参数从RAM副本重新追加，旧扇区要再转一圈才被擦除。
+                     81 09 06 25 FF        -> 90 50 扇区序号 扇区号/偏移 校验失败次数 FF，各4个半字节
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+PARAM_STORE xdata Param;
+
+/* 各参数的数据长度，下标为PARAM_KEY_xxx */
+static uint8 code ParamLen[PARAM_KEY_NUM] =
+{
+    2,                                                      // PARAM_KEY_ANGLE
+    4,                                                      // PARAM_KEY_ZERO
+    4,                                                      // PARAM_KEY_FF
+    16,                                                     // PARAM_KEY_CALIB，CALIB_LEN
+    8,                                                      // PARAM_KEY_ENC，ENC_COEF_NUM x 2
+    6,                                                      // PARAM_KEY_COG
+    8,                                                      // PARAM_KEY_GAIN
+};
+
+/* 扇区Sector偏移Offset处的Flash地址 */
+#define PARAM_ADDR(Sector, Offset)      (PARAMROMADDRESS + (uint16)(Sector) * PARAM_SECTOR_SIZE + (Offset))
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Crc
+    Description    : 硬件CRC单元计算CRC16-CCITT-FALSE，计算期间关UART2中断，避免与Uart_StreamRx争用
+    Date           : 2026-10-17
+    Parameter      : Buf: [输入] 数据，可以指向Flash; Len: [输入] 字节数，只用于参数记录和校准块这样的短数据，
+                     齿槽补偿表由CogComp逐扇区软件计算，不在这里长时间关中断
+    ------------------------------------------------------------------------------------------------- */
+uint16 Param_Crc(uint8 *Buf, uint16 Len)
+{
+    uint16 Crc;
+    uint16 Ien = UT2_BAUD & UART2IEN;
+    uint16 i;
+
+    ClrBit(UT2_BAUD, UART2IEN);
+    SetBit(CRC_CR, CRCVAL);
+    SetBit(CRC_CR, CRCDINI);
+
+    for (i = 0; i < Len; i++)
+    {
+        CRC_DIN = Buf[i];
+    }
+
+    SetBit(CRC_CR, CRCPNT);
+    Crc = (uint16)CRC_DR << 8;
+    ClrBit(CRC_CR, CRCPNT);
+    Crc |= CRC_DR;
+
+    if (Ien)
+    {
+        SetBit(UT2_BAUD, UART2IEN);
+    }
+
+    return Crc;
+}
+
+/* 读取扇区头，有效时返回1并给出序号 */
+static uint8 Param_ReadHead(uint8 Sector, uint16 *Seq)
+{
+    uint8 Head[PARAM_HEAD_LEN];
+    uint8 i;
+
+    for (i = 0; i < PARAM_HEAD_LEN; i++)
+    {
+        Head[i] = *(uint8 code *)(PARAM_ADDR(Sector, i));
+    }
+
+    *Seq = ((uint16)Head[1] << 8) | Head[2];
+    return (Head[0] == PARAM_SECTOR_MARK) && (Head[3] == (uint8)~(Head[0] ^ Head[1] ^ Head[2]));
+}
+
+/* 扫描一个扇区的记录，CRC正确的写入RAM副本，返回第一个空位的偏移，记录损坏时返回扇区长度 */
+static uint8 Param_ScanSector(uint8 Sector)
+{
+    uint8 Offset = PARAM_HEAD_LEN;
+    uint8 Flag;
+    uint8 Len;
+    uint8 Key;
+    uint8 i;
+
+    while (Offset + PARAM_REC_EXTRA <= PARAM_SECTOR_SIZE)
+    {
+        Flag = *(uint8 code *)(PARAM_ADDR(Sector, Offset));
+
+        if (Flag == 0)
+        {
+            return Offset;                                  //日志结尾
+        }
+
+        Len = *(uint8 code *)(PARAM_ADDR(Sector, Offset + 1));
+        Key = Flag & ~PARAM_REC_FLAG;
+
+        if (!(Flag & PARAM_REC_FLAG) || (Len == 0) || (Len > PARAM_DATA_MAX)
+            || ((Key < PARAM_KEY_NUM) && (Len != ParamLen[Key]))
+            || (Offset + Len + PARAM_REC_EXTRA > PARAM_SECTOR_SIZE))
+        {
+            return PARAM_SECTOR_SIZE;                       //长度未写完或损坏，本扇区不再追加
+        }
+
+        for (i = 0; i < Len + PARAM_REC_EXTRA; i++)
+        {
+            Param.Rec[i] = *(uint8 code *)(PARAM_ADDR(Sector, Offset + i));
+        }
+
+        if ((Key < PARAM_KEY_NUM)
+            && (Param_Crc(Param.Rec, Len + 3) == (((uint16)Param.Rec[Len + 3] << 8) | Param.Rec[Len + 4])))
+        {
+            for (i = 0; i < Len; i++)
+            {
+                Param.Data[Key][i] = Param.Rec[3 + i];
+            }
+
+            Param.Ver[Key] = Param.Rec[2];
+            Param.Valid   |= 1 << Key;
+        }
+        else if (Key < PARAM_KEY_NUM)
+        {
+            Param.Bad     |= 1 << Key;
+        }
+
+        Offset += Len + PARAM_REC_EXTRA;
+    }
+
+    return PARAM_SECTOR_SIZE;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Init
+    Description    : 上电扫描参数记录区，建立RAM副本和写入位置，在MotorcontrolInit读取参数之前调用。
+                     换扇区总是写下一个扇区，所以从最新扇区的下一个开始绕一圈就是从旧到新的顺序。
+                     没有有效扇区时把写入位置放在最后一个扇区末尾，第一次保存从扇区0开始。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Param_Init(void)
+{
+    uint16 Seq;
+    uint8  Newest = 0xFF;
+    uint8  Sector;
+    uint8  i;
+
+    Param.Valid  = 0;
+    Param.Dirty  = 0;
+    Param.Bad    = 0;
+    Param.State  = PARAM_IDLE;
+    Param.Err    = 0;
+    Param.Seq    = 0;
+
+    for (i = 0; i < PARAM_SECTOR_NUM; i++)
+    {
+        if (Param_ReadHead(i, &Seq) && ((Newest == 0xFF) || ((int16)(Seq - Param.Seq) > 0)))
+        {
+            Newest    = i;
+            Param.Seq = Seq;
+        }
+    }
+
+    if (Newest == 0xFF)
+    {
+        Param.Sector = PARAM_SECTOR_NUM - 1;
+        Param.Offset = PARAM_SECTOR_SIZE;
+        return;
+    }
+
+    for (i = 1; i <= PARAM_SECTOR_NUM; i++)
+    {
+        Sector = (Newest + i) % PARAM_SECTOR_NUM;
+
+        if (Param_ReadHead(Sector, &Seq))
+        {
+            Param.Offset = Param_ScanSector(Sector);
+        }
+    }
+
+    Param.Sector = Newest;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Read
+    Description    : 读取参数Key的最新值(RAM副本)
+    Date           : 2026-10-17
+    Parameter      : Key: [输入] PARAM_KEY_xxx; Buf: [输出] 数据，长度为该参数的固定长度
+    Return         : 1有值，0记录区中没有该参数
+    ------------------------------------------------------------------------------------------------- */
+uint8 Param_Read(uint8 Key, uint8 *Buf)
+{
+    uint8 i;
+
+    if ((Key >= PARAM_KEY_NUM) || !(Param.Valid & (1 << Key)))
+    {
+        return 0;
+    }
+
+    for (i = 0; i < ParamLen[Key]; i++)
+    {
+        Buf[i] = Param.Data[Key][i];
+    }
+
+    return 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Write
+    Description    : 保存参数Key，只更新RAM副本并标记待写入，由Param_Task在后台烧写。只在主循环中调用
+    Date           : 2026-10-17
+    Parameter      : Key: [输入] PARAM_KEY_xxx; Buf: [输入] 数据，长度为该参数的固定长度
+    ------------------------------------------------------------------------------------------------- */
+void Param_Write(uint8 Key, uint8 *Buf)
+{
+    uint8 i;
+
+    if (Key >= PARAM_KEY_NUM)
+    {
+        return;
+    }
+
+    for (i = 0; i < ParamLen[Key]; i++)
+    {
+        Param.Data[Key][i] = Buf[i];
+    }
+
+    Param.Valid |= 1 << Key;
+    Param.Dirty |= 1 << Key;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Drop
+    Description    : 从RAM副本中删除参数Key，不再读出，换扇区时也不再搬移，Flash中的旧记录随扇区擦除消失
+    Date           : 2026-10-17
+    Parameter      : Key: [输入] PARAM_KEY_xxx
+    ------------------------------------------------------------------------------------------------- */
+void Param_Drop(uint8 Key)
+{
+    if (Key < PARAM_KEY_NUM)
+    {
+        Param.Valid &= ~(1 << Key);
+        Param.Dirty &= ~(1 << Key);
+    }
+}
+
+/* 取一个待写入的参数组成记录，当前扇区放不下时转去换扇区 */
+static void Param_NextRecord(void)
+{
+    uint16 Crc;
+    uint8  Key;
+    uint8  Len;
+    uint8  i;
+
+    for (Key = 0; Key < PARAM_KEY_NUM; Key++)
+    {
+        if (Param.Dirty & (1 << Key))
+        {
+            break;
+        }
+    }
+
+    if (Key >= PARAM_KEY_NUM)
+    {
+        return;
+    }
+
+    Len = ParamLen[Key];
+
+    if (Param.Offset + Len + PARAM_REC_EXTRA > PARAM_SECTOR_SIZE)
+    {
+        Param.State = PARAM_ERASE;
+        return;
+    }
+
+    Param.Ver[Key]++;
+    Param.Rec[0] = PARAM_REC_FLAG | Key;
+    Param.Rec[1] = Len;
+    Param.Rec[2] = Param.Ver[Key];
+
+    for (i = 0; i < Len; i++)
+    {
+        Param.Rec[3 + i] = Param.Data[Key][i];
+    }
+
+    Crc                  = Param_Crc(Param.Rec, Len + 3);
+    Param.Rec[Len + 3]   = Crc >> 8;
+    Param.Rec[Len + 4]   = Crc;
+    Param.RecLen         = Len + PARAM_REC_EXTRA;
+    Param.RecPos         = 0;
+    Param.RecKey         = Key;
+    Param.Dirty         &= ~(1 << Key);                     //烧写期间再次保存会重新置位，之后再追加一条
+    Param.State          = PARAM_PROGRAM;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Task
+    Description    : 参数后台烧写，主循环每次调用最多执行一步：组一条记录、烧写一个字节或擦除一个扇区。
+                     单字节烧写只在Flash_Sector_Write内部关中断；擦除时CPU取指暂停，只在换扇区时发生。
+                     烧写后回读不一致时记入Err，放弃当前扇区剩余空间，换扇区后重写。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Param_Task(void)
+{
+    uint16 Addr;
+    uint8  Value;
+
+    switch (Param.State)
+    {
+        case PARAM_IDLE:
+            Param_NextRecord();
+            break;
+
+        case PARAM_ERASE:
+            Param.Sector = (Param.Sector + 1) % PARAM_SECTOR_NUM;
+            Param.Offset = 0;
+            Param.Seq++;
+            Flash_Sector_Erase((uint8 xdata *)PARAM_ADDR(Param.Sector, 0));
+            Param.Rec[0] = PARAM_SECTOR_MARK;
+            Param.Rec[1] = Param.Seq >> 8;
+            Param.Rec[2] = Param.Seq;
+            Param.Rec[3] = ~(Param.Rec[0] ^ Param.Rec[1] ^ Param.Rec[2]);
+            Param.RecLen = PARAM_HEAD_LEN;
+            Param.RecPos = 0;
+            Param.RecKey = 0xFF;
+            Param.State  = PARAM_PROGRAM;
+            break;
+
+        case PARAM_PROGRAM:
+            Addr  = PARAM_ADDR(Param.Sector, Param.Offset + Param.RecPos);
+            Value = Param.Rec[Param.RecPos];
+
+            if (Value != 0)                                 //擦除后即为0，不必烧写
+            {
+                Flash_Sector_Write((uint8 xdata *)Addr, Value);
+            }
+
+            if (*(uint8 code *)(Addr) != Value)
+            {
+                if (Param.Err != 0xFFFF)
+                {
+                    Param.Err++;
+                }
+
+                if (Param.RecKey < PARAM_KEY_NUM)
+                {
+                    Param.Dirty |= 1 << Param.RecKey;
+                }
+
+                Param.Offset = PARAM_SECTOR_SIZE;
+                Param.State  = PARAM_IDLE;
+                break;
+            }
+
+            if (++Param.RecPos >= Param.RecLen)
+            {
+                Param.Offset += Param.RecLen;
+                Param.State   = (Param.RecKey < PARAM_KEY_NUM) ? PARAM_IDLE : PARAM_COMPACT;
+            }
+            break;
+
+        case PARAM_COMPACT:
+            Param.Dirty |= Param.Valid;                     //新扇区中重新追加全部参数的最新值
+            Param.State  = PARAM_IDLE;
+            break;
+
+        default:
+            Param.State = PARAM_IDLE;
+            break;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Param_Report
+    Description    : 填写参数记录区状态到应答帧
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Param_Report(void)
+{
+    uint16 Pos = ((uint16)Param.Sector << 8) | Param.Offset;
+
+    Uart.T_DATA[2]  = (Param.Seq >> 12) & 0x0F;
+    Uart.T_DATA[3]  = (Param.Seq >> 8) & 0x0F;
+    Uart.T_DATA[4]  = (Param.Seq >> 4) & 0x0F;
+    Uart.T_DATA[5]  = Param.Seq & 0x0F;
+    Uart.T_DATA[6]  = (Pos >> 12) & 0x0F;
+    Uart.T_DATA[7]  = (Pos >> 8) & 0x0F;
+    Uart.T_DATA[8]  = (Pos >> 4) & 0x0F;
+    Uart.T_DATA[9]  = Pos & 0x0F;
+    Uart.T_DATA[10] = (Param.Err >> 12) & 0x0F;
+    Uart.T_DATA[11] = (Param.Err >> 8) & 0x0F;
+    Uart.T_DATA[12] = (Param.Err >> 4) & 0x0F;
+    Uart.T_DATA[13] = Param.Err & 0x0F;
+    Uart.T_Len = 15;
+    Uart.RxFSM = 1;
+}
@@ -0,0 +1,134 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : Profile.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 中断耗时统计的初始化、清零和VISCA应答。
+                     81 01 06 20 FF        清零全部统计项
+                     81 09 06 20 0p FF     -> 90 50 最小值 平均值 最大值 样本数 FF，各4个半字节
+                     81 09 06 21 0p 0h FF  -> 90 50 直方图第4h~4h+3格 FF，各4个半字节
+                     p为统计项编号(PROF_xxx)，耗时单位为TIM4计数(1/24us)。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+PROFILE xdata Prof[PROF_NUM];
+
+/* 统计项全部清零，最小值置为最大计数以便第一次样本写入 */
+static void Profile_Clear(void)
+{
+    uint8 i;
+    uint8 j;
+
+    for (i = 0; i < PROF_NUM; i++)
+    {
+        Prof[i].Min  = 0xFFFF;
+        Prof[i].Max  = 0;
+        Prof[i].Last = 0;
+        Prof[i].Cnt  = 0;
+        Prof[i].Sum  = 0;
+
+        for (j = 0; j < PROF_HIST_NUM; j++)
+        {
+            Prof[i].Hist[j] = 0;
+        }
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Profile_Init
+    Description    : TIM4作为自由计数的时间基准，统计项清零，在HardwareInit中开中断之前调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Profile_Init(void)
+{
+    Timer4_Profile_Init();
+    Profile_Clear();
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Profile_Reset
+    Description    : 运行中清零全部统计项，关中断期间完成，避免与中断中的累计交错
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Profile_Reset(void)
+{
+    EA = 0;
+    Profile_Clear();
+    EA = 1;
+}
+
+/* 16位数值按VISCA格式拆成4个半字节 */
+static void Profile_PutWord(uint8 Pos, uint16 Value)
+{
+    Uart.T_DATA[Pos]     = (Value >> 12) & 0x0F;
+    Uart.T_DATA[Pos + 1] = (Value >> 8) & 0x0F;
+    Uart.T_DATA[Pos + 2] = (Value >> 4) & 0x0F;
+    Uart.T_DATA[Pos + 3] = Value & 0x0F;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Profile_Report
+    Description    : 填写统计项Id的最小/平均/最大耗时和样本数到应答帧，编号越界时回复无效指令
+    Date           : 2026-10-17
+    Parameter      : Id: [输入] 统计项编号
+    ------------------------------------------------------------------------------------------------- */
+void Profile_Report(uint8 Id)
+{
+    PROFILE Item;
+
+    if (Id >= PROF_NUM)
+    {
+        Send_NoActive();
+        return;
+    }
+
+    EA = 0;
+    Item = Prof[Id];
+    EA = 1;
+
+    Profile_PutWord(2, (Item.Cnt != 0) ? Item.Min : 0);
+    Profile_PutWord(6, (Item.Cnt != 0) ? (uint16)(Item.Sum / Item.Cnt) : 0);
+    Profile_PutWord(10, Item.Max);
+    Profile_PutWord(14, Item.Cnt);
+    Uart.T_Len = 19;
+    Uart.RxFSM = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Profile_ReportHist
+    Description    : 填写统计项Id直方图的一半(4格)到应答帧
+    Date           : 2026-10-17
+    Parameter      : Id: [输入] 统计项编号; Half: [输入] 0为第0~3格，1为第4~7格
+    ------------------------------------------------------------------------------------------------- */
+void Profile_ReportHist(uint8 Id, uint8 Half)
+{
+    uint16 Hist[PROF_HIST_NUM / 2];
+    uint8  i;
+
+    if ((Id >= PROF_NUM) || (Half > 1))
+    {
+        Send_NoActive();
+        return;
+    }
+
+    EA = 0;
+
+    for (i = 0; i < PROF_HIST_NUM / 2; i++)
+    {
+        Hist[i] = Prof[Id].Hist[Half * (PROF_HIST_NUM / 2) + i];
+    }
+
+    EA = 1;
+
+    for (i = 0; i < PROF_HIST_NUM / 2; i++)
+    {
+        Profile_PutWord(2 + (i << 2), Hist[i]);
+    }
+
+    Uart.T_Len = 19;
+    Uart.RxFSM = 1;
+}
@@ -65,5 +65,160 @@ void EXTI_Init(void)
     EA = 1;	
 
 }
-    
 
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : QEP_SpeedMT
+    Description    : M/T法测速，DRV_ISR中每8个载波在M法之后调用。
+                     M法窗口内脉冲数不少于SPEED_MT_CNT_MAX时直接采用M法结果；低速时以相邻两次计数变化的
+                     载波时刻为区间，用区间内脉冲数除以区间长度，区间不足SPEED_MT_SPAN_MIN时等待更多边沿。
+                     没有新边沿时速度不可能超过1个脉冲/空闲时间，据此限幅；空闲超过SPEED_MT_IDLE_MAX认为静止。
+                     Timer2工作在QEP模式时没有边沿捕获，边沿时刻以载波为单位(41.7us)。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void QEP_SpeedMT(void)
+{
+    uint16 Idle;
+    uint16 Span;
+    uint16 AbsCnt;
+    uint16 AbsSpeed;
+    uint32 Num;
+    int16  Cnt;
+
+    Idle = mcQEP.IsrTick - mcQEP.EdgeTick;
+
+    if ((mcQEP.PosDiffSum >= SPEED_MT_CNT_MAX) || (mcQEP.PosDiffSum <= -SPEED_MT_CNT_MAX))
+    {
+        mcQEP.SpeedMT      = mcQEP.SpeedM;
+        mcQEP.SpeedLatency = SPEED_M_LATENCY;
+        mcQEP.RefTick      = mcQEP.EdgeTick;
+        mcQEP.RefCntr      = mcQEP.EdgeCntr;
+    }
+    else
+    {
+        Span = mcQEP.EdgeTick - mcQEP.RefTick;
+        Cnt  = mcQEP.EdgeCntr - mcQEP.RefCntr;
+
+        if ((Cnt != 0) && (Span >= SPEED_MT_SPAN_MIN))
+        {
+            AbsCnt = ABS(Cnt);
+
+            if (AbsCnt > 255)
+            {
+                AbsCnt = 255;
+            }
+
+            Num = (uint32)AbsCnt * SPEED_MT_BASE;
+            DivQ_L_MDU((uint16)(Num >> 16), (uint16)Num, Span, AbsSpeed);
+            mcQEP.SpeedMT      = (Cnt > 0) ? (int16)AbsSpeed : -(int16)AbsSpeed;
+            mcQEP.SpeedLatency = Idle + (Span >> 1);
+            mcQEP.RefTick      = mcQEP.EdgeTick;
+            mcQEP.RefCntr      = mcQEP.EdgeCntr;
+        }
+        else if (Idle >= SPEED_MT_IDLE_MAX)
+        {
+            /* 静止时区间起点跟随当前时刻，重新起动后第一个区间不会跨越整个静止时间 */
+            mcQEP.SpeedMT      = 0;
+            mcQEP.SpeedLatency = SPEED_MT_IDLE_MAX;
+            mcQEP.RefTick      = mcQEP.IsrTick;
+            mcQEP.RefCntr      = mcQEP.EdgeCntr;
+        }
+        else if (Idle > SPEED_MT_SPAN_MIN)
+        {
+            DivQ_L_MDU(0, SPEED_MT_BASE, Idle, AbsSpeed);
+
+            if (mcQEP.SpeedMT > (int16)AbsSpeed)
+            {
+                mcQEP.SpeedMT = AbsSpeed;
+            }
+            else if (mcQEP.SpeedMT < -(int16)AbsSpeed)
+            {
+                mcQEP.SpeedMT = -(int16)AbsSpeed;
+            }
+
+            mcQEP.SpeedLatency = Idle;
+        }
+    }
+
+    mcQEP.SpeedEst = mcQEP.SpeedMT;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : QEP_SpeedReport
+    Description    : 填写测速模式、速度估计值和等效延时(载波数)到应答帧 90 50 0m 0s 0s 0s 0s 0l 0l 0l 0l FF
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void QEP_SpeedReport(void)
+{
+    uint16 Speed;
+    uint16 Latency;
+
+    EA = 0;
+    Speed   = mcQEP.SpeedEst;
+    Latency = mcQEP.SpeedLatency;
+    EA = 1;
+
+    Uart.T_DATA[2]  = mcQEP.SpeedMode;
+    Uart.T_DATA[3]  = (Speed >> 12) & 0x0F;
+    Uart.T_DATA[4]  = (Speed >> 8) & 0x0F;
+    Uart.T_DATA[5]  = (Speed >> 4) & 0x0F;
+    Uart.T_DATA[6]  = Speed & 0x0F;
+    Uart.T_DATA[7]  = (Latency >> 12) & 0x0F;
+    Uart.T_DATA[8]  = (Latency >> 8) & 0x0F;
+    Uart.T_DATA[9]  = (Latency >> 4) & 0x0F;
+    Uart.T_DATA[10] = Latency & 0x0F;
+    Uart.T_Len = 12;
+    Uart.RxFSM = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : QEP_Observer
+    Description    : 位置/速度/负载转矩三阶观测器(固定增益，即稳态卡尔曼滤波器的形式)，DRV_ISR中每8个载波调用。
+                     以观测周期内的平均转矩电流按Kt/J推算速度变化，用观测位置与编码器位置之差校正三个状态，
+                     三个极点重合在OBS_BW。位置只保存与实测位置之差，不受累计脉冲数范围限制。
+                     输出写入SpeedMFlt作为速度环反馈，负载转矩写入ObsLoadIq。模型以外的转矩变化要经过
+                     约1/(2π·OBS_BW)才反映到速度估计，按此加半个观测周期上报等效延时OBS_LATENCY。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void QEP_Observer(void)
+{
+    int32 Iq;
+    int32 Err;
+
+    Iq              = mcQEP.ObsIqSum >> 3;
+    mcQEP.ObsIqSum  = 0;
+
+    /* 预测：观测位置按观测速度前进，实测位置按本周期脉冲数前进 */
+    mcQEP.ObsPosErr += mcQEP.ObsSpeed - ((int32)mcQEP.PosDiff << 16);
+    Err = -(mcQEP.ObsPosErr >> 8);
+
+    if (Err > 32767)
+    {
+        Err = 32767;
+    }
+    else if (Err < -32767)
+    {
+        Err = -32767;
+    }
+
+    /* 校正 */
+    mcQEP.ObsPosErr += Err * OBS_L1;
+    mcQEP.ObsSpeed  += (((Iq - (mcQEP.ObsLoad >> 8)) * OBS_B) >> 8) + ((Err * OBS_L2) >> 4);
+    mcQEP.ObsLoad   -= Err * OBS_L3;
+
+    if (mcQEP.ObsLoad > ((int32)32767 << 8))
+    {
+        mcQEP.ObsLoad = (int32)32767 << 8;
+    }
+    else if (mcQEP.ObsLoad < -((int32)32767 << 8))
+    {
+        mcQEP.ObsLoad = -((int32)32767 << 8);
+    }
+
+    mcQEP.ObsLoadIq    = mcQEP.ObsLoad >> 8;
+    mcQEP.SpeedEst     = OBS_SPEED_TO_S(mcQEP.ObsSpeed);
+    mcQEP.SpeedLatency = OBS_LATENCY;
+    mcQEP.SpeedMFlt    = mcQEP.SpeedEst;
+}
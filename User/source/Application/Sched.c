@@ -0,0 +1,122 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : Sched.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 多速率任务表和节拍计数。
+                     Sched_FastTick只在DRV_ISR中调用，Sched_SlowTick只在SYStick_INT中调用，
+                     两组计数互不写对方，不同优先级的中断之间不共用函数。
+                     81 09 06 22 0t FF     -> 90 50 超时次数 FF，4个半字节，t为任务编号(SCHED_xxx)
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+/* 相位按节拍数取余错开：位置环 ≡1 (mod 3)，串口计时 ≡0 (mod 2)，缺相检测 ≡5 (mod 102) 与前两者都不重合 */
+SCHED_TASK code SchedTask[SCHED_TASK_NUM] =
+{
+    {8,   0, SCHED_US(10)},                                 // SCHED_FAST_SPEED
+    {3,   1, SCHED_US(20)},                                 // SCHED_SLOW_POS_LOOP
+    {2,   0, SCHED_US(5)},                                  // SCHED_SLOW_GO_TIME
+    {102, 5, SCHED_US(60)},                                 // SCHED_SLOW_PHASE_LOSS
+};
+
+uint8  idata SchedCnt[SCHED_TASK_NUM];
+uint16 xdata SchedOverrun[SCHED_TASK_NUM];
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sched_Init
+    Description    : 各任务计数置为相位值，超时计数清零，在开中断之前调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Sched_Init(void)
+{
+    uint8 i;
+
+    for (i = 0; i < SCHED_TASK_NUM; i++)
+    {
+        SchedCnt[i]     = SchedTask[i].Phase;
+        SchedOverrun[i] = 0;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sched_FastTick
+    Description    : DRV_ISR每个载波调用一次，更新载波任务的计数，计数为0的任务本载波到期
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Sched_FastTick(void)
+{
+    uint8 i;
+
+    for (i = 0; i < SCHED_FAST_NUM; i++)
+    {
+        SchedCnt[i] = (SchedCnt[i] == 0) ? (SchedTask[i].Div - 1) : (SchedCnt[i] - 1);
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sched_SlowTick
+    Description    : SYStick_INT每个节拍调用一次，更新节拍任务的计数
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Sched_SlowTick(void)
+{
+    uint8 i;
+
+    for (i = SCHED_FAST_NUM; i < SCHED_TASK_NUM; i++)
+    {
+        SchedCnt[i] = (SchedCnt[i] == 0) ? (SchedTask[i].Div - 1) : (SchedCnt[i] - 1);
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sched_Reset
+    Description    : 运行中清零全部超时计数
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Sched_Reset(void)
+{
+    uint8 i;
+
+    EA = 0;
+
+    for (i = 0; i < SCHED_TASK_NUM; i++)
+    {
+        SchedOverrun[i] = 0;
+    }
+
+    EA = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Sched_Report
+    Description    : 填写任务Id的超时次数到应答帧，编号越界时回复无效指令
+    Date           : 2026-10-17
+    Parameter      : Id: [输入] 任务编号
+    ------------------------------------------------------------------------------------------------- */
+void Sched_Report(uint8 Id)
+{
+    uint16 Overrun;
+
+    if (Id >= SCHED_TASK_NUM)
+    {
+        Send_NoActive();
+        return;
+    }
+
+    EA = 0;
+    Overrun = SchedOverrun[Id];
+    EA = 1;
+
+    Uart.T_DATA[2] = (Overrun >> 12) & 0x0F;
+    Uart.T_DATA[3] = (Overrun >> 8) & 0x0F;
+    Uart.T_DATA[4] = (Overrun >> 4) & 0x0F;
+    Uart.T_DATA[5] = Overrun & 0x0F;
+    Uart.T_Len = 7;
+    Uart.RxFSM = 1;
+}
@@ -0,0 +1,365 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : Scope.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : 片上示波器，Scope_Sample在DRV_ISR中调用，其余在主循环中调用。
+                     1. 配置通道后启动，每Div个载波周期把各通道写入环形缓冲区的一条记录。
+                     2. 预触发部分记满Pre条之前触发也立即生效，Fill为触发前实际记录的条数；
+                        触发那一条之后再记录Depth - Pre - 1条，缓冲区冻结，下标0为最早一条，触发在下标Pre，
+                        下标小于Pre - Fill的记录无效。
+                     3. 冻结后不再写入，逐条读出或在SPI软件调试模式下按载波频率循环写入spidebug，
+                        SPI_Monitor上得到时间放大Div倍的波形。
+                     81 01 06 2B 0n 0s*8 FF         配置n个通道，s为各通道SCOPE_SIG_xxx，多余的填0，停止记录
+                     81 01 06 2C 0t 0d 0d 0p 0p 0l*4 FF
+                                                    启动记录，t为触发源SCOPE_TRIG_xxx组合，d为分频，
+                                                    p为预触发记录数，l为位置误差触发阈值
+                     81 01 06 2D 0m FF              m为SCOPE_CTL_xxx
+                     81 09 06 2B FF                 -> 90 50 0s 0c 深度 预触发数 实际预触发数 FF
+                     81 09 06 2C 0i*4 0h FF         -> 90 50 第i条记录的第4h~4h+3路 FF，缓冲区冻结后才有效
+                     s为Scope.State，c为Scope.Cause，其余各4个半字节。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+#if (SCOPE_ENABLE)
+
+SCOPE xdata Scope;
+static int16 xdata ScopeBuf[SCOPE_BUF_WORDS];
+
+extern int32 PosErr;
+extern int32 speedErr;
+
+/*  读取一路信号。PosErr/speedErr由Speed_response写入，DRV_ISR可能在写入中途打断，
+    偶尔读到半新半旧的值，在波形上表现为孤立的一个点 */
+static int16 Scope_Read(uint8 Sig)
+{
+    switch (Sig)
+    {
+        case SCOPE_SIG_THETA:       return FOC__THETA;
+        case SCOPE_SIG_IQREF:       return FOC_IQREF;
+        case SCOPE_SIG_IQ:          return FOC__IQ;
+        case SCOPE_SIG_IDREF:       return FOC_IDREF;
+        case SCOPE_SIG_ID:          return FOC__ID;
+        case SCOPE_SIG_UQ:          return FOC__UQ;
+        case SCOPE_SIG_UD:          return FOC__UD;
+        case SCOPE_SIG_POS_ERR:     return (int16)PosErr;
+        case SCOPE_SIG_SPEED_ERR:   return (int16)speedErr;
+        case SCOPE_SIG_SPEED:       return mcQEP.SpeedMFlt;
+        case SCOPE_SIG_POS:         return (int16)mcQEP.CntrSumReal;
+        case SCOPE_SIG_POS_REF:     return (int16)mcSP.PulsesNum;
+        default:                    return 0;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Init
+    Description    : 默认记录电角度、Iq给定、实测Iq和位置误差，不记录。在HardwareInit中开中断之前调用，电机重启不清除
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Init(void)
+{
+    Scope.State  = SCOPE_IDLE;
+    Scope.Replay = 0;
+    Scope.Cause  = 0;
+    Scope.Num    = 4;
+    Scope.Sig[0] = SCOPE_SIG_THETA;
+    Scope.Sig[1] = SCOPE_SIG_IQREF;
+    Scope.Sig[2] = SCOPE_SIG_IQ;
+    Scope.Sig[3] = SCOPE_SIG_POS_ERR;
+    Scope.Depth  = SCOPE_BUF_WORDS / 4;
+    Scope.Size   = SCOPE_BUF_WORDS;
+    Scope.Div    = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Config
+    Description    : 设置通道和记录深度并停止记录，缓冲区内容作废。通道数或信号编号越界时不改
+    Date           : 2026-10-17
+    Parameter      : Num: [输入] 通道数; Sig: [输入] 各通道的SCOPE_SIG_xxx
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Config(uint8 Num, uint8 *Sig)
+{
+    uint8 i;
+
+    if ((Num == 0) || (Num > SCOPE_CH_MAX))
+    {
+        return;
+    }
+
+    for (i = 0; i < Num; i++)
+    {
+        if (Sig[i] >= SCOPE_SIG_NUM)
+        {
+            return;
+        }
+    }
+
+    EA = 0;
+    Scope.State  = SCOPE_IDLE;
+    Scope.Replay = 0;
+    Scope.Cause  = 0;
+    Scope.Num    = Num;
+
+    for (i = 0; i < Num; i++)
+    {
+        Scope.Sig[i] = Sig[i];
+    }
+
+    Scope.Depth = SCOPE_BUF_WORDS / Num;
+    Scope.Size  = Scope.Depth * Num;
+    EA = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Arm
+    Description    : 从缓冲区开头重新记录并等待触发，Mask为0时预触发部分记满即触发
+    Date           : 2026-10-17
+    Parameter      : Mask: [输入] SCOPE_TRIG_xxx组合; Div: [输入] 分频，0按1处理;
+                     Pre: [输入] 预触发记录数，不超过Depth - 1; Level: [输入] 位置误差触发阈值(计数)
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Arm(uint8 Mask, uint8 Div, uint8 Pre, uint16 Level)
+{
+    EA = 0;
+    Scope.Mask   = Mask & (SCOPE_TRIG_FAULT | SCOPE_TRIG_POS | SCOPE_TRIG_CMD);
+    Scope.Div    = (Div != 0) ? Div : 1;
+    Scope.DivCnt = Scope.Div - 1;                           // 启动后的第一个载波周期就记录
+    Scope.Pre    = (Pre < Scope.Depth) ? Pre : (Scope.Depth - 1);
+    Scope.Level  = Level;
+    Scope.Fill   = 0;
+    Scope.Post   = 0;
+    Scope.Wr     = 0;
+    Scope.Rd     = 0;
+    Scope.Cause  = 0;
+    Scope.Req    = 0;
+    Scope.Cmd    = mcSP.Cmd;
+    Scope.Replay = 0;
+    Scope.State  = SCOPE_ARMED;
+    EA = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Control
+    Description    : 停止记录、强制触发或选择向spidebug回放的通道
+    Date           : 2026-10-17
+    Parameter      : Ctl: [输入] SCOPE_CTL_xxx
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Control(uint8 Ctl)
+{
+    EA = 0;
+
+    switch (Ctl)
+    {
+        case SCOPE_CTL_STOP:
+            if (Scope.State != SCOPE_DONE)
+            {
+                Scope.State = SCOPE_IDLE;
+            }
+            break;
+
+        case SCOPE_CTL_FORCE:
+            Scope.Req |= SCOPE_TRIG_FORCE;
+            break;
+
+        #if (DBG_MODE == SPI_DBG_SW)
+        case SCOPE_CTL_REPLAY_OFF:
+            Scope.Replay = 0;
+            break;
+
+        case SCOPE_CTL_REPLAY_LO:
+        case SCOPE_CTL_REPLAY_HI:
+            if (Scope.State == SCOPE_DONE)
+            {
+                Scope.Replay = Ctl - SCOPE_CTL_REPLAY_OFF;
+                Scope.Rd     = Scope.Wr;
+            }
+            break;
+        #endif
+
+        default:
+            break;
+    }
+
+    EA = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Sample
+    Description    : 在DRV_ISR中Scope.State为SCOPE_ARMED或SCOPE_POST时调用，每Div次写入一条记录并判断触发
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Sample(void)
+{
+    int16 xdata *Rec;
+    int16 Err;
+    uint8 Trig;
+    uint8 i;
+
+    if (++Scope.DivCnt < Scope.Div)
+    {
+        return;
+    }
+
+    Scope.DivCnt = 0;
+    Rec = &ScopeBuf[Scope.Wr];
+
+    for (i = 0; i < Scope.Num; i++)
+    {
+        Rec[i] = Scope_Read(Scope.Sig[i]);
+    }
+
+    Scope.Wr += Scope.Num;
+
+    if (Scope.Wr >= Scope.Size)
+    {
+        Scope.Wr = 0;
+    }
+
+    if (Scope.State == SCOPE_POST)
+    {
+        if (--Scope.Post == 0)
+        {
+            Scope.State = SCOPE_DONE;                       // Wr指向最早一条
+        }
+        return;
+    }
+
+    Trig = Scope.Req;
+
+    if ((Scope.Mask & SCOPE_TRIG_FAULT) && (mcFaultSource != FaultNoSource))
+    {
+        Trig |= SCOPE_TRIG_FAULT;
+    }
+
+    if ((Scope.Mask & SCOPE_TRIG_CMD) && (mcSP.Cmd != Scope.Cmd))
+    {
+        Trig |= SCOPE_TRIG_CMD;
+    }
+
+    if (Scope.Mask & SCOPE_TRIG_POS)
+    {
+        Err = (int16)PosErr;
+
+        if ((uint16)((Err < 0) ? -Err : Err) >= Scope.Level)
+        {
+            Trig |= SCOPE_TRIG_POS;
+        }
+    }
+
+    if ((Scope.Mask == 0) && (Scope.Fill >= Scope.Pre))
+    {
+        Trig |= SCOPE_TRIG_FORCE;
+    }
+
+    if (Trig == 0)
+    {
+        if (Scope.Fill < Scope.Pre)
+        {
+            Scope.Fill++;
+        }
+        return;
+    }
+
+    Scope.Cause = Trig;
+    Scope.Req   = 0;
+    Scope.Post  = Scope.Depth - Scope.Pre - 1;
+
+    if (Scope.Post == 0)
+    {
+        Scope.State = SCOPE_DONE;
+    }
+    else
+    {
+        Scope.State = SCOPE_POST;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Replay
+    Description    : 在DRV_ISR中Scope.Replay不为0时代替spidebug的填写，每个载波周期写入一条记录的4路，
+                     不存在的通道写0，最后一条之后回到最早一条
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Replay(void)
+{
+    int16 xdata *Rec = &ScopeBuf[Scope.Rd];
+    uint8 Ch = (Scope.Replay - 1) << 2;
+    uint8 i;
+
+    for (i = 0; i < 4; i++, Ch++)
+    {
+        spidebug[i] = (Ch < Scope.Num) ? Rec[Ch] : 0;
+    }
+
+    Scope.Rd += Scope.Num;
+
+    if (Scope.Rd >= Scope.Size)
+    {
+        Scope.Rd = 0;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_Report
+    Description    : 应答记录状态、触发源、深度、预触发数和实际预触发数
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Scope_Report(void)
+{
+    SCOPE Cur;
+
+    EA = 0;
+    Cur = Scope;
+    EA = 1;
+
+    Uart.T_DATA[2] = Cur.State;
+    Uart.T_DATA[3] = Cur.Cause;
+    Uart_PutWord(4, Cur.Depth);
+    Uart_PutWord(8, Cur.Pre);
+    Uart_PutWord(12, Cur.Fill);
+    Uart.T_Len = 17;
+    Uart.RxFSM = 1;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Scope_ReportRecord
+    Description    : 应答冻结缓冲区中第Idx条记录(0为最早一条)的4路，未冻结或越界时回复无效指令
+    Date           : 2026-10-17
+    Parameter      : Idx: [输入] 记录下标; Half: [输入] 0为第0~3路，1为第4~7路
+    ------------------------------------------------------------------------------------------------- */
+void Scope_ReportRecord(uint16 Idx, uint8 Half)
+{
+    uint16 Pos;
+    uint8  Ch;
+    uint8  i;
+
+    if ((Scope.State != SCOPE_DONE) || (Idx >= Scope.Depth) || (Half > 1))
+    {
+        Send_NoActive();
+        return;
+    }
+
+    Pos = Scope.Wr + Idx * Scope.Num;
+
+    if (Pos >= Scope.Size)
+    {
+        Pos -= Scope.Size;
+    }
+
+    Ch = Half << 2;
+
+    for (i = 0; i < 4; i++, Ch++)
+    {
+        Uart_PutWord(2 + (i << 2), (Ch < Scope.Num) ? ScopeBuf[Pos + Ch] : 0);
+    }
+
+    Uart.T_Len = 19;
+    Uart.RxFSM = 1;
+}
+
+#endif
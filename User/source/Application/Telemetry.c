@@ -0,0 +1,80 @@
+/*  --------------------------- (C) COPYRIGHT 2020 Fortiortech ShenZhen -----------------------------
+    File Name      : Telemetry.c
+    Author         : Fortiortech  Appliction Team
+    Version        : V1.0
+    Date           : 2026-10-17
+    Description    : UART1遥测，Telem_Tick在SYStick_INT中Speed_response之后调用。
+                     Speed_response用TELEM_PUT把位置误差、速度误差和Iq给定(到位保持中为保持电流)写入
+                     Telem.Frame，Telem_Tick补上实测量后启动DMA1并切换到另一帧，正在发送的一帧不会被改写；
+                     DMA1仍在发送时计数，本帧留到下次再交。
+    ----------------------------------------------------------------------------------------------------
+                                       All Rights Reserved
+    ------------------------------------------------------------------------------------------------- */
+#include <MyProject.h>
+
+#if (DBG_MODE == UART_DBG)
+
+TELEM xdata Telem;
+TELEM_FRAME xdata TelemBuf[2];
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Telem_Init
+    Description    : UART1改为TELEM_BAUD_RATE，DMA1配置为XDATA->UART1，帧头写入两个缓冲区。
+                     在DebugSet中UART1_Init之后、开中断之前调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Telem_Init(void)
+{
+    UT_BAUD = TELEM_BAUD_REG;
+    SetPipe_DMA1(DRAM_UART);
+    SetEndian_DMA(BIG_ENDIAN);                              // 按内存顺序发送，DMA0的VISCA应答也是逐字节顺序
+    TelemBuf[0].Head = TELEM_HEAD;
+    TelemBuf[1].Head = TELEM_HEAD;
+    Telem.Frame = &TelemBuf[0];
+    Telem.Div   = 0;
+    Telem.Seq   = 0;
+    Telem.Drop  = 0;
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Telem_Tick
+    Description    : 每TELEM_DIV个SysTick周期补上实测量，把正在填写的一帧交给DMA1并切换到另一帧。
+                     DMA1仍在发送上一帧时不切换，本帧继续填写，下次再交
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Telem_Tick(void)
+{
+    TELEM_FRAME xdata *Frame = Telem.Frame;
+
+    if (++Telem.Div < TELEM_DIV)
+    {
+        return;
+    }
+
+    Telem.Div = 0;
+
+    if (ReadBit(DMA1_CR0, DMABSY))
+    {
+        if (Telem.Drop != 0xFFFF)
+        {
+            Telem.Drop++;
+        }
+        return;
+    }
+
+    Frame->Seq   = Telem.Seq++;
+    Frame->Speed = mcQEP.SpeedMFlt;
+    Frame->Iq    = FOC__IQ;
+    Frame->Id    = FOC__ID;
+    Frame->Uq    = FOC__UQ;
+    Frame->Pos   = (int16)mcQEP.CntrSumReal;
+
+    DMA1_LEN = TELEM_LEN - 1;
+    DMA1_BA  = (uint16)Frame & 0x07FF;
+    SetBit(DMA1_CR0, DMAEN | DMABSY);
+    Telem.Frame = (Frame == &TelemBuf[0]) ? &TelemBuf[1] : &TelemBuf[0];
+}
+
+#endif
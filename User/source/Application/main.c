@@ -17,8 +17,9 @@
 ********************************************************************************/
 void HardwareInit(void);
 void SoftwareInit(void);
+void SystemInit(void);
+void BackgroundLoop(void);
 void VREFConfigInit(void);
-uint8 SYST_Times;
 /********************************************************************************
     Macro & Structure Definition
 ********************************************************************************/
@@ -34,13 +35,6 @@ uint8 SYST_Times;
         Input         : 无
         Output        : 无
     -------------------------------------------------------------------------------------------------*/
-typedef struct
-{
-    uint8   Length;
-    uint8   CheckSum;
-    uint8   T_DATA[20];
-} TypeDef_UartANO;
-
 void DebugSet(void)
 {
     #if (DBG_MODE == SPI_DBG_HW)        // 硬件调试模式
@@ -53,11 +47,10 @@ void DebugSet(void)
         SPI_Init();
         Set_DBG_DMA(spidebug);
     }
-    #elif (DBG_MODE == UART_DBG)        // UART调试模式
+    #elif (DBG_MODE == UART_DBG)        // UART1遥测模式
     {
-//        UART2_Init();
-				UART1_Init();
-        SetPipe_DMA0(DRAM_UART2);
+        UART1_Init();
+        Telem_Init();
     }
     #endif
 }
@@ -83,6 +76,15 @@ void HardwareInit(void)
     //  TIM1_HALL_Init();
     Timer2_QEP_Init();
     Timer3_Init();
+    #if (PROFILE_ENABLE)
+    Profile_Init();
+    #endif
+    #if (SCOPE_ENABLE)
+    Scope_Init();
+    #endif
+    Sched_Init();
+    AbsEnc_Init();
+    Ctrl_PidInit(&mcPosPID, POS_LOOP_KP, POS_LOOP_KI, POS_LOOP_KD, -POS_LOOP_OUT, POS_LOOP_OUT);
     VREFConfigInit();  /* ADC参考电压电压配置 */
     ADC_Init();
     AMP_Init();
@@ -91,8 +93,6 @@ void HardwareInit(void)
     //Timer4_Init();
     /* -----SYSTICK定时器配置----- */
     SYST_ARR = 12000;   //4000
-    //    SYST_Times  = MCU_CLOCK * (1000000 / 6000) / 1000;
-    SYST_Times  = MCU_CLOCK / (12000 / 1000.0);
     SetBit(DRV_SR, SYSTIE);
     //    ClrBit(P2_OE, P26);                       /* 0: Disable digital output */
     //    ClrBit(P2_PU, P26);                       /* 0: Disable internal pull up */
@@ -118,33 +118,6 @@ void SoftwareInit(void)
     Date           : 2020-04-12
     Parameter      : None
     ------------------------------------------------------------------------------------------------- */
-float Vofa_Data[7] = {0};
-TypeDef_UartANO     xdata UART_ANO;
-
-void Float2Char(float * DataTemp, uint8 * P, uint8 length) //适配Vofa上位机
-{
-    unsigned char j  = 0;
-    
-    for (j = 0; j < length; j++)
-    {
-        P[(j << 2) + 3] = *((uint8 *)(DataTemp + j));
-        P[(j << 2) + 2] = *((uint8 *)(DataTemp + j) + 1);
-        P[(j << 2) + 1] = *((uint8 *)(DataTemp + j) + 2);
-        P[(j << 2)] = *((uint8 *)(DataTemp + j) + 3);
-    }
-}
-
-void Vofa_SendData(float * VofaData, uint8 length)
-{
-    /*************发送数据*************************/
-    memcpy(UART_ANO.T_DATA, (uint8 *)VofaData, ((length << 2))); //通过拷贝把数据重新整理 这个要小端对齐
-    Float2Char(VofaData, UART_ANO.T_DATA, length); //小端调整为大端
-    UART_ANO.T_DATA[(length << 2)] = 0x00;          //写如结尾数据
-    UART_ANO.T_DATA[(length << 2) + 1] = 0x00;
-    UART_ANO.T_DATA[(length << 2) + 2] = 0x80;
-    UART_ANO.T_DATA[(length << 2) + 3] = 0x7f;
-}
-
 void VREFConfigInit(void)
 {
     /* ***********************VREF&VHALF Config*********************** */
@@ -185,29 +158,13 @@ void UART1_Init_Debuger(void)
     UT_BAUD = 0x000c;           // 9B-->9600 0x000c-->115200 0x0005-->256000 0x0006-->250000
 }
 
-//void DMA1_XRAMToUART_Init(uint16 Addr,uint8 Length)
-//{
-//    SetReg(DMA1_CR0, DMAEN | DMACFG2 | DMACFG1 | DMACFG0 | DMAIE, DMACFG0);
-//      DMA1_LEN = Length-1;                                // 设置DMA1发送数量为8
-//    DMA1_BA = Addr & 0x07ff;                            // 设置DMA1发送首地址
-//    Switch_DMA(1);                                      // 启动DMA1
-//}
-
-uint8 cnt = 0;
-void DMA1_XRAMToUART_Init(uint16 Addr, uint8 Length)
-{
-    SetReg(DMA1_CR0, DMAEN | DMACFG2 | DMACFG1 | DMACFG0 | DMAIE, DMACFG2 | DMACFG1 | DMACFG0);
-    DMA1_LEN = Length - 1;                              // 设置DMA1发送数量为8
-    DMA1_BA = Addr & 0x07ff;                            // 设置DMA1发送首地址
-    Switch_DMA(1);                                      // 启动DMA1
-}
-
-extern int32  PosErr;
-extern int32  speedRef;
-extern int32  speedErr;
-extern int16  t1;
-
-void main(void)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name : void SystemInit(void)
+    Description   : 上电初始化，硬件、软件及通讯初始化
+    Input         : 无
+    Output        : 无
+    -------------------------------------------------------------------------------------------------*/
+void SystemInit(void)
 {
     uint16 PowerUpCnt = 0;
     
@@ -219,48 +176,72 @@ void main(void)
     DebugSet();
     #if (REF_MODE == UARTMODE)
     UART2_Init();
-    SetPipe_DMA0(DRAM_UART2);
+    Uart_TxInit();
     #endif
     EA = 1;
 		memset(&UqPo,0,sizeof(UQ_Posi));
 		UqPo.UqPosiLockFlag = 1;//用dq电压锁轴的标志位，1表示可以锁轴，0表示已经锁轴了
     isCtrlPowerOn = true;
     Speed_Handle(0x79);
-	//DMA1_XRAMToUART_Init(Uart.T_DATA, 20); //
-    while (1)
-    {
-            
-        /* -----Current calibration----- */
-        GetCurrentOffset();
-        /* -----Motor Control State----- */
-        MC_Control();
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name : void BackgroundLoop(void)
+    Description   : 主循环单次执行内容，电流校准、电机状态机及串口指令处理
+    Input         : 无
+    Output        : 无
+    -------------------------------------------------------------------------------------------------*/
+void BackgroundLoop(void)
+{
         
+    /* -----Current calibration----- */
+    GetCurrentOffset();
+    AbsEnc_Task();                                          //PWM编码器帧检查和中值滤波
+    /* -----Motor Control State----- */
+    MC_Control();
+    
+
+    if (Uart.NoActiveReq)
+    {
+        Uart.NoActiveReq = 0;
+        Send_NoActive();
+    }
+
+    /* -----零位自学习模式或校准块无效时保存预定位学到的PWM编码器零位角----- */
+    if (((GP42 == 0) || Calib.Relearn) && (mcFocCtrl.Lrean_State == 1))
+    {
+        mcFocCtrl.Lrean_State = 0;
+        Calib.Blk.AngleFlt    = mcFocCtrl.LreanAngle;
+        Calib.Blk.Flags      |= CALIB_F_ANGLE;
+        mcQEP.AngleFlt        = mcFocCtrl.LreanAngle;
+        Calib_Save();
+    }
+
+    Param_Task();                                           //参数后台烧写，每次最多一个字节
+    EncComp_Task();                                         //编码器偏心标定，找到Z后打开补偿
+    CogComp_Task();                                         //齿槽补偿表学习，找到Z后打开补偿
+    #if (CALIB_TOOL_ENABLE)
+    AutoTune_Task();                                        //电流环和速度环参数自整定
+    #endif
 
-        if (!Learn.FilishFlag)
-        {
+    if (!Learn.FilishFlag)
+    {
 						UartDealComm();
-            Self_Learning(); //Z信号自学习
-        }
-        
+        Self_Learning(); //Z信号自学习
+    }
+    
 				if (Learn.State == LearnOver)
-        {            
+    {            
 			  UartDealComm2();
-        }
-			   
-			
+    }
+}
 
-        #if 0 //打开串口会影响上电动作
-				if((mcQEP.g1msflg >= 10)&&(Learn.FilishFlag))
-				{
-					mcQEP.g1msflg = 0;
-					Wait_DMA(1);
-					Vofa_Data[0] = PosErr;
-					Vofa_Data[1] = speedErr;//mcQEP.AbsSpeed ;//mcQEP.CntrSum;
-					Vofa_Data[2] = FOC_IQREF ; //
-					Vofa_Data[3] = mcQEP.SpeedMFlt;//mcQEP.Cntr&0X00FF;//
-					Vofa_SendData(Vofa_Data, 4);
-					Switch_DMA(1);
-				}
-        #endif
+void main(void)
+{
+    SystemInit();
+    
+    while (1)
+    {
+        BackgroundLoop();
     }
-}
\ No newline at end of file
+}
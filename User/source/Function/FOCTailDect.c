@@ -145,8 +145,8 @@ void FOCCloseLoopStart(void)
     ClrBit(FOC_CR1, RFAE);                         // 禁止强拉
     SetBit(FOC_CR1, ANGM);                         // 估算模式
     //电流环的PI和输出限赋值
-    FOC_DQKP = DQKP;
-    FOC_DQKI = DQKI;
+    FOC_DQKP = AutoTune.DqKp;
+    FOC_DQKI = AutoTune.DqKi;
     FOC_DMAX = DOUTMAX;
     FOC_DMIN = DOUTMIN;
     FOC_QMAX = QOUTMAX;
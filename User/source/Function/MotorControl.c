@@ -11,8 +11,6 @@
 /* Private variables ----------------------------------------------------------------------------*/
 MotStaType mcState;
 MotStaM    McStaSet;
-float PwmDutyFlt;
-float Angle;
 
 /* -------------------------------------------------------------------------------------------------
     Function Name  : MC_Control
@@ -46,10 +44,9 @@ void MC_Control(void)
             }
             #else
             {               
-                if (GP42)
+                if (GP42 && !Calib.Relearn)                      //零位角无效时同自学习模式，先预定位
                 {
-                    PWMInputCapture();
-                    if((mcPwmInput.PwmDuty > 0) && (mcPwmInput.PwmDuty < _Q15(1.0)))
+                    if (AbsEnc_Ready(ABS_JITTER_MAX))           //PWM编码器中值读数可用后再启动
                     {
                         mcState                 = mcStart;                   
                         TIM2__CNTR = 0;
@@ -74,15 +71,16 @@ void MC_Control(void)
             }
             #else
             {
-                if (mcFocCtrl.State_Count == 0)
+                if ((mcFocCtrl.State_Count == 0)                                    //转子静止且PWM编码器读数稳定即结束预定位，最长Align_Time
+                    || ((mcFocCtrl.State_Count <= Align_Time - ABS_ALIGN_MIN) && AbsEnc_Ready(ABS_ALIGN_JITTER)))
                 {
                     mcFocCtrl.SpeedFlt  = 0;
-                    PWMInputCapture();
-                    mcPwmInput.PwmDuty = _Q15((float)mcPwmInput.TimeDR/mcPwmInput.TimeARR);
-                    PwmDutyFlt = mcPwmInput.PwmDuty / 32767.0;
-                    Angle = (PwmDutyFlt * 4098 - 1) / 4095 * 360.0;
-                    mcFocCtrl.LreanAngle = FOC__THETA + _Q15(Angle /360.0);
+                    mcFocCtrl.LreanAngle = FOC__THETA + AbsEnc_Angle(AbsEnc.Duty);
                     mcFocCtrl.Lrean_State = 1;
+                    if (GP42)
+                    {
+                        EX0 = 1;                                    //校准块无效时的重新学习，之后仍用Z信号找零位
+                    }
                     mcFocCtrl.SpeedFlt  = 0;
                     mcState             = mcStart;
                     TIM2__CNTR = 0;
@@ -11,7 +11,6 @@
 
 CurrentOffset xdata mcCurOffset;
 bool OpenFlag;
-uint8 Data[4]={0};
 
 /* -------------------------------------------------------------------------------------------------
     Function Name  : FOC_Init
@@ -238,21 +237,17 @@ extern uint8  HallStatus;
 void Motor_Open(void)
 {
     static uint8 OpenRampCycles;
-    float PwmDuty;
-    float Angle;
     if (McStaSet.SetFlag.StartSetFlag == 0)
     {
         McStaSet.SetFlag.StartSetFlag = 1;
         FOC_Init();
         DRV_CMR |= 0x3F;                         // U、V、W相输出
         MOE = 1;
-        if (GP42) 
+        if (GP42 && !Calib.Relearn) 
         {
-            mcFocCtrl.LreanAngleFlt = (float)((int32)mcQEP.AngleFlt * 360.0) / 32767;
-            PwmDuty = mcPwmInput.PwmDuty / 32767.0;
-            Angle = (PwmDuty * 4098 - 1) / 4095 * 360.0 - mcFocCtrl.LreanAngleFlt;//(float)((int32)mcQEP.AngleFlt * 360.0) / 32767;
-            TIM2__CNTR = -P_Value(Angle) / Pole_Pairs;
-            FOC__THETA = _Q15(Angle /180.0);//ABS(mcFocCtrl.LreanAngleFlt) + ABS(mcFocCtrl.LreanAngleFlt);
+            mcFocCtrl.LreanAngleFlt = AbsEnc_OffsetDeg(mcQEP.AngleFlt);
+            TIM2__CNTR = AbsEnc_Cntr(AbsEnc.Duty, mcFocCtrl.LreanAngleFlt);
+            FOC__THETA = AbsEnc_Theta(AbsEnc.Duty, mcFocCtrl.LreanAngleFlt);
         }
         else 
         {
@@ -265,8 +260,8 @@ void Motor_Open(void)
         /*启动电流、KP、KI、FOC_EKP、FOC_EKI*/
         FOC_IDREF = ID_Start_CURRENT;                         // D轴启动电流
         FOC_IQREF = IQ_Start_CURRENT;                          // Q轴启动电流
-        FOC_DQKP            = DQKP;
-        FOC_DQKI            = DQKI;
+        FOC_DQKP            = AutoTune.DqKp;
+        FOC_DQKI            = AutoTune.DqKi;
         //    #elif (Open_Start_Mode == Open_Start)
         FOC_RTHEACC      = 0;      // 爬坡函数的初始加速度
         FOC__RTHESTEP    = 0;      // 0.62 degree acce speed
@@ -341,16 +336,18 @@ void MotorcontrolInit(void)
     debug_Cal = QEPSpeedBase;
     mcQEP.SpeedCalBaseH = (QEPSpeedBase >> 16);
     mcQEP.SpeedCalBaseL = (QEPSpeedBase);
+    mcQEP.SpeedMode     = SPEED_MODE_DEFAULT;
     Learn.FilishFlag = 0;
 //    mcQEP.ZSaveFlag = 1;
-    Data[0] =  *(uint8 code *)(STARTPAGEROMADDRESS); 
-    Data[1] += *(uint8 code *)(STARTPAGEROMADDRESS + 1);
-    mcQEP.AngleFlt = ((int16)(Data[0] << 8) | (int16)Data[1]);
-    Data[0] =  *(uint8 code *)(STARTPAGEROMADDRESS + 2); 
-    Data[1] += *(uint8 code *)(STARTPAGEROMADDRESS + 3);
-    Data[2] += *(uint8 code *)(STARTPAGEROMADDRESS + 4);
-    Data[3] += *(uint8 code *)(STARTPAGEROMADDRESS + 5);
-    mcQEP.ZeroNewCntr = ((int32)(Data[0] << 24) | (int32)(Data[1] << 16) | (int32)(Data[2] << 8) | (int32)Data[3]);
+    Param_Init();
+    Calib_Load();                                           //校准块损坏时Calib.Relearn置1，启动走预定位学习
+    mcQEP.AngleFlt    = Calib.Blk.AngleFlt;
+    mcQEP.ZeroNewCntr = Calib.Blk.ZeroNewCntr;
+    FF_Load();
+    EncComp_Init();
+    CogComp_Init();
+    AutoTune_Init();
+    HoldCtrl_Init();
 
 }
 
@@ -368,6 +365,7 @@ void VariablesPreInit(void)
     /* -----外部控制环参数初始化----- */
     memset(&mcFocCtrl, 0, sizeof(FOCCTRL));
     // mcFocCtrl变量清零
+    HoldCtrl.Mode = HOLD_IQ;                                // 电角度来源已清零，从电流闭环开始
     //    memset(&Uart, 0, sizeof(MCUART));
     memset(&Learn, 0, sizeof(SELFLEARN));
     
@@ -277,14 +277,16 @@ void Fault_Stall(void)
     ------------------------------------------------------------------------------------------------- */
 void Fault_phaseloss(void)
 {
+    #if (PROFILE_ENABLE)
+    uint16 ProfItem;
+    #endif
+
     if (mcState == mcRun)
     {
-        mcFaultDect.Lphasecnt++;
-        
-        if (mcFaultDect.Lphasecnt > 100) //100*5=500ms
+        if (SCHED_DUE(SCHED_SLOW_PHASE_LOSS))
         {
-            mcFaultDect.Lphasecnt = 0;
-            
+            PROFILE_START(ProfItem);
+
             if (((mcCurVarible.Max_ia > (mcCurVarible.Max_ib * 2)) || (mcCurVarible.Max_ia > (mcCurVarible.Max_ic * 2)))
                 && (mcCurVarible.Max_ia > PhaseLossCurrentValue))
             {
@@ -335,6 +337,8 @@ void Fault_phaseloss(void)
                 mcFaultSource = FaultLossPhase;
                 mcState = mcFault;
             }
+
+            SCHED_CHECK(SCHED_SLOW_PHASE_LOSS, ProfItem);
         }
     }
     
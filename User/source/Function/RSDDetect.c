@@ -290,8 +290,8 @@ void RSDFOCCloseLoopStart(void)
     FOC_IDREF         = ID_Start_CURRENT;                      // D轴启动电流
     mcFocCtrl.mcIqref = IQ_Start_CURRENT;                      // Q轴启动电流
     FOC_IQREF         = mcFocCtrl.mcIqref;                     // Q轴启动电流
-    FOC_DQKP = DQKP;
-    FOC_DQKI = DQKI;
+    FOC_DQKP = AutoTune.DqKp;
+    FOC_DQKI = AutoTune.DqKi;
     FOC_EFREQACC  = Motor_Omega_Ramp_ACC;
     FOC_EFREQMIN  = Motor_Omega_Ramp_Min;
     FOC_EFREQHOLD = Motor_Omega_Ramp_End;
@@ -63,8 +63,8 @@
 void PI_Init(void)
 {
     
-    PI2_KP  = SKP;
-    PI2_KI  = SKI;
+    PI2_KP  = AutoTune.SKp;
+    PI2_KI  = AutoTune.SKi;
     PI2_UKH = 0;
     PI2_UKL = 0;
     PI2_EK  = 0;
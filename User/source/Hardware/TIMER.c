@@ -189,3 +189,21 @@ void Timer4_Init(void)
     SetBit(TIM4_CR0, T4MOD);             //0-->Timer模式  1-->输出模式
     SetBit(TIM4_CR1, T4EN);              //TIM4使能   0-->Disable  1-->Enable
 }
+/*---------------------------------------------------------------------------*/
+/*  Name     :   void Timer4_Profile_Init(void)
+    /* Input    :   NO
+    /* Output   :   NO
+    /* Description: Timer4作为耗时统计的时间基准，24MHz自由计数，不占用端口，不开中断
+    /*---------------------------------------------------------------------------*/
+void Timer4_Profile_Init(void)
+{
+    ClrBit(TIM4_CR1, T4EN);
+    SetReg(TIM4_CR0, T4PSC2 | T4PSC1 | T4PSC0, 0x00);  //000-->24M
+    ClrBit(TIM4_CR0, T4IRE);             //比较匹配中断/脉宽检测中断0-->Disable  1-->Enable
+    ClrBit(TIM4_CR0, T4OPM);             //0-->计数器不停止       1-->单次模式
+    ClrBit(TIM4_CR0, T4MOD);             //0-->Timer模式  1-->输出模式
+    ClrBit(TIM4_CR1, T4IPE | T4IFE);     //周期检测与上溢中断关闭
+    TIM4__ARR  = 65535;
+    TIM4__CNTR = 0;
+    SetBit(TIM4_CR1, T4EN);              //TIM4使能   0-->Disable  1-->Enable
+}
@@ -11,11 +11,13 @@
 #include "Myproject.h"
 
 MCUART Uart;
+UART_RXQ xdata UartRxQ;
+UART_STREAM xdata UartStream;
+UART_TXQ xdata UartTxQ;
 SELFLEARN Learn;
 SELFLEARN Power;
 UART_FLAG xdata UARTFL;
 extern int32  speedRef;
-uint8 Flash_Data[6]={0};
 
 //extern  uint16 xdata Speed_Level_flag;
 //extern bit Count1s_flag;
@@ -23,8 +25,6 @@ uint8 Flash_Data[6]={0};
 bit Control_ture = 0;
 bit  Send_Overflag = 1;
 bit uatr1s_flag = 0;
-float MinAngleLim = 34.0;
-float MaxAngleLim = 234.0;
 
 
 uint16 MinAngleCode  = (0x2FA << 2); //306
@@ -59,7 +59,7 @@ void UART2_Init(void)
     SetBit(UT2_CR, UT2REN);     //0-->不允许串行输入 1-->允许串行输入，软件清0;
     PSPI_UT21 = 0;              //中断优先级时最低
     PSPI_UT20 = 0;
-    UT2_BAUD = 0x9B;      //波特率可设置 = 24000000/(16/(1+ UT_BAUD[BAUD_SEL]))/(UT_BAUD+1)
+    UT2_BAUD = UART2_BAUD_REG;  //波特率可设置 = 24000000/(16/(1+ UT_BAUD[BAUD_SEL]))/(UT_BAUD+1)，见CUSTOMER.h UART2_BAUD_RATE
     //9B-->9600 0x000c-->115200 0x0005-->256000  4800-0x137;2400-0x270;1200-0x4E1
     ClrBit(UT2_BAUD, BAUD2_SEL); //倍频使能0-->Disable  1-->Enable
     SetBit(UT2_BAUD, UART2CH);   //UART2端口功能转移使能0：P36->RXD P37->TXD 1:P01->RXD P00->TXD
@@ -96,59 +96,95 @@ void UART1_Init(void)
     //9B-->9600 0x000c-->115200
 }
 
-float spd;
 extern int16 Speed_lim;
 
 uint8 PosErrSET;
 
 void Speed_Handle(uint8 level)
 {
-    if (level >= 0x90)
-    {
-        level = 0x90;
-    }
-    else if (level <= 0x00)
+    int16 spd;
+
+    if (level >= SPEED_LEVEL_MAX)
     {
-        level = 0x00;
+        level = SPEED_LEVEL_MAX;
     }
-    
-    //  spd = level * 0.75 + 2; //rpm ->°/s //0.82*level+0.333
-    spd = level * 0.83 + 0.333;
+
+    spd = Ctrl_LevelToSpeed(level);                 // S_Value(level * 0.83 + 0.333)
     Uart.Speed_Level = level;
     mcSpeedRampLim.IncValue = 60;
     mcSpeedRampLim.DecValue = 60;
  
     /***********************每次设定速度限制时重新规划曲线**********************/
-    mcFocCtrl.SpeedRefLim = S_Value(spd);
-    mcSpeedRampLim.TargetValue = S_Value(spd);
+    mcFocCtrl.SpeedRefLim = spd;
+    mcSpeedRampLim.TargetValue = spd;
     //
     mcSpeedRampLim.ActualValue  = 0;
     mcSpeedRampLim.ActualValueFlt  = 0;
     mcSpeedRampLim.ActualValueFlt_LSB = 0;
+
+    EA = 0;
+    mcSP.SpeedMax = (int32)spd * SPLAN_SPEED_GAIN;
+    mcSP.AccMax   = SPLAN_ACC_Q16;
+    EA = 1;
 }
 
 
-void UartTxdate(uint16 * sndBuf, int32 len)
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Uart_TxInit
+    Description    : DMA0配置为XDATA->UART2并打开DMA中断，发送队列清空，在UART2_Init之后、开中断之前调用
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Uart_TxInit(void)
 {
-    uint16 i = 0;
-    
-    for (i = 0; i < len; i++)
-    {
-        UART_SendData(*sndBuf++);
-    }
+    UartTxQ.Head = 0;
+    UartTxQ.Tail = 0;
+    UartTxQ.Busy = 0;
+    UartTxQ.Drop = 0;
+    SetPipe_DMA0(DRAM_UART2);
+    PDMA1 = 0;                  //中断优先级与UART2相同，最低
+    PDMA0 = 0;
+    SetBit(DMA0_CR0, DMAIE);
 }
-void UART_SendData(unsigned char T_Data)
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Uart_TxPush
+    Description    : 复制一帧到发送队列，DMA空闲时立即启动，不等待发送完成；队列满时丢弃并计数。
+                     只在主循环中调用，DMA中断只推进Head，两边各写各的下标，只有启动判断需要关中断。
+    Date           : 2026-10-17
+    Parameter      : Buf: [输入] 帧数据; Len: [输入] 帧长度，1 ~ UART_TXQ_SIZE
+    ------------------------------------------------------------------------------------------------- */
+void Uart_TxPush(uint8 *Buf, uint8 Len)
 {
-//	Wait_DMA(1);
-//	
-//	DMA1_LEN=Uart.T_Len-1;
-//		Switch_DMA(1);
-	
-    UT2_DR = T_Data;
-    
-    while (!(ReadBit(UT2_CR, UT2TI)));     //等待发送完成
-   
-        TI = 0;                 //发送完成中断标志位清零
+    uint8 Next = (UartTxQ.Tail + 1) & (UART_TXQ_NUM - 1);
+    uint8 i;
+
+    if ((Next == UartTxQ.Head) || (Len == 0) || (Len > UART_TXQ_SIZE))
+    {
+        if (UartTxQ.Drop != 0xFFFF)
+        {
+            UartTxQ.Drop++;
+        }
+
+        return;
+    }
+
+    for (i = 0; i < Len; i++)
+    {
+        UartTxQ.Buf[UartTxQ.Tail][i] = Buf[i];
+    }
+
+    UartTxQ.Len[UartTxQ.Tail] = Len;
+
+    EA = 0;
+    UartTxQ.Tail = Next;
+
+    if (!UartTxQ.Busy)
+    {
+        UART_TX_START();
+    }
+
+    EA = 1;
 }
 
 void Send_NoActive(void) //无效指令
@@ -156,9 +192,8 @@ void Send_NoActive(void) //无效指令
     Uart.T_DATA[0] = 0x90;
     Uart.T_DATA[1] = 0x51;
     Uart.T_DATA[2] = 0xFF;
-    Uart.SendCnt = 0;
     Uart.T_Len = 3;
-    UART_SendData(Uart.T_DATA[0]);
+    Uart_TxPush(Uart.T_DATA, Uart.T_Len);
 }
 
 void Send_ACK(void)
@@ -166,9 +201,8 @@ void Send_ACK(void)
     Uart.T_DATA[0] = 0x90;
     Uart.T_DATA[1] = 0x40;
     Uart.T_DATA[2] = 0xFF;
-    Uart.SendCnt = 0;
     Uart.T_Len = 3;
-    UART_SendData(Uart.T_DATA[0]);
+    Uart_TxPush(Uart.T_DATA, Uart.T_Len);
 }
 
 void Send_Success(void)
@@ -176,9 +210,8 @@ void Send_Success(void)
     Uart.T_DATA[0] = 0x90;
     Uart.T_DATA[1] = 0x50;
     Uart.T_DATA[2] = 0xFF;
-    Uart.SendCnt = 0;
     Uart.T_Len = 3;
-    UART_SendData(Uart.T_DATA[0]);
+    Uart_TxPush(Uart.T_DATA, Uart.T_Len);
 }
 
 void Send_Fail(void)
@@ -187,9 +220,8 @@ void Send_Fail(void)
     Uart.T_DATA[1] = 0x60;
     Uart.T_DATA[2] = 0x41;
     Uart.T_DATA[3] = 0xFF;
-    Uart.SendCnt = 0;
     Uart.T_Len = 4;
-    UART_SendData(Uart.T_DATA[0]);
+    Uart_TxPush(Uart.T_DATA, Uart.T_Len);
 }
 
 
@@ -200,8 +232,7 @@ void UartDealResponse(void)
     Uart.T_DATA[0] = 0x90;
     Uart.T_DATA[1] = 0x50;
     Uart.T_DATA[Uart.T_Len - 1] = 0xFF;
-    Uart.SendCnt = 0;
-    UART_SendData(Uart.T_DATA[0]);
+    Uart_TxPush(Uart.T_DATA, Uart.T_Len);
 }
 
 
@@ -228,6 +259,7 @@ uint16  CoordinateLast = 0;
 
 uint16  PosiAngle = 0;
 uint32  PosiAngleSum = 0;
+int32   PosiTarget = 0;
 
 
 int16 TempBaisL = 0;
@@ -236,354 +268,588 @@ int16 TempBaisWidth = 0;
 
 uint8 TurnDir = 0x00;
 
-void UartDealComm(void)
+/*  VISCA指令表，按(类别, 分组, 指令)顺序查找，R_DATA[1~3]依次比较，UART_CMD_ANY不比较。
+    帧长含81和FF，不在[LenMin, LenMax]内回复无效指令；UART_F_ACK的指令先回复ACK，处理完回复完成，
+    UART_F_LEARN的指令在零位自学习期间也响应，UART_F_IQ的指令在电流闭环中执行，到位保持中先退出锁定；
+    UART_F_MOVE的指令在齿槽补偿学习或测试中回复无法执行，不改变CogComp正在等待的目标。 */
+static UART_CMD code UartCmdTab[] =
+{
+    {0x01, 0x06, 0x01,         8,  15, UART_F_ACK,                UART_ID_MOE},          // 81 01 06 01 xx 0m 0m ... FF
+    {0x01, 0x06, 0x02,         12, 12, UART_F_ACK | UART_F_MOVE,  UART_ID_ABS_MOVE},     // 81 01 06 02 XX 0V 0V 0V 0V 02 03 FF
+    {0x01, 0x06, 0x03,         14, 15, UART_F_ACK | UART_F_MOVE,  UART_ID_INC_MOVE},     // 81 01 06 03 XX 0V*8 FF
+    {0x01, 0x06, 0x04,         5,  15, UART_F_ACK | UART_F_MOVE,  UART_ID_GO_ZERO},      // 81 01 06 04 FF
+    {0x01, 0x06, 0x08,         5,  15, UART_F_ACK,                UART_ID_SET_ZERO},     // 81 01 06 08 FF
+    {0x01, 0x06, 0x30,         13, 13, UART_F_ACK,                UART_ID_FF_SET},       // 81 01 06 30 0p*4 0q*4 FF
+    {0x01, 0x06, 0x31,         6,  6,  UART_F_ACK,                UART_ID_SPEED_MODE},   // 81 01 06 31 0m FF
+    {0x01, 0x06, 0x26,         14, 14, UART_F_ACK,                UART_ID_CALIB_SET},    // 81 01 06 26 0f 0v*8 FF
+    #if (CALIB_TOOL_ENABLE)
+    {0x01, 0x06, 0x27,         6,  6,  UART_F_ACK | UART_F_IQ,    UART_ID_ENC_CAL},      // 81 01 06 27 0m FF
+    {0x01, 0x06, 0x28,         6,  6,  UART_F_ACK | UART_F_IQ,    UART_ID_COG_CAL},      // 81 01 06 28 0m FF
+    {0x01, 0x06, 0x29,         9,  9,  UART_F_ACK | UART_F_IQ,    UART_ID_TUNE_CAL},     // 81 01 06 29 0c 0c 0s 0s FF
+    #endif
+    #if (SCOPE_ENABLE)
+    {0x01, 0x06, 0x2B,         14, 14, UART_F_ACK,                UART_ID_SCOPE_CFG},    // 81 01 06 2B 0n 0s*8 FF
+    {0x01, 0x06, 0x2C,         14, 14, UART_F_ACK,                UART_ID_SCOPE_ARM},    // 81 01 06 2C 0t 0d 0d 0p 0p 0l*4 FF
+    {0x01, 0x06, 0x2D,         6,  6,  UART_F_ACK,                UART_ID_SCOPE_CTL},    // 81 01 06 2D 0m FF
+    #endif
+    #if (PROFILE_ENABLE)
+    {0x01, 0x06, 0x20,         5,  5,  UART_F_ACK,                UART_ID_PROF_RESET},   // 81 01 06 20 FF
+    #endif
+    {0x01, 0x06, 0x22,         5,  5,  UART_F_ACK,                UART_ID_STOP},         // 81 01 06 22 FF
+    {0x01, 0x06, 0x33,         5,  5,  UART_F_ACK,                UART_ID_START},        // 81 01 06 33 FF
+    {0x02, 0x38, UART_CMD_ANY, 4,  15, UART_F_LEARN,              UART_ID_VERSION},
+    {0x02, 0x48, UART_CMD_ANY, 4,  15, 0,                         UART_ID_VERSION},
+    {0x02, 0x68, UART_CMD_ANY, 4,  15, 0,                         UART_ID_SKP},
+    {0x02, 0x69, UART_CMD_ANY, 4,  15, 0,                         UART_ID_SKI},
+    {0x02, 0x6A, UART_CMD_ANY, 4,  15, 0,                         UART_ID_SKD},
+    {0x02, 0x78, UART_CMD_ANY, 4,  15, 0,                         UART_ID_FAULT},
+    {0x02, 0x88, UART_CMD_ANY, 4,  15, 0,                         UART_ID_FAULT_CLR},
+    {0x09, 0x04, UART_CMD_ANY, 4,  15, 0,                         UART_ID_LEARN},
+    {0x09, 0x06, 0x11,         5,  5,  0,                         UART_ID_SPEED},        // 81 09 06 11 FF
+    {0x09, 0x06, 0x12,         5,  5,  0,                         UART_ID_POS},          // 81 09 06 12 FF
+    {0x09, 0x06, 0x30,         5,  5,  0,                         UART_ID_FF_GET},       // 81 09 06 30 FF
+    {0x09, 0x06, 0x31,         5,  5,  0,                         UART_ID_SPEED_MODE_GET}, // 81 09 06 31 FF
+    #if (PROFILE_ENABLE)
+    {0x09, 0x06, 0x20,         6,  6,  0,                         UART_ID_PROF},         // 81 09 06 20 0p FF
+    {0x09, 0x06, 0x21,         7,  7,  0,                         UART_ID_PROF_HIST},    // 81 09 06 21 0p 0h FF
+    {0x09, 0x06, 0x22,         6,  6,  0,                         UART_ID_SCHED},        // 81 09 06 22 0t FF
+    #endif
+    {0x09, 0x06, 0x23,         5,  5,  0,                         UART_ID_QUEUE},        // 81 09 06 23 FF
+    {0x09, 0x06, 0x24,         5,  5,  0,                         UART_ID_STREAM},       // 81 09 06 24 FF
+    {0x09, 0x06, 0x25,         5,  5,  0,                         UART_ID_PARAM},        // 81 09 06 25 FF
+    {0x09, 0x06, 0x26,         6,  6,  0,                         UART_ID_CALIB},        // 81 09 06 26 0f FF
+    {0x09, 0x06, 0x27,         5,  5,  0,                         UART_ID_ENC},          // 81 09 06 27 FF
+    {0x09, 0x06, 0x28,         5,  5,  0,                         UART_ID_COG},          // 81 09 06 28 FF
+    {0x09, 0x06, 0x29,         6,  6,  0,                         UART_ID_TUNE},         // 81 09 06 29 0f FF
+    {0x09, 0x06, 0x2A,         6,  6,  0,                         UART_ID_HOLD},         // 81 09 06 2A 0f FF
+    {0x09, 0x06, 0x2E,         6,  6,  0,                         UART_ID_ABS},          // 81 09 06 2E 0f FF
+    #if (SCOPE_ENABLE)
+    {0x09, 0x06, 0x2B,         5,  5,  0,                         UART_ID_SCOPE},        // 81 09 06 2B FF
+    {0x09, 0x06, 0x2C,         10, 10, 0,                         UART_ID_SCOPE_REC},    // 81 09 06 2C 0i*4 0h FF
+    #endif
+};
+
+#define UART_CMD_NUM                    (sizeof(UartCmdTab) / sizeof(UartCmdTab[0]))
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Uart_StreamRx
+    Description    : 收齐一帧二进制连续给定帧后校验CRC和序号，通过后直接写入规划目标位置。
+                     只在USART2_INT中调用，CRC单元整帧在本函数内算完，不跨中断保留状态。
+                     SYStick_INT与USART2_INT同为最低优先级，写入32位目标时规划不会读到一半。
+                     目标变化时与81 01 06 02一样退出到位保持，重复的目标不打断锁定；齿槽补偿学习或测试中不改变目标。
+    Date           : 2026-10-17
+    Parameter      : None
+    ------------------------------------------------------------------------------------------------- */
+void Uart_StreamRx(void)
 {
-     if (Uart.ResponceFlag == 1)
+    uint8  i;
+    uint16 Crc;
+    int32  Target;
+
+    if (Learn.State != LearnOver)
     {
-        switch (Uart.R_DATA[1])
-        {            
-            case 0x02:
-                switch (Uart.R_DATA[2])
-                {
-                    case 0x38:                        
-                        
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        Uart.T_DATA[2] = 0x01;
-                        Uart.T_DATA[3] = 0x00;
-                  
-                        Uart.T_Len = 5;
-                        Uart.RxFSM = 1;
-                        
-                        break;
-                    
-                }
-                break;
+        return;                                             //零位自学习期间不响应
+    }
+
+    SetBit(CRC_CR, CRCVAL);                                 //初值0xFFFF
+    SetBit(CRC_CR, CRCDINI);
+
+    for (i = 0; i < UART_STREAM_LEN - 2; i++)
+    {
+        CRC_DIN = UartStream.Buf[i];
+    }
+
+    SetBit(CRC_CR, CRCPNT);
+    Crc = (uint16)CRC_DR << 8;
+    ClrBit(CRC_CR, CRCPNT);
+    Crc |= CRC_DR;
+
+    if (Crc != (((uint16)UartStream.Buf[6] << 8) | UartStream.Buf[7]))
+    {
+        if (UartStream.CrcErr != 0xFFFF)
+        {
+            UartStream.CrcErr++;
         }
-        if (Uart.RxFSM == 1)
+
+        return;
+    }
+
+    if (UartStream.SeqValid && ((int8)(UartStream.Buf[1] - UartStream.Seq) <= 0))
+    {
+        if (UartStream.Stale != 0xFFFF)
         {
-            UartDealResponse();
-            Uart.RxFSM = 0;
+            UartStream.Stale++;
         }
-        Uart.ResponceFlag = 0;
+
+        return;
     }
-}
 
+    UartStream.Seq      = UartStream.Buf[1];
+    UartStream.SeqValid = 1;
 
-void UartDealComm2(void)
+    if (UartStream.Ok != 0xFFFF)
+    {
+        UartStream.Ok++;
+    }
+
+    Target = ((int32)UartStream.Buf[2] << 24) | ((int32)UartStream.Buf[3] << 16) | ((int32)UartStream.Buf[4] << 8) | UartStream.Buf[5];
+    Target += mcQEP.ZeroCntr + mcQEP.ZeroNewCntr;
+
+    if ((Target != mcSP.TargetPulsesNum) && !CogComp.Busy)
+    {
+        mcQEP.ZSaveFlag      = 0;
+        HoldCtrl.ExitReq     = 1;                           //下一个SysTick周期退出锁定
+        mcSP.TargetPulsesNum = Target;
+        mcSP.Cmd++;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Uart_RxPop
+    Description    : 从接收队列取出最早的一帧到R_DATA，帧长写入UsaRxLen。
+                     只在主循环中调用，接收中断只推进Tail，单字节下标读写无需关中断。
+    Date           : 2026-10-17
+    Parameter      : None
+    Return         : 1取到一帧，0队列为空
+    ------------------------------------------------------------------------------------------------- */
+uint8 Uart_RxPop(void)
 {
-    if (Uart.ResponceFlag == 1)
+    uint8 Len;
+    uint8 i;
+
+    if (UartRxQ.Head == UartRxQ.Tail)
     {
+        return 0;
+    }
+
+    Len = UartRxQ.Len[UartRxQ.Head];
 
-        switch (Uart.R_DATA[1])
+    for (i = 0; i < Len; i++)
+    {
+        Uart.R_DATA[i] = UartRxQ.Buf[UartRxQ.Head][i];
+    }
+
+    Uart.UsaRxLen = Len;
+    UartRxQ.Head  = (UartRxQ.Head + 1) & (UART_RXQ_NUM - 1);
+    return 1;
+}
+
+/* 按Frame[1~3]查指令表，返回表项序号，未找到返回UART_CMD_NUM */
+static uint8 Uart_CmdFind(uint8 xdata *Frame)
+{
+    uint8 i;
+
+    for (i = 0; i < UART_CMD_NUM; i++)
+    {
+        if ((UartCmdTab[i].Cat == Frame[1]) && (UartCmdTab[i].Grp == Frame[2])
+            && ((UartCmdTab[i].Cmd == UART_CMD_ANY) || (UartCmdTab[i].Cmd == Frame[3])))
         {
-            case 0x01:
-            
-                /**********************直接回复ACK************************/
-                Send_ACK();
-				        Uart.RxFSM = 1;
-                switch (Uart.R_DATA[3])
+            break;
+        }
+    }
+
+    return i;
+}
+
+/* 16位数值按VISCA格式拆成4个半字节 */
+void Uart_PutWord(uint8 Pos, uint16 Value)
+{
+    Uart.T_DATA[Pos]     = (Value >> 12) & 0x0F;
+    Uart.T_DATA[Pos + 1] = (Value >> 8) & 0x0F;
+    Uart.T_DATA[Pos + 2] = (Value >> 4) & 0x0F;
+    Uart.T_DATA[Pos + 3] = Value & 0x0F;
+}
+
+/* 接收帧中从Pos开始的4个半字节合成16位数值 */
+static uint16 Uart_GetWord(uint8 Pos)
+{
+    return ((uint16)(Uart.R_DATA[Pos] & 0x0F) << 12) | ((uint16)(Uart.R_DATA[Pos + 1] & 0x0F) << 8)
+           | ((Uart.R_DATA[Pos + 2] & 0x0F) << 4) | (Uart.R_DATA[Pos + 3] & 0x0F);
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Uart_CmdExec
+    Description    : 执行一条已通过查表和帧长检查的指令，需要应答的分支填写T_DATA/T_Len并置RxFSM
+    Date           : 2026-10-17
+    Parameter      : Id: [输入] 处理分支编号 UART_ID_xxx
+    ------------------------------------------------------------------------------------------------- */
+static void Uart_CmdExec(uint8 Id)
+{
+    switch (Id)
+    {
+        case UART_ID_MOE:
+            if ((Uart.R_DATA[5]  == 0x05) && (Uart.R_DATA[6]  == 0x05))
+            {
+                MOE = 0;
+                GP44 = 1;
+            }
+            else if ((Uart.R_DATA[5]  == 0x06) && (Uart.R_DATA[6]  == 0x06))
+            {
+                GP44 = 1;
+                SetBit(RST_SR , SOFTR);
+                MOE = 1;
+            }
+            break;
+
+        case UART_ID_ABS_MOVE://单圈位置闭环控制命令81 01 06 02 XX 0V 0V 0V 0V 02 03 FF
+            Speed_Handle(Uart.R_DATA[4]);
+            PosiAngle = (Uart.R_DATA[5] << 12) + (Uart.R_DATA[6] << 8) + (Uart.R_DATA[7] << 4) + Uart.R_DATA[8];
+            mcQEP.ZSaveFlag = 0;
+            if ((Uart.R_DATA[9]  == 0x03) && (Uart.R_DATA[10]  == 0x02))
+            {
+                PosiTarget =  (PosiAngle) + mcQEP.ZeroCntr + mcQEP.ZeroNewCntr;
+                if (PosiTarget < mcQEP.CntrSumReal - 20)
+                {
+                    PosiTarget += 65536;
+                }
+                SpeedPlanSet(PosiTarget);
+                if(Uart.R_DATA[5] == 0x03)
                 {
-                    case 0x01:
-                        if ((Uart.R_DATA[5]  == 0x05) && (Uart.R_DATA[6]  == 0x05))
-                        {
-                            MOE = 0;
-                            GP44 = 1;
-                        }
-                        else if ((Uart.R_DATA[5]  == 0x06) && (Uart.R_DATA[6]  == 0x06))
-                        {
-                            GP44 = 1;
-                            SetBit(RST_SR , SOFTR);
-                            MOE = 1;
-                        }
-                        break;
-                    case 0x02://单圈位置闭环控制命令81 01 06 02 XX 0V 0V 0V 0V 02 03 FF
-												Speed_Handle(Uart.R_DATA[4]);
-                        PosiAngle = (Uart.R_DATA[5] << 12) + (Uart.R_DATA[6] << 8) + (Uart.R_DATA[7] << 4) + Uart.R_DATA[8];
-                        mcQEP.ZSaveFlag = 0;
-												UqPo.UqPoaiFlag = 0;
-												UqPo.UqPosiLockFlag = 1;
-												mcFocCtrl.ThetaIQ_SOURCE = 0;
-                        if ((Uart.R_DATA[9]  == 0x03) && (Uart.R_DATA[10]  == 0x02))
-                        {
-                            mcSP.PulsesNum =  (PosiAngle) + mcQEP.ZeroCntr + mcQEP.ZeroNewCntr;
-                            if (mcSP.PulsesNum < mcQEP.CntrSumReal - 20)
-                            {
-                                mcSP.PulsesNum += 65536;
-                            }
-														if(Uart.R_DATA[5] == 0x03)
-														{
-															UARTFL.flag_90 = 1;
-														}
-														else if(Uart.R_DATA[5] == 0x07)
-														{
-															UARTFL.flag_180 = 1;
-														}
-														else if(Uart.R_DATA[5] == 0x0B)
-														{
-															UARTFL.flag_270 = 1;
-														}
-														else if(Uart.R_DATA[5] == 0x0F)
-														{
-															UARTFL.flag_0 = 1;
-														}
-                        }
-                        else if ((Uart.R_DATA[10]  == 0x03) && (Uart.R_DATA[9]  == 0x02))
-                        {
-                            mcSP.PulsesNum = -(65536 -(int32)(PosiAngle)) + mcQEP.ZeroCntr + mcQEP.ZeroNewCntr; //4096线*4 = 16383 = 一圈，反转
-                            if (mcSP.PulsesNum > mcQEP.CntrSumReal + 20)
-                            {
-                                mcSP.PulsesNum -= 65536;
-                            }
-                        }
-                        
-                        //Speed_Handle(Uart.R_DATA[4]);
-                        break;
-                        
-                    case 0x03://增量位置闭环控制命令
-                        Speed_Handle(Uart.R_DATA[4]);
-                        PosiAngleSum = (int32)(((int32)Uart.R_DATA[5] << 28) + ((int32)Uart.R_DATA[6] << 24) + ((int32)Uart.R_DATA[7] << 20) + ((int32)Uart.R_DATA[8] << 16)+ ((int32)Uart.R_DATA[9] << 12)+ ((int32)Uart.R_DATA[10] << 8)+ ((int32)Uart.R_DATA[11] << 4) + (int32)Uart.R_DATA[12]);
-                        
-                        //Speed_Handle(Uart.R_DATA[4]);
-                        if ((Uart.R_DATA[9]  == 0x02) && (Uart.R_DATA[10]  == 0x03))
-                        {
-                            mcSP.PulsesNum =  mcQEP.CntrSumReal - (PosiAngleSum >> 2);
-                        }
-                        else if ((Uart.R_DATA[10]  == 0x02) && (Uart.R_DATA[9]  == 0x03))
-                        {
-                            mcSP.PulsesNum =  mcQEP.CntrSumReal + (PosiAngleSum >> 2);
-                        }
-                        
-                        break;
-                        
-                    case 0x04:
-//                        Speed_Handle(0x05);
-//                        if ((mcQEP.ZeroCntrOld  < mcQEP.ZeroCntr) && (mcQEP.ZeroNewCntr > 0x1FFF))
-//                        {
-//                            mcSP.PulsesNum = mcQEP.ZeroCntrOld + mcQEP.ZeroNewCntr;
-//                        }
-//                        else 
-//                        {
-                            mcSP.PulsesNum = mcQEP.ZeroCntr + mcQEP.ZeroNewCntr;
-//                        }
-                        break;
-                        
-                    case 0x08://写零位81 01 06 08 FF
-											   //mcQEP.CntrSum_ZeroTemp = mcQEP.CntrSumReal;
-//                        Speed_Handle(0x05);
-                        mcQEP.ZeroNewCntr = mcQEP.CntrSumReal - mcQEP.ZeroCntr;
-                        Flash_Data[0] = mcQEP.AngleFlt >> 8;
-                        Flash_Data[1] = mcQEP.AngleFlt;
-                        Flash_Data[2] = mcQEP.ZeroNewCntr >> 24;
-                        Flash_Data[3] = mcQEP.ZeroNewCntr >> 16;
-                        Flash_Data[4] = mcQEP.ZeroNewCntr >> 8;
-                        Flash_Data[5] = mcQEP.ZeroNewCntr;
-                        EA = 0;
-                        Flash_ErasePageRom(STARTPAGEROMADDRESS);
-                        
-                        Flash_Sector_Write(STARTPAGEROMADDRESS, Flash_Data[0]);
-                        Flash_Sector_Write(STARTPAGEROMADDRESS+1, Flash_Data[1]);
-                        Flash_Sector_Write(STARTPAGEROMADDRESS+2, Flash_Data[2]);
-                        Flash_Sector_Write(STARTPAGEROMADDRESS+3, Flash_Data[3]);
-                        Flash_Sector_Write(STARTPAGEROMADDRESS+4, Flash_Data[4]);
-                        Flash_Sector_Write(STARTPAGEROMADDRESS+5, Flash_Data[5]);
-                        EA = 1;
-                        
-                        break;
-												
-                    case 0x22://电机停止命令。81 01 06 22 FF
-												if (Uart.UsaRxLen == 6)
-												{
-													isCtrlPowerOn = false;
-													Uart.T_Len = 3;
-													Uart.RxFSM = 1;
-												}
-										case 0x33://电机启动命令。81 01 06 33 FF
-												if (Uart.UsaRxLen == 6)
-												{
-													isCtrlPowerOn = true;
-													Uart.T_Len = 3;
-													Uart.RxFSM = 1;
-												}
-                        break;
-                        
-                    default:
-                        break;
+                    UARTFL.flag_90 = 1;
                 }
-                
-                break;
-                //            default:
-                //                break;
-            
-            case 0x02:
-                switch (Uart.R_DATA[2])
+                else if(Uart.R_DATA[5] == 0x07)
                 {
-                    case 0x38:                        
-                        
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        Uart.T_DATA[2] = 0x01;
-                        Uart.T_DATA[3] = 0x00;
-                  
-                        Uart.T_Len = 5;
-                        Uart.RxFSM = 1;
-                        
-                        break;
-                    
-                    case 0x48:
-                            
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        Uart.T_DATA[2] = 0x01;
-                        Uart.T_DATA[3] = 0x00;
-                  
-                        Uart.T_Len = 5;
-                        Uart.RxFSM = 1;
-                        
-                        break;
-                    
-                    case 0x68:
-                        
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        Uart.T_DATA[2] = (SKP >> 4) & 0x0F;
-                        Uart.T_DATA[3] = SKP;
-                        
-                        Uart.T_Len = 5;
-                        Uart.RxFSM = 1;
-                    
-                        break;
-                   case 0x69:
-                        
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        Uart.T_DATA[2] = (SKI >> 4) & 0x0F;
-                        Uart.T_DATA[3] = SKI;
-                        
-                        Uart.T_Len = 5;
-                        Uart.RxFSM = 1;
-                    
-                        break;
-                   
-                    case 0x6A:
-                        
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        Uart.T_DATA[2] = (SKD >> 4) & 0x0F;
-                        Uart.T_DATA[3] = SKD;
-                    
-                        Uart.T_Len = 5;
-                        Uart.RxFSM = 1;
-                    
-                        break;
-                    
-                   case 0x78:
-                        
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        if (mcState != mcFault)
-                        {
-                            Uart.T_DATA[2] = 0x05;                          
-                        }
-                        else 
-                        {
-                            Uart.T_DATA[2] = 0x04;
-                        } 
-                        
-                        Uart.T_Len = 4;
-                        Uart.RxFSM = 1;
-                    
-                        break;
-                        
-                  case 0x88:
-                        									
-//												mcFaultSource = FaultNoSource;
-												mcFaultDect.CurrentFlag = 0;
-
-												Uart.T_DATA[0] = 0x90;
-												Uart.T_DATA[1] = 0x50;
-                        if (mcState != mcFault)
-                        {
-													  
-                            Uart.T_DATA[2] = 0x06; 
-														
-                        }
-                        else 
-                        {
-                            Uart.T_DATA[2] = 0x04;
-                        } 
-                        Uart.T_Len = 4;
-												Uart.RxFSM = 1;
-
-                    
-                        break;
+                    UARTFL.flag_180 = 1;
                 }
-                break;
-                
-            case 0x09:
-                switch (Uart.R_DATA[2])
+                else if(Uart.R_DATA[5] == 0x0B)
                 {
-                    case 0x04:
-                        Uart.T_DATA[0] = 0x90;
-                        Uart.T_DATA[1] = 0x50;
-                        if (Learn.FilishFlag)
-                        {
-                            Uart.T_DATA[2] = 0x02;                          
-                        }
-                        else 
-                        {
-                            Uart.T_DATA[2] = 0x03;
-                        }
-                        
-                        Uart.T_Len = 4;
-                        Uart.RxFSM = 1;
-                        break;
-                    
-                    case 0x06:                      
-                        switch (Uart.R_DATA[3])
-                        {
-                            case 0x11:
-                                    mcSP.Speedlevel = (float)(ABS(mcQEP.SpeedMFlt) * MOTOR_SPEED_BASE / 32767.0 - 0.333)/0.833;
-
-                                    
-                                    Uart.T_DATA[0] = 0x90;
-                                    Uart.T_DATA[1] = 0x50;
-                                    Uart.T_DATA[2] = 0x11;
-                                    Uart.T_DATA[3] = mcSP.Speedlevel;
-                              
-                                    Uart.T_Len = 5;
-                                    Uart.RxFSM = 1;
-                                
-                                break;
-                            
-                            case 0x12:
-                                    PosiAngle = mcQEP.CntrSumReal - mcQEP.ZeroCntr - mcQEP.ZeroNewCntr;
-                                   // PosiAngle = PosiAngle << 2;
-                                    Uart.T_DATA[0] = 0x90;
-                                    Uart.T_DATA[1] = 0x50;
-                                    Uart.T_DATA[2] = (PosiAngle >> 12) & 0x0F;
-                                    Uart.T_DATA[3] = (PosiAngle >> 8) & 0x0F;
-                                    Uart.T_DATA[4] = (PosiAngle >> 4) & 0x0F;
-                                    Uart.T_DATA[5] = PosiAngle & 0x0F;
-                              
-                                    Uart.T_Len = 7;
-                                    Uart.RxFSM = 1;
-                                
-                                break;
-                        }
-                        break;
+                    UARTFL.flag_270 = 1;
                 }
-                break;
+                else if(Uart.R_DATA[5] == 0x0F)
+                {
+                    UARTFL.flag_0 = 1;
+                }
+            }
+            else if ((Uart.R_DATA[10]  == 0x03) && (Uart.R_DATA[9]  == 0x02))
+            {
+                PosiTarget = -(65536 -(int32)(PosiAngle)) + mcQEP.ZeroCntr + mcQEP.ZeroNewCntr; //4096线*4 = 16383 = 一圈，反转
+                if (PosiTarget > mcQEP.CntrSumReal + 20)
+                {
+                    PosiTarget -= 65536;
+                }
+                SpeedPlanSet(PosiTarget);
+            }
+            break;
+
+        case UART_ID_INC_MOVE://增量位置闭环控制命令
+            Speed_Handle(Uart.R_DATA[4]);
+            PosiAngleSum = (int32)(((int32)Uart.R_DATA[5] << 28) + ((int32)Uart.R_DATA[6] << 24) + ((int32)Uart.R_DATA[7] << 20) + ((int32)Uart.R_DATA[8] << 16)+ ((int32)Uart.R_DATA[9] << 12)+ ((int32)Uart.R_DATA[10] << 8)+ ((int32)Uart.R_DATA[11] << 4) + (int32)Uart.R_DATA[12]);
+            if ((Uart.R_DATA[9]  == 0x02) && (Uart.R_DATA[10]  == 0x03))
+            {
+                SpeedPlanSet(mcQEP.CntrSumReal - (PosiAngleSum >> 2));
+            }
+            else if ((Uart.R_DATA[10]  == 0x02) && (Uart.R_DATA[9]  == 0x03))
+            {
+                SpeedPlanSet(mcQEP.CntrSumReal + (PosiAngleSum >> 2));
+            }
+            break;
+
+        case UART_ID_GO_ZERO:
+            SpeedPlanSet(mcQEP.ZeroCntr + mcQEP.ZeroNewCntr);
+            break;
+
+        case UART_ID_SET_ZERO://写零位81 01 06 08 FF
+            Calib_Set(CALIB_FIELD_ZERO, mcQEP.CntrSumReal - mcQEP.ZeroCntr);
+            break;
+
+        case UART_ID_FF_SET://前馈增益，p为Kv(Q12)，q为Ka(Q16)，保存到Flash
+            mcFF.Kv = (Uart.R_DATA[4] << 12) + (Uart.R_DATA[5] << 8) + (Uart.R_DATA[6] << 4) + Uart.R_DATA[7];
+            mcFF.Ka = (Uart.R_DATA[8] << 12) + (Uart.R_DATA[9] << 8) + (Uart.R_DATA[10] << 4) + Uart.R_DATA[11];
+            FF_Save();
+            break;
+
+        case UART_ID_CALIB_SET://写校准块字段 f为CALIB_FIELD_xxx，v为32位值
+            Calib_Set(Uart.R_DATA[4], ((uint32)Uart_GetWord(5) << 16) | Uart_GetWord(9));
+            break;
+
+        #if (CALIB_TOOL_ENABLE)
+        case UART_ID_ENC_CAL://编码器偏心标定 m=1开始标定，m=0清除补偿表
+            if (Uart.R_DATA[4] == 0x01)
+            {
+                EncComp_Start();
+            }
+            else if (Uart.R_DATA[4] == 0x00)
+            {
+                EncComp_Clear();
+            }
+            break;
+
+        case UART_ID_COG_CAL://齿槽补偿 m=1学习并测试，m=2只测试速度波动，m=0清除补偿表
+            if ((Uart.R_DATA[4] == 0x01) || (Uart.R_DATA[4] == 0x02))
+            {
+                CogComp_Start(Uart.R_DATA[4]);
+            }
+            else if (Uart.R_DATA[4] == 0x00)
+            {
+                CogComp_Clear();
+            }
+            break;
+
+        case UART_ID_TUNE_CAL://参数整定 c为电流环带宽(x20Hz)，s为速度环带宽(Hz)，都为0时恢复默认参数
+            if ((Uart.R_DATA[4] | Uart.R_DATA[5] | Uart.R_DATA[6] | Uart.R_DATA[7]) == 0)
+            {
+                AutoTune_Clear();
+            }
+            else
+            {
+                AutoTune_Start((Uart.R_DATA[4] << 4) | Uart.R_DATA[5], (Uart.R_DATA[6] << 4) | Uart.R_DATA[7]);
+            }
+            break;
+        #endif
+
+        #if (SCOPE_ENABLE)
+        case UART_ID_SCOPE_CFG://示波器通道 n为通道数，s为各通道信号编号SCOPE_SIG_xxx
+            Scope_Config(Uart.R_DATA[4], &Uart.R_DATA[5]);
+            break;
+
+        case UART_ID_SCOPE_ARM://示波器启动 t为触发源，d为分频，p为预触发记录数，l为位置误差阈值
+            Scope_Arm(Uart.R_DATA[4], (Uart.R_DATA[5] << 4) | Uart.R_DATA[6], (Uart.R_DATA[7] << 4) | Uart.R_DATA[8], Uart_GetWord(9));
+            break;
+
+        case UART_ID_SCOPE_CTL://示波器控制 m为SCOPE_CTL_xxx
+            Scope_Control(Uart.R_DATA[4]);
+            break;
+        #endif
+
+        case UART_ID_SPEED_MODE://测速模式，m=0为M法，m=1为M/T法
+            if (Uart.R_DATA[4] <= SPEED_MODE_MT)
+            {
+                mcQEP.SpeedMode = Uart.R_DATA[4];
+            }
+            break;
+
+        #if (PROFILE_ENABLE)
+        case UART_ID_PROF_RESET://中断耗时统计清零
+            Profile_Reset();
+            Sched_Reset();
+            break;
+        #endif
+
+        case UART_ID_STOP://电机停止命令
+            isCtrlPowerOn = false;
+            break;
+
+        case UART_ID_START://电机启动命令
+            isCtrlPowerOn = true;
+            break;
+
+        case UART_ID_VERSION:
+            Uart.T_DATA[2] = 0x01;
+            Uart.T_DATA[3] = 0x00;
+            Uart.T_Len = 5;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_SKP:
+            Uart.T_DATA[2] = (AutoTune.SKp >> 4) & 0x0F;
+            Uart.T_DATA[3] = AutoTune.SKp;
+            Uart.T_Len = 5;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_SKI:
+            Uart.T_DATA[2] = (AutoTune.SKi >> 4) & 0x0F;
+            Uart.T_DATA[3] = AutoTune.SKi;
+            Uart.T_Len = 5;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_SKD:
+            Uart.T_DATA[2] = (SKD >> 4) & 0x0F;
+            Uart.T_DATA[3] = SKD;
+            Uart.T_Len = 5;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_FAULT:
+            Uart.T_DATA[2] = (mcState != mcFault) ? 0x05 : 0x04;
+            Uart.T_Len = 4;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_FAULT_CLR:
+//          mcFaultSource = FaultNoSource;
+            mcFaultDect.CurrentFlag = 0;
+            Uart.T_DATA[2] = (mcState != mcFault) ? 0x06 : 0x04;
+            Uart.T_Len = 4;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_LEARN:
+            Uart.T_DATA[2] = Learn.FilishFlag ? 0x02 : 0x03;
+            Uart.T_Len = 4;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_SPEED:
+            mcSP.Speedlevel = Ctrl_SpeedToLevel(mcQEP.SpeedMFlt);
+            Uart.T_DATA[2] = 0x11;
+            Uart.T_DATA[3] = mcSP.Speedlevel;
+            Uart.T_Len = 5;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_POS:
+            PosiAngle = mcQEP.CntrSumReal - mcQEP.ZeroCntr - mcQEP.ZeroNewCntr;
+            Uart_PutWord(2, PosiAngle);
+            Uart.T_Len = 7;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_FF_GET:
+            FF_Report();
+            break;
+
+        case UART_ID_SPEED_MODE_GET:
+            QEP_SpeedReport();
+            break;
+
+        #if (PROFILE_ENABLE)
+        case UART_ID_PROF://中断耗时 p为统计项编号
+            Profile_Report(Uart.R_DATA[4]);
+            break;
+
+        case UART_ID_PROF_HIST://中断耗时直方图 h为半区编号
+            Profile_ReportHist(Uart.R_DATA[4], Uart.R_DATA[5]);
+            break;
+
+        case UART_ID_SCHED://任务超时次数 t为任务编号
+            Sched_Report(Uart.R_DATA[4]);
+            break;
+        #endif
+
+        case UART_ID_QUEUE://收发队列丢帧数 -> 90 50 接收丢帧 发送丢帧 FF，各4个半字节
+            Uart_PutWord(2, UartRxQ.Drop);
+            Uart_PutWord(6, UartTxQ.Drop);
+            Uart.T_Len = 11;
+            Uart.RxFSM = 1;
+            break;
+
+        case UART_ID_PARAM://参数记录区状态
+            Param_Report();
+            break;
+
+        case UART_ID_CALIB://读校准块字段 f为CALIB_FIELD_xxx
+            Calib_Report(Uart.R_DATA[4]);
+            break;
+
+        case UART_ID_ENC://编码器偏心标定状态和补偿前后误差幅值
+            EncComp_Report();
+            break;
+
+        case UART_ID_COG://齿槽补偿学习状态和补偿前后速度波动
+            CogComp_Report();
+            break;
+
+        case UART_ID_TUNE://参数整定状态 f=0为辨识结果，f=1为正在使用的参数
+            AutoTune_Report(Uart.R_DATA[4]);
+            break;
+
+        case UART_ID_HOLD://到位保持切换统计 f=0/1为最近一次进入/退出锁定，f=2/3为历次最大值
+            HoldCtrl_Report(Uart.R_DATA[4]);
+            break;
+
+        case UART_ID_ABS://PWM编码器 f=0为读数，f=1为统计
+            AbsEnc_Report(Uart.R_DATA[4]);
+            break;
+
+        #if (SCOPE_ENABLE)
+        case UART_ID_SCOPE://示波器状态
+            Scope_Report();
+            break;
+
+        case UART_ID_SCOPE_REC://示波器记录 i为记录下标(0为最早一条)，h=0/1为第0~3/4~7路
+            Scope_ReportRecord(Uart_GetWord(4), Uart.R_DATA[8]);
+            break;
+        #endif
+
+        case UART_ID_STREAM://二进制给定帧统计 -> 90 50 采用 CRC错误 序号过期 FF，各4个半字节
+            Uart_PutWord(2, UartStream.Ok);
+            Uart_PutWord(6, UartStream.CrcErr);
+            Uart_PutWord(10, UartStream.Stale);
+            Uart.T_Len = 15;
+            Uart.RxFSM = 1;
+            break;
+
+        default:
+            break;
+    }
+}
+
+/*  -------------------------------------------------------------------------------------------------
+    Function Name  : Uart_Dispatch
+    Description    : 取出一帧指令查表执行并应答，每次调用最多处理一帧；发送队列剩余不足两帧(ACK + 完成)
+                     时暂不取帧，未处理的指令留在接收队列中。UART_F_IQ的指令在到位保持中同样留在队列中，
+                     先请求退出锁定，下一个SysTick周期退出后再执行。耗时计入PROF_UART_DISPATCH。
+    Date           : 2026-10-17
+    Parameter      : Flag: [输入] 需要的表项标志，0为全部指令，UART_F_LEARN为自学习期间可响应的指令
+    ------------------------------------------------------------------------------------------------- */
+static void Uart_Dispatch(uint8 Flag)
+{
+    uint8 i;
+    #if (PROFILE_ENABLE)
+    uint16 ProfItem;
+    #endif
+
+    if ((((UartTxQ.Head - UartTxQ.Tail - 1) & (UART_TXQ_NUM - 1)) < 2) || (UartRxQ.Head == UartRxQ.Tail))
+    {
+        return;
+    }
+
+    i = Uart_CmdFind(UartRxQ.Buf[UartRxQ.Head]);
+
+    if ((i < UART_CMD_NUM) && (UartCmdTab[i].Flag & UART_F_IQ) && ((UartCmdTab[i].Flag & Flag) == Flag) && !HoldCtrl_Release())
+    {
+        return;
+    }
+
+    Uart_RxPop();
+    PROFILE_START(ProfItem);
+
+    if ((i < UART_CMD_NUM) && ((UartCmdTab[i].Flag & Flag) == Flag))
+    {
+        if ((Uart.UsaRxLen < UartCmdTab[i].LenMin) || (Uart.UsaRxLen > UartCmdTab[i].LenMax))
+        {
+            Send_NoActive();
         }
-        if (Uart.RxFSM == 1)
+        else if ((UartCmdTab[i].Flag & UART_F_MOVE) && CogComp.Busy)
         {
-            UartDealResponse();
-            Uart.RxFSM = 0;
+            Send_Fail();
         }
-        Uart.ResponceFlag = 0;
+        else
+        {
+            if (UartCmdTab[i].Flag & UART_F_ACK)
+            {
+                Send_ACK();                         //直接回复ACK，处理完回复完成
+                Uart.RxFSM = 1;
+            }
+
+            Uart_CmdExec(UartCmdTab[i].Id);
+        }
+    }
+    else if (Flag == 0)
+    {
+        Send_NoActive();
+    }
+
+    if (Uart.RxFSM == 1)
+    {
+        UartDealResponse();
+        Uart.RxFSM = 0;
     }
-		
-		
+
+    PROFILE_STOP(PROF_UART_DISPATCH, ProfItem);
+}
+
+/* 零位自学习期间只响应UART_F_LEARN的指令，其余指令取出后丢弃 */
+void UartDealComm(void)
+{
+    Uart_Dispatch(UART_F_LEARN);
+}
+
+void UartDealComm2(void)
+{
+    Uart_Dispatch(0);
 }
 
 
@@ -601,7 +867,6 @@ void Fault_Communication(void)
         {
             Uart.UARxCnt = 0;
             Uart.Read_State = 0;
-            Uart.ResponceFlag = 0;
         }
     }
     else
@@ -618,7 +883,10 @@ void Self_Learning(void)
 {
 	if (Learn.State != LearnOver)
 	{
-		mcSP.PulsesNum = mcQEP.CntrSumReal + 3000;
+		EA = 0;                                     //找Z时目标随转子前移，不算位置指令，不计入mcSP.Cmd
+		mcSP.TargetPulsesNum = mcQEP.CntrSumReal + 3000;
+		EA = 1;
+		HoldCtrl.ExitReq = 1;
 //        mcSpeedRampLim.ActualValueFlt = 30000;
 		isCtrlPowerOn = true;
 		if (mcQEP.ZSaveFlag ==1)
@@ -631,7 +899,7 @@ void Self_Learning(void)
 	{
 //        speedRef =  S_Value(0.0);
 //        Speed_Handle(0x00);
-		  mcSP.PulsesNum = mcQEP.ZeroCntr + mcQEP.ZeroNewCntr;
+		  SpeedPlanSet(mcQEP.ZeroCntr + mcQEP.ZeroNewCntr);
 //          mcSP.PulsesNum = mcQEP.CntrSumReal;
           Learn.FilishFlag = 1;
 //		isCtrlPowerOn = true;